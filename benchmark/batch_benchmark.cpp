@@ -0,0 +1,154 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+	// number of vectors in every dataset
+	constexpr auto dataset_size = 4096;
+
+	auto sweep_dimensions(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(4)->Range(4, 256);
+	}
+
+	auto make_vector(int dimensions, int seed) -> comp6771::euclidean_vector {
+		auto v = comp6771::euclidean_vector(dimensions);
+		for (auto j = 0; j < dimensions; ++j) {
+			v[j] = static_cast<double>((seed * 31 + j * 17) % 101) / 101.0;
+		}
+		return v;
+	}
+
+	auto make_dataset(int dimensions) -> std::vector<comp6771::euclidean_vector> {
+		auto vectors = std::vector<comp6771::euclidean_vector>();
+		vectors.reserve(dataset_size);
+		for (auto i = 0; i < dataset_size; ++i) {
+			vectors.push_back(make_vector(dimensions, i));
+		}
+		return vectors;
+	}
+
+	auto set_items_processed(benchmark::State& state) -> void {
+		state.SetItemsProcessed(state.iterations() * dataset_size);
+	}
+
+	// one euclidean_vector per element: the baseline the batch kernels replace
+	auto norm_separate(benchmark::State& state) -> void {
+		auto vectors = make_dataset(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			for (auto& v : vectors) {
+				// Writing through the non-const subscript invalidates the cached norm.
+				v[0] = 1.0;
+				benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+			}
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(norm_separate)->Apply(sweep_dimensions);
+
+	template<comp6771::batch_layout Layout>
+	auto norm_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const batch = comp6771::euclidean_vector_batch(make_dataset(dimensions), Layout);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(batch));
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK_TEMPLATE(norm_batch, comp6771::batch_layout::row_major)->Apply(sweep_dimensions);
+	BENCHMARK_TEMPLATE(norm_batch, comp6771::batch_layout::column_major)->Apply(sweep_dimensions);
+
+	auto dot_separate(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const vectors = make_dataset(dimensions);
+		auto const query = make_vector(dimensions, -1);
+		for (auto _ : state) {
+			for (auto const& v : vectors) {
+				benchmark::DoNotOptimize(comp6771::dot(v, query));
+			}
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(dot_separate)->Apply(sweep_dimensions);
+
+	template<comp6771::batch_layout Layout>
+	auto dot_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const batch = comp6771::euclidean_vector_batch(make_dataset(dimensions), Layout);
+		auto const query = make_vector(dimensions, -1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(batch, query));
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK_TEMPLATE(dot_batch, comp6771::batch_layout::row_major)->Apply(sweep_dimensions);
+	BENCHMARK_TEMPLATE(dot_batch, comp6771::batch_layout::column_major)->Apply(sweep_dimensions);
+
+	auto distance_separate(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const vectors = make_dataset(dimensions);
+		auto const query = make_vector(dimensions, -1);
+		for (auto _ : state) {
+			for (auto const& v : vectors) {
+				benchmark::DoNotOptimize(comp6771::euclidean_norm(v - query));
+			}
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(distance_separate)->Apply(sweep_dimensions);
+
+	template<comp6771::batch_layout Layout>
+	auto distance_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const batch = comp6771::euclidean_vector_batch(make_dataset(dimensions), Layout);
+		auto const query = make_vector(dimensions, -1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::distance(batch, query));
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK_TEMPLATE(distance_batch, comp6771::batch_layout::row_major)->Apply(sweep_dimensions);
+	BENCHMARK_TEMPLATE(distance_batch, comp6771::batch_layout::column_major)
+	   ->Apply(sweep_dimensions);
+
+	auto unit_separate(benchmark::State& state) -> void {
+		auto const vectors = make_dataset(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			for (auto const& v : vectors) {
+				benchmark::DoNotOptimize(comp6771::unit(v));
+			}
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(unit_separate)->Apply(sweep_dimensions);
+
+	template<comp6771::batch_layout Layout>
+	auto unit_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const batch = comp6771::euclidean_vector_batch(make_dataset(dimensions), Layout);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::unit(batch));
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK_TEMPLATE(unit_batch, comp6771::batch_layout::row_major)->Apply(sweep_dimensions);
+	BENCHMARK_TEMPLATE(unit_batch, comp6771::batch_layout::column_major)->Apply(sweep_dimensions);
+
+	template<comp6771::batch_layout Layout>
+	auto normalize_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto batch = comp6771::euclidean_vector_batch(make_dataset(dimensions), Layout);
+		for (auto _ : state) {
+			comp6771::normalize(batch);
+			benchmark::DoNotOptimize(batch.data());
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK_TEMPLATE(normalize_batch, comp6771::batch_layout::row_major)->Apply(sweep_dimensions);
+	BENCHMARK_TEMPLATE(normalize_batch, comp6771::batch_layout::column_major)
+	   ->Apply(sweep_dimensions);
+} // namespace
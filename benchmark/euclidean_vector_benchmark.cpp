@@ -0,0 +1,477 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <list>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Every sized benchmark sweeps 2, 8, 64, ... up to 1M dimensions.
+	auto sweep_dimensions(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(8)->Range(2, 1 << 20);
+	}
+
+	auto make_magnitudes(int dimensions) -> std::vector<double> {
+		auto magnitudes = std::vector<double>();
+		magnitudes.reserve(static_cast<std::size_t>(dimensions));
+		for (auto i = 0; i < dimensions; ++i) {
+			magnitudes.push_back(1.0 + 0.5 * static_cast<double>(i % 7));
+		}
+		return magnitudes;
+	}
+
+	auto make_vector(int dimensions) -> comp6771::euclidean_vector {
+		auto const magnitudes = make_magnitudes(dimensions);
+		return comp6771::euclidean_vector(magnitudes.cbegin(), magnitudes.cend());
+	}
+
+	auto dimensions_of(benchmark::State const& state) -> int {
+		return static_cast<int>(state.range(0));
+	}
+
+	// `arrays` is the number of dimension-sized arrays read or written per iteration.
+	auto set_bytes_processed(benchmark::State& state, int arrays) -> void {
+		state.SetBytesProcessed(state.iterations() * state.range(0) * arrays
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	// constructors
+	auto default_constructor(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector();
+			benchmark::DoNotOptimize(v);
+		}
+	}
+	BENCHMARK(default_constructor);
+
+	auto dimension_constructor(benchmark::State& state) -> void {
+		auto const dimensions = dimensions_of(state);
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(dimensions);
+			benchmark::DoNotOptimize(v);
+		}
+		set_bytes_processed(state, 1);
+	}
+	BENCHMARK(dimension_constructor)->Apply(sweep_dimensions);
+
+	auto magnitude_constructor(benchmark::State& state) -> void {
+		auto const dimensions = dimensions_of(state);
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(dimensions, 4.2);
+			benchmark::DoNotOptimize(v);
+		}
+		set_bytes_processed(state, 1);
+	}
+	BENCHMARK(magnitude_constructor)->Apply(sweep_dimensions);
+
+	auto iterator_constructor(benchmark::State& state) -> void {
+		auto const magnitudes = make_magnitudes(dimensions_of(state));
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(magnitudes.cbegin(), magnitudes.cend());
+			benchmark::DoNotOptimize(v);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(iterator_constructor)->Apply(sweep_dimensions);
+
+	auto uninitialized_constructor(benchmark::State& state) -> void {
+		auto const dimensions = dimensions_of(state);
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(comp6771::uninitialized, dimensions);
+			benchmark::DoNotOptimize(v);
+		}
+	}
+	BENCHMARK(uninitialized_constructor)->Apply(sweep_dimensions);
+
+	auto range_constructor(benchmark::State& state) -> void {
+		auto const magnitudes = make_magnitudes(dimensions_of(state));
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(magnitudes);
+			benchmark::DoNotOptimize(v);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(range_constructor)->Apply(sweep_dimensions);
+
+	auto span_constructor(benchmark::State& state) -> void {
+		auto const magnitudes = make_magnitudes(dimensions_of(state));
+		auto const span = std::span<double const>(magnitudes);
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(span);
+			benchmark::DoNotOptimize(v);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(span_constructor)->Apply(sweep_dimensions);
+
+	// a lazy view, whose elements are computed as they are written
+	auto transformed_range_constructor(benchmark::State& state) -> void {
+		auto const dimensions = dimensions_of(state);
+		for (auto _ : state) {
+			auto halves = std::views::iota(0, dimensions)
+			              | std::views::transform([](int i) { return 0.5 * i; });
+			auto v = comp6771::euclidean_vector(halves);
+			benchmark::DoNotOptimize(v);
+		}
+		set_bytes_processed(state, 1);
+	}
+	BENCHMARK(transformed_range_constructor)->Apply(sweep_dimensions);
+
+	auto generator_constructor(benchmark::State& state) -> void {
+		auto const dimensions = dimensions_of(state);
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(dimensions, [](int i) { return 0.5 * i; });
+			benchmark::DoNotOptimize(v);
+		}
+		set_bytes_processed(state, 1);
+	}
+	BENCHMARK(generator_constructor)->Apply(sweep_dimensions);
+
+	auto initializer_list_constructor(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector{1.0, 2.0, 3.0, 4.0};
+			benchmark::DoNotOptimize(v);
+		}
+	}
+	BENCHMARK(initializer_list_constructor);
+
+	auto copy_constructor(benchmark::State& state) -> void {
+		auto const source = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(source);
+			benchmark::DoNotOptimize(v);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(copy_constructor)->Apply(sweep_dimensions);
+
+	auto move_constructor(benchmark::State& state) -> void {
+		auto source = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(std::move(source));
+			benchmark::DoNotOptimize(v);
+			source = std::move(v);
+		}
+	}
+	BENCHMARK(move_constructor)->Apply(sweep_dimensions);
+
+	// Dimensions 1 to 8 straddle euclidean_vector::inline_capacity, so these show the cost of inline
+	// storage against heap storage for each size class.
+	auto sweep_small_dimensions(benchmark::internal::Benchmark* b) -> void {
+		b->DenseRange(1, 8);
+	}
+
+	auto construct_small(benchmark::State& state) -> void {
+		auto const dimensions = dimensions_of(state);
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(dimensions, 1.0);
+			benchmark::DoNotOptimize(v);
+		}
+	}
+	BENCHMARK(construct_small)->Apply(sweep_small_dimensions);
+
+	auto copy_small(benchmark::State& state) -> void {
+		auto const source = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto v = source;
+			benchmark::DoNotOptimize(v);
+		}
+	}
+	BENCHMARK(copy_small)->Apply(sweep_small_dimensions);
+
+	auto add_small(benchmark::State& state) -> void {
+		auto const a = make_vector(dimensions_of(state));
+		auto const b = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto c = comp6771::euclidean_vector(a + b);
+			benchmark::DoNotOptimize(c);
+		}
+	}
+	BENCHMARK(add_small)->Apply(sweep_small_dimensions);
+
+	// compound assignment
+	auto plus_assign(benchmark::State& state) -> void {
+		auto v = make_vector(dimensions_of(state));
+		auto const w = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			v += w;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(plus_assign)->Apply(sweep_dimensions);
+
+	auto minus_assign(benchmark::State& state) -> void {
+		auto v = make_vector(dimensions_of(state));
+		auto const w = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			v -= w;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(minus_assign)->Apply(sweep_dimensions);
+
+	auto multiply_assign(benchmark::State& state) -> void {
+		auto v = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			v *= 1.0;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(multiply_assign)->Apply(sweep_dimensions);
+
+	auto divide_assign(benchmark::State& state) -> void {
+		auto v = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			v /= 1.0;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(divide_assign)->Apply(sweep_dimensions);
+
+	// binary arithmetic
+	auto add(benchmark::State& state) -> void {
+		auto const a = make_vector(dimensions_of(state));
+		auto const b = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto c = comp6771::euclidean_vector(a + b);
+			benchmark::DoNotOptimize(c);
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(add)->Apply(sweep_dimensions);
+
+	auto subtract(benchmark::State& state) -> void {
+		auto const a = make_vector(dimensions_of(state));
+		auto const b = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto c = comp6771::euclidean_vector(a - b);
+			benchmark::DoNotOptimize(c);
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(subtract)->Apply(sweep_dimensions);
+
+	auto multiply(benchmark::State& state) -> void {
+		auto const a = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto c = comp6771::euclidean_vector(a * 2.0);
+			benchmark::DoNotOptimize(c);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(multiply)->Apply(sweep_dimensions);
+
+	auto multiply_scalar_first(benchmark::State& state) -> void {
+		auto const a = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto c = comp6771::euclidean_vector(2.0 * a);
+			benchmark::DoNotOptimize(c);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(multiply_scalar_first)->Apply(sweep_dimensions);
+
+	auto divide(benchmark::State& state) -> void {
+		auto const a = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto c = comp6771::euclidean_vector(a / 2.0);
+			benchmark::DoNotOptimize(c);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(divide)->Apply(sweep_dimensions);
+
+	auto chained_expression(benchmark::State& state) -> void {
+		auto const a = make_vector(dimensions_of(state));
+		auto const b = make_vector(dimensions_of(state));
+		auto const c = make_vector(dimensions_of(state));
+		auto result = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			result = a + b - c * 2.0;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 4);
+	}
+	BENCHMARK(chained_expression)->Apply(sweep_dimensions);
+
+	// utility functions
+	auto dot(benchmark::State& state) -> void {
+		auto const a = make_vector(dimensions_of(state));
+		auto const b = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(a, b));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(dot)->Apply(sweep_dimensions);
+
+	// dot over data that lives in a std::vector: copied into euclidean_vectors first...
+	auto dot_buffer_copy(benchmark::State& state) -> void {
+		auto const x = make_magnitudes(dimensions_of(state));
+		auto const y = make_magnitudes(dimensions_of(state));
+		for (auto _ : state) {
+			auto const a = comp6771::euclidean_vector(x.cbegin(), x.cend());
+			auto const b = comp6771::euclidean_vector(y.cbegin(), y.cend());
+			benchmark::DoNotOptimize(comp6771::dot(a, b));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(dot_buffer_copy)->Apply(sweep_dimensions);
+
+	// ...or viewed in place
+	auto dot_buffer_view(benchmark::State& state) -> void {
+		auto const x = make_magnitudes(dimensions_of(state));
+		auto const y = make_magnitudes(dimensions_of(state));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(
+			   comp6771::dot(comp6771::euclidean_vector_view(x), comp6771::euclidean_vector_view(y)));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(dot_buffer_view)->Apply(sweep_dimensions);
+
+	// dot at each SIMD level the CPU supports; the second argument is a kernels::simd_level
+	auto dot_simd_level(benchmark::State& state) -> void {
+		auto const level = static_cast<comp6771::kernels::simd_level>(state.range(1));
+		if (level > comp6771::kernels::detected_simd_level()) {
+			state.SkipWithError("SIMD level is not supported by this CPU");
+			return;
+		}
+		comp6771::kernels::set_simd_level(level);
+		auto const a = make_vector(dimensions_of(state));
+		auto const b = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(a, b));
+		}
+		comp6771::kernels::set_simd_level(comp6771::kernels::detected_simd_level());
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(dot_simd_level)->ArgsProduct({{4096, 1 << 20}, {0, 1, 2, 3}});
+
+	// dot and norm with each policy; the second argument is a kernels::accumulation
+	auto dot_accumulation(benchmark::State& state) -> void {
+		auto const policy = static_cast<comp6771::accumulation>(state.range(1));
+		auto const a = make_vector(dimensions_of(state));
+		auto const b = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(a, b, policy));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(dot_accumulation)->ArgsProduct({{4096, 1 << 20}, {0, 1, 2, 3}});
+
+	auto euclidean_norm_accumulation(benchmark::State& state) -> void {
+		auto const policy = static_cast<comp6771::accumulation>(state.range(1));
+		auto const v = make_vector(dimensions_of(state));
+		// a view has no cache, so the naive norm is computed on every iteration too
+		auto const view = comp6771::euclidean_vector_view(v);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(view, policy));
+		}
+		set_bytes_processed(state, 1);
+	}
+	BENCHMARK(euclidean_norm_accumulation)->ArgsProduct({{4096, 1 << 20}, {0, 1, 2, 3}});
+
+	auto euclidean_norm_cold(benchmark::State& state) -> void {
+		auto v = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			// Writing through the non-const subscript invalidates the cached norm.
+			v[0] = 1.0;
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+		}
+		set_bytes_processed(state, 1);
+	}
+	BENCHMARK(euclidean_norm_cold)->Apply(sweep_dimensions);
+
+	auto euclidean_norm_cached(benchmark::State& state) -> void {
+		auto const v = make_vector(dimensions_of(state));
+		benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+		}
+	}
+	BENCHMARK(euclidean_norm_cached)->Apply(sweep_dimensions);
+
+	auto unit(benchmark::State& state) -> void {
+		auto const v = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto u = comp6771::unit(v);
+			benchmark::DoNotOptimize(u);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(unit)->Apply(sweep_dimensions);
+
+	// normalising in place reads and writes the same storage and reuses the rescaled norm cache
+	auto normalize(benchmark::State& state) -> void {
+		auto v = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(v.normalize());
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(normalize)->Apply(sweep_dimensions);
+
+	// conversions
+	auto to_vector(benchmark::State& state) -> void {
+		auto const v = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto converted = static_cast<std::vector<double>>(v);
+			benchmark::DoNotOptimize(converted);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(to_vector)->Apply(sweep_dimensions);
+
+	auto to_list(benchmark::State& state) -> void {
+		auto const v = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			auto converted = static_cast<std::list<double>>(v);
+			benchmark::DoNotOptimize(converted);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(to_list)->Apply(sweep_dimensions);
+
+	// comparisons of equal vectors, which have to read every magnitude
+	auto equal(benchmark::State& state) -> void {
+		auto const x = make_vector(dimensions_of(state));
+		auto const y = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x == y);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(equal)->Apply(sweep_dimensions);
+
+	auto approx_equal(benchmark::State& state) -> void {
+		auto const x = make_vector(dimensions_of(state));
+		auto const y = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::approx_equal(x, y, 1e-12, 1e-9));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(approx_equal)->Apply(sweep_dimensions);
+
+	auto hash_value(benchmark::State& state) -> void {
+		auto const v = make_vector(dimensions_of(state));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::hash_value(v));
+		}
+		set_bytes_processed(state, 1);
+	}
+	BENCHMARK(hash_value)->Apply(sweep_dimensions);
+} // namespace
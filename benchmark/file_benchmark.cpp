@@ -0,0 +1,147 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_file.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	constexpr auto dataset_size = 4096;
+
+	auto sweep_dimensions(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(4)->Range(4, 256);
+	}
+
+	auto make_vector(int dimensions, int seed) -> comp6771::euclidean_vector {
+		auto v = comp6771::euclidean_vector(dimensions);
+		for (auto j = 0; j < dimensions; ++j) {
+			v[j] = static_cast<double>((seed * 31 + j * 17) % 101) / 101.0;
+		}
+		return v;
+	}
+
+	auto make_dataset(int dimensions) -> std::vector<comp6771::euclidean_vector> {
+		auto vectors = std::vector<comp6771::euclidean_vector>();
+		vectors.reserve(dataset_size);
+		for (auto i = 0; i < dataset_size; ++i) {
+			vectors.push_back(make_vector(dimensions, i));
+		}
+		return vectors;
+	}
+
+	auto set_bytes_processed(benchmark::State& state) -> void {
+		state.SetBytesProcessed(state.iterations() * dataset_size * state.range(0)
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto write_text(std::ostream& out, std::vector<comp6771::euclidean_vector> const& vectors)
+	   -> void {
+		for (auto const& v : vectors) {
+			out << v << '\n';
+		}
+	}
+
+	auto write_binary(std::ostream& out, std::vector<comp6771::euclidean_vector> const& vectors)
+	   -> void {
+		auto writer = comp6771::vector_file_writer(out, vectors.front().dimensions());
+		for (auto const& v : vectors) {
+			writer.write(v);
+		}
+		writer.finish();
+	}
+
+	// reads one "[a b c]" line back, the only parser the text format has
+	auto read_text(std::istream& in, comp6771::euclidean_vector& v) -> bool {
+		auto bracket = char();
+		if (not(in >> bracket)) {
+			return false;
+		}
+		for (auto i = 0; i < v.dimensions(); ++i) {
+			in >> v[i];
+		}
+		in >> bracket;
+		return true;
+	}
+
+	auto text_save(benchmark::State& state) -> void {
+		auto const vectors = make_dataset(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto out = std::ostringstream();
+			write_text(out, vectors);
+			benchmark::DoNotOptimize(out.tellp());
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(text_save)->Apply(sweep_dimensions);
+
+	auto binary_save(benchmark::State& state) -> void {
+		auto const vectors = make_dataset(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto out = std::ostringstream();
+			write_binary(out, vectors);
+			benchmark::DoNotOptimize(out.tellp());
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(binary_save)->Apply(sweep_dimensions);
+
+	auto text_load(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto out = std::ostringstream();
+		write_text(out, make_dataset(dimensions));
+		auto const text = out.str();
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			auto v = comp6771::euclidean_vector(dimensions);
+			while (read_text(in, v)) {
+				benchmark::DoNotOptimize(v.data());
+			}
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(text_load)->Apply(sweep_dimensions);
+
+	auto binary_load(benchmark::State& state) -> void {
+		auto out = std::ostringstream();
+		write_binary(out, make_dataset(static_cast<int>(state.range(0))));
+		auto const bytes = out.str();
+		for (auto _ : state) {
+			auto in = std::istringstream(bytes);
+			auto reader = comp6771::vector_file_reader(in);
+			auto v = comp6771::euclidean_vector();
+			while (reader.read(v)) {
+				benchmark::DoNotOptimize(v.data());
+			}
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(binary_load)->Apply(sweep_dimensions);
+
+	// mapping and reading every vector of a file; the page cache holds the file after the first
+	// iteration, as it would for a file that is mapped repeatedly
+	auto mapped_scan(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const path = std::filesystem::temp_directory_path() / "euclidean_vector_benchmark.bin";
+		{
+			auto out = std::ofstream(path, std::ios::binary);
+			write_binary(out, make_dataset(dimensions));
+		}
+		auto const query = make_vector(dimensions, -1);
+		for (auto _ : state) {
+			auto const file = comp6771::mapped_vector_file(path);
+			for (auto i = std::size_t{0}; i < file.size(); ++i) {
+				benchmark::DoNotOptimize(comp6771::dot(file[i], query));
+			}
+		}
+		std::filesystem::remove(path);
+		set_bytes_processed(state);
+	}
+	BENCHMARK(mapped_scan)->Apply(sweep_dimensions);
+} // namespace
@@ -0,0 +1,56 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/fixed_euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+	// number of 3D points in every dataset
+	constexpr auto dataset_size = 4096;
+
+	auto coordinate(int i, int j) -> double {
+		return static_cast<double>((i * 31 + j * 17) % 101) / 101.0 + 0.5;
+	}
+
+	// p[i] += (p[i] - centre) * 0.5, then the norm of the result: typical 3D point arithmetic
+	auto dynamic_points(benchmark::State& state) -> void {
+		auto points = std::vector<comp6771::euclidean_vector>();
+		for (auto i = 0; i < dataset_size; ++i) {
+			points.push_back(
+			   comp6771::euclidean_vector{coordinate(i, 0), coordinate(i, 1), coordinate(i, 2)});
+		}
+		auto const centre = comp6771::euclidean_vector{0.5, 0.5, 0.5};
+		for (auto _ : state) {
+			auto total = 0.0;
+			for (auto& p : points) {
+				p = p + (p - centre) * 1e-9;
+				total += comp6771::euclidean_norm(p);
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.SetItemsProcessed(state.iterations() * dataset_size);
+	}
+	BENCHMARK(dynamic_points);
+
+	auto fixed_points(benchmark::State& state) -> void {
+		using vec3 = comp6771::fixed_euclidean_vector<3>;
+		auto points = std::vector<vec3>();
+		for (auto i = 0; i < dataset_size; ++i) {
+			points.emplace_back(coordinate(i, 0), coordinate(i, 1), coordinate(i, 2));
+		}
+		constexpr auto centre = vec3(0.5);
+		for (auto _ : state) {
+			auto total = 0.0;
+			for (auto& p : points) {
+				p += (p - centre) * 1e-9;
+				total += comp6771::euclidean_norm(p);
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.SetItemsProcessed(state.iterations() * dataset_size);
+	}
+	BENCHMARK(fixed_points);
+} // namespace
@@ -0,0 +1,119 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_format.hpp"
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+	constexpr auto dataset_size = 1024;
+
+	auto sweep_dimensions(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(4)->Range(4, 256);
+	}
+
+	auto make_dataset(int dimensions) -> std::vector<comp6771::euclidean_vector> {
+		auto vectors = std::vector<comp6771::euclidean_vector>();
+		vectors.reserve(dataset_size);
+		for (auto i = 0; i < dataset_size; ++i) {
+			auto v = comp6771::euclidean_vector(dimensions);
+			for (auto j = 0; j < dimensions; ++j) {
+				v[j] = static_cast<double>((i * 31 + j * 17) % 1009) / 101.0;
+			}
+			vectors.push_back(std::move(v));
+		}
+		return vectors;
+	}
+
+	auto set_items_processed(benchmark::State& state) -> void {
+		state.SetItemsProcessed(state.iterations() * dataset_size * state.range(0));
+	}
+
+	auto format_text(std::vector<comp6771::euclidean_vector> const& vectors,
+	                 std::string_view format) -> std::string {
+		auto buffer = fmt::memory_buffer();
+		for (auto const& v : vectors) {
+			fmt::format_to(std::back_inserter(buffer), fmt::runtime(format), comp6771::formatted(v));
+		}
+		return fmt::to_string(buffer);
+	}
+
+	auto stream_format(benchmark::State& state) -> void {
+		auto const vectors = make_dataset(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto out = std::ostringstream();
+			for (auto const& v : vectors) {
+				out << v << '\n';
+			}
+			benchmark::DoNotOptimize(out.tellp());
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(stream_format)->Apply(sweep_dimensions);
+
+	auto fmt_format(benchmark::State& state) -> void {
+		auto const vectors = make_dataset(static_cast<int>(state.range(0)));
+		auto buffer = fmt::memory_buffer();
+		for (auto _ : state) {
+			buffer.clear();
+			for (auto const& v : vectors) {
+				fmt::format_to(std::back_inserter(buffer), "{}\n", comp6771::formatted(v));
+			}
+			benchmark::DoNotOptimize(buffer.data());
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(fmt_format)->Apply(sweep_dimensions);
+
+	// reads "[a b c]" lines with operator>>, as callers had to before parse_euclidean_vector
+	auto stream_parse(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const text = format_text(make_dataset(dimensions), "{}\n");
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			auto v = comp6771::euclidean_vector(dimensions);
+			auto bracket = char();
+			while (in >> bracket) {
+				for (auto i = 0; i < dimensions; ++i) {
+					in >> v[i];
+				}
+				in >> bracket;
+				benchmark::DoNotOptimize(v.data());
+			}
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(stream_parse)->Apply(sweep_dimensions);
+
+	auto from_chars_parse(benchmark::State& state) -> void {
+		auto const text = format_text(make_dataset(static_cast<int>(state.range(0))), "{}\n");
+		for (auto _ : state) {
+			auto rest = std::string_view(text);
+			auto v = comp6771::euclidean_vector();
+			for (auto i = 0; i < dataset_size; ++i) {
+				rest.remove_prefix(comp6771::parse_euclidean_vector(rest, v));
+				benchmark::DoNotOptimize(v.data());
+			}
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(from_chars_parse)->Apply(sweep_dimensions);
+
+	auto csv_parse(benchmark::State& state) -> void {
+		auto const text = format_text(make_dataset(static_cast<int>(state.range(0))), "{:n;,}\n");
+		for (auto _ : state) {
+			auto const batch = comp6771::parse_csv(text);
+			benchmark::DoNotOptimize(batch.data());
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(csv_parse)->Apply(sweep_dimensions);
+} // namespace
@@ -0,0 +1,104 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+namespace {
+	auto sweep_dimensions(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(16)->Range(16, 1 << 20);
+	}
+
+	auto make_vector(int dimensions, int seed) -> comp6771::euclidean_vector {
+		auto v = comp6771::euclidean_vector(dimensions);
+		for (auto j = 0; j < dimensions; ++j) {
+			v[j] = static_cast<double>((seed * 31 + j * 17) % 101) / 101.0;
+		}
+		return v;
+	}
+
+	auto set_bytes_processed(benchmark::State& state) -> void {
+		// both operands are read once per iteration
+		state.SetBytesProcessed(state.iterations() * state.range(0) * 2
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	// euclidean_norm(a - b) allocates the difference before taking its norm
+	auto distance_temporary(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const a = make_vector(dimensions, 1);
+		auto const b = make_vector(dimensions, 2);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(a - b));
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(distance_temporary)->Apply(sweep_dimensions);
+
+	auto distance_fused(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const a = make_vector(dimensions, 1);
+		auto const b = make_vector(dimensions, 2);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::distance(a, b));
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(distance_fused)->Apply(sweep_dimensions);
+
+	// three passes: the dot product, then each norm
+	auto cosine_separate(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto a = make_vector(dimensions, 1);
+		auto b = make_vector(dimensions, 2);
+		for (auto _ : state) {
+			// Writing through the non-const subscript invalidates the cached norms.
+			a[0] = 1.0;
+			b[0] = 1.0;
+			benchmark::DoNotOptimize(comp6771::dot(a, b)
+			                         / (comp6771::euclidean_norm(a) * comp6771::euclidean_norm(b)));
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(cosine_separate)->Apply(sweep_dimensions);
+
+	auto cosine_fused(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto a = make_vector(dimensions, 1);
+		auto b = make_vector(dimensions, 2);
+		for (auto _ : state) {
+			a[0] = 1.0;
+			b[0] = 1.0;
+			benchmark::DoNotOptimize(comp6771::cosine_similarity(a, b));
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(cosine_fused)->Apply(sweep_dimensions);
+
+	// y += x * alpha as an expression evaluated into y
+	auto axpy_expression(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const x = make_vector(dimensions, 1);
+		auto y = make_vector(dimensions, 2);
+		for (auto _ : state) {
+			y = y + x * 1e-9;
+			benchmark::DoNotOptimize(y.data());
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(axpy_expression)->Apply(sweep_dimensions);
+
+	auto axpy_fused(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const x = make_vector(dimensions, 1);
+		auto y = make_vector(dimensions, 2);
+		for (auto _ : state) {
+			comp6771::axpy(1e-9, x, y);
+			benchmark::DoNotOptimize(y.data());
+		}
+		set_bytes_processed(state);
+	}
+	BENCHMARK(axpy_fused)->Apply(sweep_dimensions);
+} // namespace
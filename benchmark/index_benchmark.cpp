@@ -0,0 +1,132 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_index.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+	constexpr auto queries_per_batch = 1000;
+	constexpr auto k = 10;
+
+	// `size` vectors scattered around `clusters` centres, like embeddings of a few topics
+	auto clustered(int size, int dimensions, int clusters, std::uint32_t seed)
+	   -> comp6771::euclidean_vector_batch {
+		auto engine = std::mt19937(seed);
+		auto centre = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto noise = std::normal_distribution<double>(0.0, 0.25);
+		auto centres = comp6771::euclidean_vector_batch(clusters, dimensions);
+		for (auto c = 0; c < clusters; ++c) {
+			for (auto d = 0; d < dimensions; ++d) {
+				centres(c, d) = centre(engine);
+			}
+		}
+		auto batch = comp6771::euclidean_vector_batch(size, dimensions);
+		auto pick = std::uniform_int_distribution<int>(0, clusters - 1);
+		for (auto i = 0; i < size; ++i) {
+			auto const c = pick(engine);
+			for (auto d = 0; d < dimensions; ++d) {
+				batch(i, d) = centres(c, d) + noise(engine);
+			}
+		}
+		return batch;
+	}
+
+	// the fraction of the exact neighbours that `found` contains
+	auto recall(std::vector<std::vector<comp6771::neighbour>> const& found,
+	            std::vector<std::vector<comp6771::neighbour>> const& exact) -> double {
+		auto hits = 0;
+		auto total = 0;
+		for (auto q = std::size_t{0}; q < exact.size(); ++q) {
+			for (auto const& n : exact[q]) {
+				for (auto const& f : found[q]) {
+					hits += static_cast<int>(f.row == n.row);
+				}
+				++total;
+			}
+		}
+		return static_cast<double>(hits) / static_cast<double>(total);
+	}
+
+	struct dataset {
+		comp6771::euclidean_vector_batch vectors;
+		comp6771::euclidean_vector_batch queries;
+		std::vector<std::vector<comp6771::neighbour>> exact;
+	};
+
+	// 200k vectors of 3 dimensions, or 50k of 64, with the exact answers to their queries
+	auto make_dataset(int dimensions) -> dataset {
+		auto const size = dimensions <= 3 ? 200'000 : 50'000;
+		auto result = dataset{clustered(size, dimensions, 100, 1),
+		                      clustered(queries_per_batch, dimensions, 100, 2),
+		                      {}};
+		result.exact = comp6771::brute_force_index(result.vectors, 8).search(result.queries, k);
+		return result;
+	}
+
+	auto data(int dimensions) -> dataset const& {
+		static auto const low = make_dataset(3);
+		static auto const high = make_dataset(64);
+		return dimensions <= 3 ? low : high;
+	}
+
+	// queries/s over batches of queries; state.range(0) is the dimensions, state.range(1) the
+	// threads
+	template<typename Index>
+	auto exact_search(benchmark::State& state) -> void {
+		auto const& set = data(static_cast<int>(state.range(0)));
+		auto const index = Index(set.vectors, static_cast<std::size_t>(state.range(1)));
+		auto found = std::vector<std::vector<comp6771::neighbour>>();
+		for (auto _ : state) {
+			found = index.search(set.queries, k);
+			benchmark::DoNotOptimize(found.data());
+		}
+		state.counters["recall"] = recall(found, set.exact);
+		state.SetItemsProcessed(state.iterations() * queries_per_batch);
+	}
+	BENCHMARK_TEMPLATE(exact_search, comp6771::brute_force_index)
+	   ->Args({3, 1})
+	   ->Args({64, 1})
+	   ->Args({64, 4})
+	   ->UseRealTime();
+	BENCHMARK_TEMPLATE(exact_search, comp6771::kd_tree_index)
+	   ->Args({3, 1})
+	   ->Args({3, 4})
+	   ->Args({64, 1})
+	   ->UseRealTime();
+
+	// 64 dimensions, 256 lists; state.range(0) probes, state.range(1) threads
+	auto ivf_search(benchmark::State& state) -> void {
+		auto const& set = data(64);
+		auto const threads = static_cast<std::size_t>(state.range(1));
+		auto const index = comp6771::ivf_index(set.vectors, {.lists = 256}, threads);
+		auto const probes = static_cast<int>(state.range(0));
+		auto found = std::vector<std::vector<comp6771::neighbour>>();
+		for (auto _ : state) {
+			found = index.search(set.queries, k, probes);
+			benchmark::DoNotOptimize(found.data());
+		}
+		state.counters["recall"] = recall(found, set.exact);
+		state.SetItemsProcessed(state.iterations() * queries_per_batch);
+	}
+	BENCHMARK(ivf_search)
+	   ->ArgsProduct({{1, 2, 4, 8, 16, 32}, {1}})
+	   ->Args({8, 4})
+	   ->UseRealTime();
+
+	auto ivf_build(benchmark::State& state) -> void {
+		auto const& set = data(64);
+		for (auto _ : state) {
+			auto const index = comp6771::ivf_index(set.vectors,
+			                                       {.lists = 256},
+			                                       static_cast<std::size_t>(state.range(0)));
+			benchmark::DoNotOptimize(index.lists());
+		}
+	}
+	BENCHMARK(ivf_build)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+} // namespace
@@ -0,0 +1,89 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+	constexpr auto dataset_size = 1000;
+
+	auto random_vectors(int size, int dimensions, std::uint32_t seed)
+	   -> std::vector<comp6771::euclidean_vector> {
+		auto engine = std::mt19937(seed);
+		auto magnitude = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto vectors = std::vector<comp6771::euclidean_vector>();
+		vectors.reserve(static_cast<std::size_t>(size));
+		for (auto i = 0; i < size; ++i) {
+			vectors.emplace_back(dimensions, [&](int) { return magnitude(engine); });
+		}
+		return vectors;
+	}
+
+	// each multiply-add is two floating-point operations
+	auto count_flops(benchmark::State& state, std::int64_t rows, std::int64_t columns, int vectors)
+	   -> void {
+		auto const flops = 2 * rows * columns * vectors * state.iterations();
+		state.counters["FLOP/s"] = benchmark::Counter(static_cast<double>(flops),
+		                                              benchmark::Counter::kIsRate);
+	}
+
+	// the baseline: dot(row, vector) for every row of a square matrix and every vector;
+	// state.range(0) is the dimensions
+	auto dot_loop(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const rows = random_vectors(dimensions, dimensions, 1);
+		auto const vectors = random_vectors(dataset_size, dimensions, 2);
+		auto result = comp6771::euclidean_vector(dimensions);
+		for (auto _ : state) {
+			for (auto const& v : vectors) {
+				for (auto i = 0; i < dimensions; ++i) {
+					result[i] = comp6771::dot(rows[static_cast<std::size_t>(i)], v);
+				}
+				benchmark::DoNotOptimize(result.data());
+			}
+		}
+		count_flops(state, dimensions, dimensions, dataset_size);
+	}
+	BENCHMARK(dot_loop)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+
+	// transform(matrix, vector) for every vector
+	auto transform_vectors(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const m = comp6771::euclidean_matrix(random_vectors(dimensions, dimensions, 1));
+		auto const vectors = random_vectors(dataset_size, dimensions, 2);
+		for (auto _ : state) {
+			for (auto const& v : vectors) {
+				auto const result = comp6771::transform(m, v);
+				benchmark::DoNotOptimize(result.data());
+			}
+		}
+		count_flops(state, dimensions, dimensions, dataset_size);
+	}
+	BENCHMARK(transform_vectors)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+
+	// transform(matrix, batch); state.range(0) is the dimensions, state.range(1) the threads
+	auto transform_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const m = comp6771::euclidean_matrix(random_vectors(dimensions, dimensions, 1));
+		auto const vectors =
+		   comp6771::euclidean_vector_batch(random_vectors(dataset_size, dimensions, 2));
+		auto pool = comp6771::thread_pool(static_cast<std::size_t>(state.range(1)));
+		for (auto _ : state) {
+			auto const result = comp6771::transform(m, vectors, pool);
+			benchmark::DoNotOptimize(result.data());
+		}
+		count_flops(state, dimensions, dimensions, dataset_size);
+	}
+	BENCHMARK(transform_batch)
+	   ->ArgsProduct({{16, 64, 256, 1024}, {1}})
+	   ->Args({1024, 4})
+	   ->UseRealTime();
+} // namespace
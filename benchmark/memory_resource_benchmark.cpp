@@ -0,0 +1,62 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace {
+	// vectors created and dropped together before the arena is released
+	constexpr auto batch_size = 1000;
+
+	auto sweep_dimensions(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(4)->Range(8, 4096);
+	}
+
+	// Creates two vectors per element of a batch, combines them and throws them away.
+	auto create_compute_discard(benchmark::State& state, std::pmr::memory_resource* resource)
+	   -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const allocator = comp6771::euclidean_vector::allocator_type(resource);
+		auto sum = 0.0;
+		for (auto i = 0; i < batch_size; ++i) {
+			auto const a = comp6771::euclidean_vector(dimensions, 1.0, allocator);
+			auto b = comp6771::euclidean_vector(dimensions, allocator);
+			b = a * 2.0 + a;
+			sum += comp6771::dot(a, b);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	auto default_resource(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			create_compute_discard(state, std::pmr::get_default_resource());
+		}
+		state.SetItemsProcessed(state.iterations() * batch_size);
+	}
+	BENCHMARK(default_resource)->Apply(sweep_dimensions);
+
+	auto monotonic_arena(benchmark::State& state) -> void {
+		auto const bytes = static_cast<std::size_t>(state.range(0)) * sizeof(double) * 2 * batch_size;
+		auto buffer = std::vector<std::byte>(bytes + 64 * 2 * batch_size);
+		auto arena = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size());
+		for (auto _ : state) {
+			create_compute_discard(state, &arena);
+			arena.release();
+		}
+		state.SetItemsProcessed(state.iterations() * batch_size);
+	}
+	BENCHMARK(monotonic_arena)->Apply(sweep_dimensions);
+
+	auto unsynchronized_pool(benchmark::State& state) -> void {
+		auto pool = std::pmr::unsynchronized_pool_resource();
+		for (auto _ : state) {
+			create_compute_discard(state, &pool);
+		}
+		state.SetItemsProcessed(state.iterations() * batch_size);
+	}
+	BENCHMARK(unsynchronized_pool)->Apply(sweep_dimensions);
+} // namespace
@@ -0,0 +1,109 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+	// The first argument is the number of dimensions and the second the number of threads, with 0
+	// meaning parallel execution is disabled. Thread counts double up to the number of cores.
+	auto sweep_threads(benchmark::internal::Benchmark* b) -> void {
+		auto const cores = std::max(std::int64_t{1},
+		                            std::int64_t{std::thread::hardware_concurrency()});
+		for (auto const dimensions : {std::int64_t{1} << 20, std::int64_t{1} << 24}) {
+			b->Args({dimensions, 0});
+			for (auto threads = std::int64_t{1}; threads < 2 * cores; threads *= 2) {
+				b->Args({dimensions, std::min(threads, cores)});
+			}
+		}
+		b->UseRealTime();
+	}
+
+	auto make_vector(std::int64_t dimensions) -> comp6771::euclidean_vector {
+		auto magnitudes = std::vector<double>(static_cast<std::size_t>(dimensions));
+		for (auto i = std::size_t{0}; i < magnitudes.size(); ++i) {
+			magnitudes[i] = 1.0 + 0.5 * static_cast<double>(i % 7);
+		}
+		return comp6771::euclidean_vector(magnitudes.cbegin(), magnitudes.cend());
+	}
+
+	// Enables parallel execution for the duration of a benchmark with the threshold at its
+	// default, so that the results show what users get by opting in.
+	class parallel_scope {
+	public:
+		explicit parallel_scope(benchmark::State const& state) {
+			if (auto const threads = state.range(1); threads > 0) {
+				comp6771::kernels::enable_parallel_execution(static_cast<std::size_t>(threads));
+			}
+		}
+
+		parallel_scope(parallel_scope const&) = delete;
+		parallel_scope(parallel_scope&&) = delete;
+		auto operator=(parallel_scope const&) -> parallel_scope& = delete;
+		auto operator=(parallel_scope&&) -> parallel_scope& = delete;
+
+		~parallel_scope() {
+			comp6771::kernels::disable_parallel_execution();
+		}
+	};
+
+	// `arrays` is the number of dimension-sized arrays read or written per iteration.
+	auto set_bytes_processed(benchmark::State& state, int arrays) -> void {
+		state.SetBytesProcessed(state.iterations() * state.range(0) * arrays
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto parallel_dot(benchmark::State& state) -> void {
+		auto const a = make_vector(state.range(0));
+		auto const b = make_vector(state.range(0));
+		auto const scope = parallel_scope(state);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(a, b));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(parallel_dot)->Apply(sweep_threads);
+
+	auto parallel_plus_assign(benchmark::State& state) -> void {
+		auto a = make_vector(state.range(0));
+		auto const b = make_vector(state.range(0));
+		auto const scope = parallel_scope(state);
+		for (auto _ : state) {
+			a += b;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(parallel_plus_assign)->Apply(sweep_threads);
+
+	auto parallel_expression(benchmark::State& state) -> void {
+		auto const a = make_vector(state.range(0));
+		auto const b = make_vector(state.range(0));
+		auto c = make_vector(state.range(0));
+		auto const scope = parallel_scope(state);
+		for (auto _ : state) {
+			c = a - b;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(parallel_expression)->Apply(sweep_threads);
+
+	auto parallel_copy(benchmark::State& state) -> void {
+		auto const a = make_vector(state.range(0));
+		auto const scope = parallel_scope(state);
+		for (auto _ : state) {
+			auto copy = a;
+			benchmark::DoNotOptimize(copy);
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(parallel_copy)->Apply(sweep_threads);
+} // namespace
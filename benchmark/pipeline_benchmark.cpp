@@ -0,0 +1,116 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_file.hpp"
+#include "comp6771/euclidean_vector_pipeline.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace {
+	constexpr auto dataset_size = 50'000;
+	constexpr auto dimensions = 128;
+	constexpr auto references = 64;
+
+	auto random_vectors(int size, std::uint32_t seed) -> std::vector<comp6771::euclidean_vector> {
+		auto engine = std::mt19937(seed);
+		auto magnitude = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto vectors = std::vector<comp6771::euclidean_vector>();
+		vectors.reserve(static_cast<std::size_t>(size));
+		for (auto i = 0; i < size; ++i) {
+			vectors.emplace_back(dimensions, [&](int) { return magnitude(engine); });
+		}
+		return vectors;
+	}
+
+	// a local vector file to read from and one to write scores to, removed afterwards
+	class local_files {
+	public:
+		local_files()
+		: source_(std::filesystem::temp_directory_path() / "euclidean_vector_pipeline_in.bin")
+		, sink_(std::filesystem::temp_directory_path() / "euclidean_vector_pipeline_out.bin") {
+			auto out = std::ofstream(source_, std::ios::binary);
+			auto writer = comp6771::vector_file_writer(out, dimensions);
+			for (auto const& v : random_vectors(dataset_size, 1)) {
+				writer.write(v);
+			}
+		}
+
+		local_files(local_files const&) = delete;
+		auto operator=(local_files const&) -> local_files& = delete;
+
+		~local_files() {
+			std::filesystem::remove(source_);
+			std::filesystem::remove(sink_);
+		}
+
+		[[nodiscard]] auto source() const -> std::filesystem::path const& {
+			return source_;
+		}
+
+		[[nodiscard]] auto sink() const -> std::filesystem::path const& {
+			return sink_;
+		}
+
+	private:
+		std::filesystem::path source_;
+		std::filesystem::path sink_;
+	};
+
+	auto set_items_processed(benchmark::State& state) -> void {
+		state.SetItemsProcessed(state.iterations() * dataset_size);
+	}
+
+	// the baseline: read every vector, then normalise them all, then score them all, then write
+	auto one_step_at_a_time(benchmark::State& state) -> void {
+		auto const files = local_files();
+		auto const m = comp6771::euclidean_matrix(random_vectors(references, 2));
+		for (auto _ : state) {
+			auto in = std::ifstream(files.source(), std::ios::binary);
+			auto reader = comp6771::vector_file_reader(in);
+			auto const vectors = comp6771::unit(reader.read_all());
+			auto const scores = comp6771::transform(m, vectors);
+			auto out = std::ofstream(files.sink(), std::ios::binary);
+			auto writer = comp6771::vector_file_writer(out, references);
+			writer.write(scores);
+			writer.finish();
+		}
+		set_items_processed(state);
+	}
+	BENCHMARK(one_step_at_a_time)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+	// score_stream; state.range(0) is the batch size, state.range(1) the workers of each stage
+	auto pipelined(benchmark::State& state) -> void {
+		auto const files = local_files();
+		auto const m = comp6771::euclidean_matrix(random_vectors(references, 2));
+		auto const options =
+		   comp6771::pipeline_options{.batch_size = static_cast<int>(state.range(0))};
+		auto const workers = static_cast<std::size_t>(state.range(1));
+		auto report = comp6771::pipeline_report();
+		for (auto _ : state) {
+			auto in = std::ifstream(files.source(), std::ios::binary);
+			auto reader = comp6771::vector_file_reader(in);
+			auto out = std::ofstream(files.sink(), std::ios::binary);
+			auto writer = comp6771::vector_file_writer(out, references);
+			report = comp6771::score_stream(reader, m, writer, {workers, workers}, options);
+			writer.finish();
+		}
+		set_items_processed(state);
+		// how long a batch took from being read to being written, in the last run
+		state.counters["p50_us"] = static_cast<double>(report.batches.latency_quantile(0.5)) / 1e3;
+		state.counters["p99_us"] = static_cast<double>(report.batches.latency_quantile(0.99)) / 1e3;
+	}
+	BENCHMARK(pipelined)
+	   ->ArgsProduct({{64, 256, 1024, 4096}, {1}})
+	   ->Args({1024, 2})
+	   ->Unit(benchmark::kMillisecond)
+	   ->UseRealTime();
+} // namespace
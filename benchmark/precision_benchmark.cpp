@@ -0,0 +1,39 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/basic_euclidean_vector.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+
+namespace {
+	auto magnitudes(int size, int seed) -> std::vector<double> {
+		auto result = std::vector<double>(static_cast<std::size_t>(size));
+		for (auto i = 0; i < size; ++i) {
+			result[static_cast<std::size_t>(i)] =
+			   static_cast<double>((i * 31 + seed * 17) % 101) / 101.0 - 0.5;
+		}
+		return result;
+	}
+
+	// dot products of two vectors of state.range(0) dimensions; bytes counts both operands
+	template<typename Vector>
+	auto dot_product(benchmark::State& state) -> void {
+		auto const size = static_cast<int>(state.range(0));
+		auto const x = Vector(comp6771::euclidean_vector_view(magnitudes(size, 1)));
+		auto const y = Vector(comp6771::euclidean_vector_view(magnitudes(size, 2)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		auto const element_size = static_cast<std::int64_t>(sizeof(*x.data()));
+		state.SetItemsProcessed(state.iterations() * size);
+		state.SetBytesProcessed(state.iterations() * size * 2 * element_size);
+	}
+	BENCHMARK_TEMPLATE(dot_product, comp6771::euclidean_vector)->Range(1 << 10, 1 << 22);
+	BENCHMARK_TEMPLATE(dot_product, comp6771::float_euclidean_vector)->Range(1 << 10, 1 << 22);
+	BENCHMARK_TEMPLATE(dot_product, comp6771::bfloat16_euclidean_vector)->Range(1 << 10, 1 << 22);
+	BENCHMARK_TEMPLATE(dot_product, comp6771::int8_euclidean_vector)->Range(1 << 10, 1 << 22);
+} // namespace
@@ -0,0 +1,65 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/sparse_euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <vector>
+
+namespace {
+	// text-feature-like vectors: a million dimensions, a few hundred non-zeros
+	constexpr auto dimensions = 1 << 20;
+
+	// `non_zeros` magnitudes spread evenly over the dimensions, starting at `offset`
+	auto spread(int non_zeros, int offset) -> comp6771::sparse_euclidean_vector {
+		auto indices = std::vector<int>();
+		auto values = std::vector<double>();
+		auto const gap = dimensions / non_zeros;
+		for (auto i = 0; i < non_zeros; ++i) {
+			indices.push_back((i * gap + offset) % dimensions);
+			values.push_back(static_cast<double>(i % 7) - 3.5);
+		}
+		return comp6771::sparse_euclidean_vector(dimensions, indices, values);
+	}
+
+	auto dense_dot(benchmark::State& state) -> void {
+		auto const x = static_cast<comp6771::euclidean_vector>(spread(300, 0));
+		auto const y = static_cast<comp6771::euclidean_vector>(spread(300, 0));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+	}
+	BENCHMARK(dense_dot);
+
+	// state.range(0) and state.range(1) non-zeros; the ranges where one is 16 times the other
+	// gallop instead of merging
+	auto sparse_dot(benchmark::State& state) -> void {
+		auto const x = spread(static_cast<int>(state.range(0)), 0);
+		auto const y = spread(static_cast<int>(state.range(1)), 0);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+	}
+	BENCHMARK(sparse_dot)->Args({300, 300})->Args({300, 4'000})->Args({300, 100'000});
+
+	auto sparse_dense_dot(benchmark::State& state) -> void {
+		auto const x = spread(300, 0);
+		auto const y = static_cast<std::vector<double>>(spread(100'000, 0));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, comp6771::euclidean_vector_view(y)));
+		}
+	}
+	BENCHMARK(sparse_dense_dot);
+
+	auto sparse_add(benchmark::State& state) -> void {
+		auto const x = spread(300, 0);
+		auto const y = spread(300, 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x + y);
+		}
+	}
+	BENCHMARK(sparse_add);
+} // namespace
@@ -0,0 +1,85 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_statistics.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+	constexpr auto dataset_size = 100'000;
+
+	auto random_vectors(int size, int dimensions, std::uint32_t seed)
+	   -> std::vector<comp6771::euclidean_vector> {
+		auto engine = std::mt19937(seed);
+		auto magnitude = std::normal_distribution<double>(5.0, 2.0);
+		auto vectors = std::vector<comp6771::euclidean_vector>();
+		vectors.reserve(static_cast<std::size_t>(size));
+		for (auto i = 0; i < size; ++i) {
+			vectors.emplace_back(dimensions, [&](int) { return magnitude(engine); });
+		}
+		return vectors;
+	}
+
+	// the baseline: a pass for the mean and another for the variance, with the vector operators
+	auto two_passes(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const vectors = random_vectors(dataset_size, dimensions, 1);
+		for (auto _ : state) {
+			auto mean = comp6771::euclidean_vector(dimensions);
+			for (auto const& v : vectors) {
+				mean += v;
+			}
+			mean /= static_cast<double>(dataset_size);
+			auto variance = comp6771::euclidean_vector(dimensions);
+			for (auto const& v : vectors) {
+				auto const delta = comp6771::euclidean_vector(v - mean);
+				for (auto i = 0; i < dimensions; ++i) {
+					variance[i] += delta[i] * delta[i];
+				}
+			}
+			variance /= static_cast<double>(dataset_size);
+			benchmark::DoNotOptimize(variance.data());
+		}
+		state.SetItemsProcessed(state.iterations() * dataset_size);
+	}
+	BENCHMARK(two_passes)->Arg(16)->Arg(128)->Arg(1024);
+
+	// vector_statistics::add for every vector
+	auto one_pass(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const vectors = random_vectors(dataset_size, dimensions, 1);
+		for (auto _ : state) {
+			auto statistics = comp6771::vector_statistics(dimensions);
+			statistics.add(vectors);
+			benchmark::DoNotOptimize(statistics.variance().data());
+		}
+		state.SetItemsProcessed(state.iterations() * dataset_size);
+	}
+	BENCHMARK(one_pass)->Arg(16)->Arg(128)->Arg(1024);
+
+	// describe(batch) with a norm histogram; state.range(1) is the threads
+	auto describe_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const vectors =
+		   comp6771::euclidean_vector_batch(random_vectors(dataset_size, dimensions, 1));
+		auto const histogram =
+		   comp6771::norm_histogram_options{.bins = 64, .low = 0.0, .high = 200.0};
+		auto pool = comp6771::thread_pool(static_cast<std::size_t>(state.range(1)));
+		for (auto _ : state) {
+			auto const statistics = comp6771::describe(vectors, histogram, pool);
+			benchmark::DoNotOptimize(statistics.mean().data());
+		}
+		state.SetItemsProcessed(state.iterations() * dataset_size);
+	}
+	BENCHMARK(describe_batch)
+	   ->ArgsProduct({{16, 128, 1024}, {1}})
+	   ->Args({1024, 4})
+	   ->UseRealTime();
+} // namespace
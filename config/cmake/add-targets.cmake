@@ -48,9 +48,19 @@ endfunction()
 # Accepts the same parameters as `cxx_executable`.
 # Depends on Google Benchmark being imported.
 function(cxx_benchmark)
-   cxx_executable(${ARGN})
+   cxx_inlined_benchmark(${ARGN})
 
    PROJECT_TEMPLATE_EXTRACT_ADD_TARGET_ARGS(${ARGN})
    target_compile_options("${add_target_args_TARGET}" PRIVATE -fno-inline)
+endfunction()
+
+# Builds a benchmark without `-fno-inline`, so that the measured code is inlined the same way as the
+# code that ships.
+# Accepts the same parameters as `cxx_executable`.
+# Depends on Google Benchmark being imported.
+function(cxx_inlined_benchmark)
+   cxx_executable(${ARGN})
+
+   PROJECT_TEMPLATE_EXTRACT_ADD_TARGET_ARGS(${ARGN})
    target_link_libraries("${add_target_args_TARGET}" PRIVATE benchmark::benchmark benchmark::benchmark_main)
 endfunction()
@@ -0,0 +1,221 @@
+#ifndef COMP6771_BASIC_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_BASIC_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/bfloat16.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace comp6771 {
+	// Maps an int8 q to the magnitude (q - zero_point) * scale.
+	struct quantization {
+		double scale = 1.0;
+		int zero_point = 0;
+
+		// Spreads the range of `vector`, widened to include 0, over all 256 int8 values, so 0 is
+		// stored exactly and every finite magnitude is stored within scale / 2.
+		[[nodiscard]] static auto fit(euclidean_vector_view vector) noexcept -> quantization {
+			auto low = 0.0;
+			auto high = 0.0;
+			for (auto i = 0; i < vector.dimensions(); ++i) {
+				if (std::isfinite(vector[i])) {
+					low = std::min(low, vector[i]);
+					high = std::max(high, vector[i]);
+				}
+			}
+			if (high == low) {
+				return {};
+			}
+			auto const scale = (high - low) / 255.0;
+			auto const zero_point = std::clamp(std::nearbyint(-128.0 - low / scale), -128.0, 127.0);
+			return {scale, static_cast<int>(zero_point)};
+		}
+
+		friend auto operator==(quantization const&, quantization const&) noexcept -> bool = default;
+	};
+
+	template<typename T>
+	concept compact_element = std::same_as<T, float> or std::same_as<T, bfloat16>
+	                          or std::same_as<T, std::int8_t>;
+
+	// A euclidean_vector that stores its magnitudes as floats, bfloat16s or quantised int8s, to
+	// halve or quarter the memory, and the bandwidth, that double magnitudes take. Magnitudes are
+	// rounded to T when they are stored and are read back as doubles; dot and euclidean_norm
+	// accumulate in double (or, for int8, exactly in 64-bit integers). Arithmetic is done on
+	// euclidean_vector: convert, compute and convert back.
+	template<compact_element T>
+	class basic_euclidean_vector {
+	public:
+		using element_type = T;
+
+		basic_euclidean_vector()
+		: basic_euclidean_vector(1) {}
+
+		// `dimensions` zeroes
+		explicit basic_euclidean_vector(int dimensions)
+		: elements_(static_cast<std::size_t>(dimensions)) {}
+
+		// rounds each magnitude of `vector` to T; int8 vectors use quantization::fit(vector)
+		explicit basic_euclidean_vector(euclidean_vector_view vector)
+		: basic_euclidean_vector(vector, default_quantization(vector), 0) {}
+
+		// Magnitudes outside the range `parameters` covers are clamped to it, and NaNs are stored
+		// as 0.
+		basic_euclidean_vector(euclidean_vector_view vector, comp6771::quantization parameters)
+		requires std::same_as<T, std::int8_t>
+		: basic_euclidean_vector(vector, parameters, 0) {}
+
+		// converts through double, rounding or requantising each magnitude
+		template<compact_element U>
+		requires(not std::same_as<T, U>)
+		explicit basic_euclidean_vector(basic_euclidean_vector<U> const& vector)
+		: basic_euclidean_vector(euclidean_vector_view(static_cast<std::vector<double>>(vector))) {}
+
+		auto operator[](int i) const noexcept -> double {
+			auto const element = elements_[static_cast<std::size_t>(i)];
+			if constexpr (std::same_as<T, std::int8_t>) {
+				return (element - quantization_.zero_point) * quantization_.scale;
+			}
+			else {
+				return static_cast<double>(static_cast<float>(element));
+			}
+		}
+
+		[[nodiscard]] auto at(int dimension) const -> double {
+			if (dimension < 0 or dimension >= dimensions()) {
+				throw std::out_of_range("Index " + std::to_string(dimension)
+				                        + " is not Valid for this basic_euclidean_vector object");
+			}
+			return (*this)[dimension];
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return static_cast<int>(elements_.size());
+		}
+
+		// the stored elements; for int8, decode them with scale() and zero_point()
+		[[nodiscard]] auto data() const noexcept -> T const* {
+			return elements_.data();
+		}
+
+		[[nodiscard]] auto scale() const noexcept -> double {
+			return quantization_.scale;
+		}
+
+		[[nodiscard]] auto zero_point() const noexcept -> int {
+			return quantization_.zero_point;
+		}
+
+		[[nodiscard]] auto quantization() const noexcept -> comp6771::quantization {
+			return quantization_;
+		}
+
+		// the sum of the stored int8s, which dot needs to remove the zero points
+		[[nodiscard]] auto element_sum() const noexcept -> std::int64_t
+		requires std::same_as<T, std::int8_t> {
+			return element_sum_;
+		}
+
+		explicit operator std::vector<double>() const {
+			auto magnitudes = std::vector<double>(elements_.size());
+			for (auto i = 0; i < dimensions(); ++i) {
+				magnitudes[static_cast<std::size_t>(i)] = (*this)[i];
+			}
+			return magnitudes;
+		}
+
+		explicit operator euclidean_vector() const {
+			return euclidean_vector(dimensions(), [this](int i) { return (*this)[i]; });
+		}
+
+		friend auto operator==(basic_euclidean_vector const&, basic_euclidean_vector const&)
+		   -> bool = default;
+
+	private:
+		std::vector<T> elements_;
+		comp6771::quantization quantization_;
+		std::int64_t element_sum_ = 0;
+
+		basic_euclidean_vector(euclidean_vector_view vector,
+		                       comp6771::quantization parameters,
+		                       int /*tag*/)
+		: elements_(static_cast<std::size_t>(vector.dimensions()))
+		, quantization_{parameters} {
+			for (auto i = 0; i < vector.dimensions(); ++i) {
+				auto& element = elements_[static_cast<std::size_t>(i)];
+				if constexpr (std::same_as<T, std::int8_t>) {
+					element = quantise(vector[i]);
+					element_sum_ += element;
+				}
+				else {
+					element = T(vector[i]);
+				}
+			}
+		}
+
+		static auto default_quantization(euclidean_vector_view vector) noexcept
+		   -> comp6771::quantization {
+			if constexpr (std::same_as<T, std::int8_t>) {
+				return comp6771::quantization::fit(vector);
+			}
+			else {
+				return {};
+			}
+		}
+
+		auto quantise(double magnitude) const noexcept -> std::int8_t {
+			if (std::isnan(magnitude)) {
+				return static_cast<std::int8_t>(quantization_.zero_point);
+			}
+			auto const q = std::nearbyint(magnitude / quantization_.scale) + quantization_.zero_point;
+			return static_cast<std::int8_t>(std::clamp(q, -128.0, 127.0));
+		}
+	};
+
+	using float_euclidean_vector = basic_euclidean_vector<float>;
+	using bfloat16_euclidean_vector = basic_euclidean_vector<bfloat16>;
+	using int8_euclidean_vector = basic_euclidean_vector<std::int8_t>;
+
+	// The dot product of the stored magnitudes, rounded once to double for int8 and otherwise equal
+	// to dot() of the vectors converted to euclidean_vector. Throws std::logic_error if the
+	// dimensions differ.
+	template<compact_element T>
+	auto dot(basic_euclidean_vector<T> const& x, basic_euclidean_vector<T> const& y) -> double {
+		if (x.dimensions() != y.dimensions()) {
+			detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
+		}
+		auto const size = static_cast<std::size_t>(x.dimensions());
+		if constexpr (std::same_as<T, std::int8_t>) {
+			// sum of (qx - zx)(qy - zy), expanded so the kernel only sees the stored int8s
+			auto const zx = std::int64_t{x.zero_point()};
+			auto const zy = std::int64_t{y.zero_point()};
+			auto const n = static_cast<std::int64_t>(size);
+			auto const sum = kernels::dot(x.data(), y.data(), size) - zy * x.element_sum()
+			                 - zx * y.element_sum() + n * zx * zy;
+			return x.scale() * y.scale() * static_cast<double>(sum);
+		}
+		else {
+			return kernels::dot(x.data(), y.data(), size);
+		}
+	}
+
+	// throws std::logic_error if `v` has no dimensions
+	template<compact_element T>
+	auto euclidean_norm(basic_euclidean_vector<T> const& v) -> double {
+		if (v.dimensions() == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		return std::sqrt(dot(v, v));
+	}
+} // namespace comp6771
+
+#endif // COMP6771_BASIC_EUCLIDEAN_VECTOR_HPP
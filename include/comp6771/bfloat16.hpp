@@ -0,0 +1,73 @@
+#ifndef COMP6771_BFLOAT16_HPP
+#define COMP6771_BFLOAT16_HPP
+
+#include <bit>
+#include <cstdint>
+
+namespace comp6771 {
+	// The upper 16 bits of an IEEE float: float's range with 8 significant bits. Conversions from
+	// float and double round to nearest, ties to even, and conversion to float is exact.
+	class bfloat16 {
+	public:
+		constexpr bfloat16() noexcept = default;
+
+		explicit constexpr bfloat16(float value) noexcept
+		: bits_(round(value)) {}
+
+		// Rounding to float first and then to bfloat16 could round twice. Rounding to float with
+		// round-to-odd instead keeps enough information for the second rounding to be correct.
+		explicit constexpr bfloat16(double value) noexcept
+		: bits_(round(round_to_odd(value))) {}
+
+		explicit constexpr operator float() const noexcept {
+			return std::bit_cast<float>(static_cast<std::uint32_t>(bits_) << 16U);
+		}
+
+		[[nodiscard]] constexpr auto bits() const noexcept -> std::uint16_t {
+			return bits_;
+		}
+
+		[[nodiscard]] static constexpr auto from_bits(std::uint16_t bits) noexcept -> bfloat16 {
+			auto result = bfloat16();
+			result.bits_ = bits;
+			return result;
+		}
+
+		// compares values, like float: NaN is unequal to everything and -0 equals 0
+		friend constexpr auto operator==(bfloat16 x, bfloat16 y) noexcept -> bool {
+			return static_cast<float>(x) == static_cast<float>(y);
+		}
+
+	private:
+		std::uint16_t bits_ = 0;
+
+		static constexpr auto round(float value) noexcept -> std::uint16_t {
+			auto const bits = std::bit_cast<std::uint32_t>(value);
+			if ((bits & 0x7fff'ffffU) > 0x7f80'0000U) {
+				// NaNs stay NaNs, quiet ones
+				return static_cast<std::uint16_t>((bits >> 16U) | 0x40U);
+			}
+			auto const rounded = bits + 0x7fffU + ((bits >> 16U) & 1U);
+			return static_cast<std::uint16_t>(rounded >> 16U);
+		}
+
+		static constexpr auto round_to_odd(double value) noexcept -> float {
+			auto const nearest = static_cast<float>(value);
+			// exact, or NaN
+			if (static_cast<double>(nearest) == value or value != value) {
+				return nearest;
+			}
+			auto bits = std::bit_cast<std::uint32_t>(nearest);
+			auto const magnitude = value < 0 ? -value : value;
+			auto const nearest_magnitude = static_cast<double>(nearest < 0 ? -nearest : nearest);
+			// truncate, then mark the result inexact in its last bit
+			if (nearest_magnitude > magnitude) {
+				--bits;
+			}
+			return std::bit_cast<float>(bits | 1U);
+		}
+	};
+	static_assert(sizeof(bfloat16) == 2);
+} // namespace comp6771
+
+#endif // COMP6771_BFLOAT16_HPP
@@ -0,0 +1,143 @@
+#ifndef COMP6771_EUCLIDEAN_MATRIX_HPP
+#define COMP6771_EUCLIDEAN_MATRIX_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+
+// Dense matrices that transform euclidean_vectors: projections, rotations, PCA bases.
+//
+// Every product is computed by cache-blocked, register-tiled SIMD kernels, and every element of
+// the result is the fused multiply-add chain m(i, 0) * x[0] + m(i, 1) * x[1] + ... summed in
+// dimension order, from 0. The result is therefore bitwise identical at every SIMD level, for any
+// thread count, and whether a vector is transformed alone or as part of a batch; it may differ from
+// dot(m[i], x) in the last bits, since dot rounds each product. Operands whose dimensions do not
+// fit throw std::logic_error.
+//
+// The overloads taking a thread_pool share the work across the pool's threads.
+namespace comp6771 {
+	// Stored column by column, so that each column is contiguous and starts on a 64-byte boundary;
+	// rows are strided views.
+	class euclidean_matrix {
+	public:
+		using allocator_type = euclidean_vector::allocator_type;
+
+		// `rows` x `columns` zeroes
+		euclidean_matrix(int rows, int columns, allocator_type const& allocator = {});
+
+		// throws std::logic_error unless every row has the same dimensions
+		euclidean_matrix(std::initializer_list<std::initializer_list<double>> rows);
+
+		// the matrix whose rows are `rows`, which must all have the same dimensions
+		explicit euclidean_matrix(std::span<euclidean_vector const> rows,
+		                          allocator_type const& allocator = {});
+
+		// the matrix whose rows are the vectors of `rows`
+		explicit euclidean_matrix(euclidean_vector_batch const& rows,
+		                          allocator_type const& allocator = {});
+
+		[[nodiscard]] static auto identity(int size) -> euclidean_matrix;
+
+		// row `row`, as a strided view
+		auto operator[](int row) const noexcept -> euclidean_vector_view {
+			return rows_[row];
+		}
+
+		auto operator[](int row) noexcept -> euclidean_vector_ref {
+			return rows_[row];
+		}
+
+		auto operator()(int row, int column) const noexcept -> double {
+			return rows_(row, column);
+		}
+
+		auto operator()(int row, int column) noexcept -> double& {
+			return rows_(row, column);
+		}
+
+		[[nodiscard]] auto column(int column) const noexcept -> euclidean_vector_view {
+			return euclidean_vector_view(data() + column_offset(column), rows_.size());
+		}
+
+		[[nodiscard]] auto column(int column) noexcept -> euclidean_vector_ref {
+			return euclidean_vector_ref(data() + column_offset(column), rows_.size());
+		}
+
+		[[nodiscard]] auto rows() const noexcept -> int {
+			return rows_.size();
+		}
+
+		[[nodiscard]] auto columns() const noexcept -> int {
+			return rows_.dimensions();
+		}
+
+		// distance between the first elements of adjacent columns
+		[[nodiscard]] auto leading_dimension() const noexcept -> std::size_t {
+			return rows_.leading_dimension();
+		}
+
+		[[nodiscard]] auto data() const noexcept -> double const* {
+			return rows_.data();
+		}
+
+		[[nodiscard]] auto data() noexcept -> double* {
+			return rows_.data();
+		}
+
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type {
+			return rows_.get_allocator();
+		}
+
+		[[nodiscard]] auto transpose() const -> euclidean_matrix;
+
+		// the rows, as a row_major batch
+		[[nodiscard]] auto to_batch() const -> euclidean_vector_batch;
+
+	private:
+		// a column_major batch of the rows
+		euclidean_vector_batch rows_;
+
+		[[nodiscard]] auto column_offset(int column) const noexcept -> std::size_t {
+			return static_cast<std::size_t>(column) * rows_.leading_dimension();
+		}
+	};
+
+	// m x, a vector of m.rows() dimensions; x must have m.columns()
+	[[nodiscard]] auto transform(euclidean_matrix const& m, euclidean_vector_view x)
+	   -> euclidean_vector;
+	[[nodiscard]] auto
+	transform(euclidean_matrix const& m, euclidean_vector_view x, thread_pool& pool)
+	   -> euclidean_vector;
+
+	// transform(m, vectors[i]) for every vector, as a batch in the same layout as `vectors`
+	[[nodiscard]] auto transform(euclidean_matrix const& m, euclidean_vector_batch const& vectors)
+	   -> euclidean_vector_batch;
+	[[nodiscard]] auto
+	transform(euclidean_matrix const& m, euclidean_vector_batch const& vectors, thread_pool& pool)
+	   -> euclidean_vector_batch;
+
+	// As above, but into `result`, reusing its storage. Throws std::logic_error unless `result` is
+	// row_major with m.rows() dimensions and a row for each vector, or if it is `vectors` itself.
+	// A column_major `vectors` is copied to row_major first.
+	auto transform(euclidean_matrix const& m,
+	               euclidean_vector_batch const& vectors,
+	               euclidean_vector_batch& result) -> void;
+	auto transform(euclidean_matrix const& m,
+	               euclidean_vector_batch const& vectors,
+	               euclidean_vector_batch& result,
+	               thread_pool& pool) -> void;
+
+	// the product a b; a.columns() must equal b.rows()
+	[[nodiscard]] auto multiply(euclidean_matrix const& a, euclidean_matrix const& b)
+	   -> euclidean_matrix;
+	[[nodiscard]] auto
+	multiply(euclidean_matrix const& a, euclidean_matrix const& b, thread_pool& pool)
+	   -> euclidean_matrix;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_MATRIX_HPP
@@ -1,17 +1,31 @@
 #ifndef COMP6771_EUCLIDEAN_VECTOR_HPP
 #define COMP6771_EUCLIDEAN_VECTOR_HPP
 
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/instrumentation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <ostream>
 #include <range/v3/algorithm.hpp>
 #include <range/v3/iterator.hpp>
+#include <ranges>
 #include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace comp6771 {
@@ -21,8 +35,94 @@ namespace comp6771 {
 		: std::runtime_error(what) {}
 	};
 
+	class euclidean_vector;
+
+	using kernels::accumulation;
+
+	namespace detail {
+		// throws the std::logic_error reported when two operands' dimensions differ
+		[[noreturn]] auto throw_dimension_mismatch(int lhs, int rhs) -> void;
+		// throws the std::logic_error reported when a vector with `dimensions` and a zero norm,
+		// or with no dimensions, has no unit vector
+		[[noreturn]] auto throw_no_unit_vector(int dimensions) -> void;
+
+		// heap magnitudes are aligned for the widest SIMD kernel
+		inline constexpr auto magnitude_alignment = std::size_t{64};
+
+		// returns heap magnitudes to the memory resource they were allocated from
+		struct magnitude_deleter {
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+			std::size_t capacity = 0;
+
+			auto operator()(double* magnitudes) const noexcept -> void {
+				resource->deallocate(magnitudes, capacity * sizeof(double), magnitude_alignment);
+			}
+		};
+	} // namespace detail
+
+	// Base of the lazy nodes built by operator+, operator-, operator* and operator/. A node is only
+	// evaluated when it is converted or assigned to a euclidean_vector, which happens in one pass.
+	struct vector_expression_base {};
+
+	template<typename T>
+	concept vector_expression = std::derived_from<std::remove_cvref_t<T>, vector_expression_base>;
+
+	template<typename T>
+	concept vector_operand =
+	   std::same_as<std::remove_cvref_t<T>, euclidean_vector> or vector_expression<T>;
+
+	// Process-wide counts of how euclidean_vector's norm cache has been used. Each thread counts
+	// into its own counters, so keeping count costs no synchronisation.
+	struct norm_cache_statistics {
+		// norms that were read from the cache
+		std::uint64_t hits = 0;
+		// norms that had to be computed
+		std::uint64_t misses = 0;
+		// rescalings that kept a cached norm instead of discarding it
+		std::uint64_t updates = 0;
+	};
+
+	namespace detail {
+		// Non-owning views are expression leaves too, but copying one into a euclidean_vector
+		// allocates, so that conversion is explicit. Specialised by euclidean_vector_view.hpp.
+		template<typename T>
+		inline constexpr auto is_vector_view = false;
+
+		// Whether an expression owns a temporary euclidean_vector whose storage the result of the
+		// expression can take over. Specialised for vector_value and for every node below.
+		template<typename T>
+		inline constexpr auto owns_operand = false;
+
+		// a callable that makes a magnitude from its index, or from nothing
+		template<typename F>
+		concept magnitude_generator =
+		   (std::invocable<F&, int> and std::convertible_to<std::invoke_result_t<F&, int>, double>)
+		   or (std::invocable<F&> and std::convertible_to<std::invoke_result_t<F&>, double>);
+
+		template<typename R>
+		concept magnitude_range = std::ranges::input_range<R>
+		                          and std::convertible_to<std::ranges::range_reference_t<R>, double>;
+	} // namespace detail
+
+	// Selects the euclidean_vector constructor that leaves the magnitudes uninitialised, for
+	// buffers that are about to be overwritten.
+	struct uninitialized_t {
+		explicit uninitialized_t() = default;
+	};
+	inline constexpr auto uninitialized = uninitialized_t();
+
+	class vector_value;
+
 	class euclidean_vector {
 	public:
+		// vectors with at most this many dimensions keep their magnitudes inline, without allocating
+		static constexpr auto inline_capacity = 4;
+
+		// Larger vectors allocate their magnitudes from the allocator's memory resource, which is
+		// std::pmr::get_default_resource() unless one is passed in. Copies use the default resource;
+		// assignment keeps the destination's resource.
+		using allocator_type = std::pmr::polymorphic_allocator<double>;
+
 		// default constructor
 		euclidean_vector() noexcept;
 
@@ -30,6 +130,28 @@ namespace comp6771 {
 
 		euclidean_vector(int dim, double mag) noexcept;
 
+		euclidean_vector(int dim, allocator_type const& allocator) noexcept;
+
+		euclidean_vector(int dim, double mag, allocator_type const& allocator) noexcept;
+
+		// `dim` magnitudes that must be written before they are read
+		euclidean_vector(uninitialized_t,
+		                 int dim,
+		                 allocator_type const& allocator = allocator_type()) noexcept;
+
+		// magnitude i is generator(i), or generator() for a generator that takes no index, called
+		// in order of i
+		template<detail::magnitude_generator Generator>
+		euclidean_vector(int dim,
+		                 Generator generator,
+		                 allocator_type const& allocator = allocator_type());
+
+		// One magnitude per element of `range`, written once. Input ranges that are neither sized
+		// nor forward are buffered first, since their size is only known once they are read.
+		template<detail::magnitude_range Range>
+		explicit euclidean_vector(Range&& range, // NOLINT(bugprone-forwarding-reference-overload)
+		                          allocator_type const& allocator = allocator_type());
+
 		// takes start and end of an iterator and works out req dimensions
 		// and sets magnitude in each dimension according to iterated values
 		euclidean_vector(std::vector<double>::const_iterator start,
@@ -40,24 +162,96 @@ namespace comp6771 {
 
 		euclidean_vector(euclidean_vector const& copy) noexcept;
 
+		euclidean_vector(euclidean_vector const& copy, allocator_type const& allocator) noexcept;
+
 		euclidean_vector(euclidean_vector&& from) noexcept;
+
+		// evaluates an arithmetic expression with a single allocation and a single pass
+		template<vector_expression Expression>
+		explicit(detail::is_vector_view<Expression>) euclidean_vector(Expression const& expression);
+		// evaluates into the storage of a temporary the expression owns, without allocating
+		template<vector_expression Expression>
+		requires detail::owns_operand<Expression>
+		euclidean_vector(Expression&& expression); // NOLINT(bugprone-forwarding-reference-overload)
 		// // destructor or DESTROYER
 		~euclidean_vector() noexcept;
 
 	private:
-		int dimension_;
 		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		std::unique_ptr<double[]> magnitude_;
-		mutable double mag_cache_;
+		using magnitude_pointer = std::unique_ptr<double[], detail::magnitude_deleter>;
+
+		// marks an empty norm cache; a sum of squares is never negative
+		static constexpr auto no_cached_norm = -1.0;
+
+		int dimension_;
+		// null while the magnitudes fit in inline_magnitude_; the deleter always knows the resource
+		magnitude_pointer magnitude_;
+		// The sum of squares of the magnitudes, or no_cached_norm. Threads that read the norm of a
+		// shared vector may fill it in concurrently; they all compute the same value.
+		mutable std::atomic<double> squared_norm_cache_ = no_cached_norm;
+		std::array<double, inline_capacity> inline_magnitude_;
+
+		// allocates uninitialised magnitudes, or nothing if they fit inline
+		static auto allocate_magnitude(int dimensions, std::pmr::memory_resource* resource)
+		   -> magnitude_pointer {
+			if (dimensions <= inline_capacity) {
+				return magnitude_pointer(nullptr, detail::magnitude_deleter{resource, 0});
+			}
+			auto const capacity = static_cast<std::size_t>(dimensions);
+			COMP6771_COUNT(allocation, 1);
+			COMP6771_COUNT(allocated_bytes, capacity * sizeof(double));
+			auto* const magnitudes = static_cast<double*>(
+			   resource->allocate(capacity * sizeof(double), detail::magnitude_alignment));
+			return magnitude_pointer(magnitudes, detail::magnitude_deleter{resource, capacity});
+		}
+
+		// Makes room for `dimensions` magnitudes from this vector's own resource, reusing the
+		// current buffer when it is large enough. The magnitudes are left uninitialised.
+		auto prepare_storage(int dimensions) -> void {
+			auto const needed = static_cast<std::size_t>(dimensions);
+			auto const fits = magnitude_ != nullptr and magnitude_.get_deleter().capacity >= needed;
+			if (dimensions > inline_capacity and not fits) {
+				magnitude_ = allocate_magnitude(dimensions, magnitude_.get_deleter().resource);
+			}
+			dimension_ = dimensions;
+		}
+
+		[[nodiscard]] auto storage() noexcept -> double* {
+			return magnitude_ != nullptr ? magnitude_.get() : inline_magnitude_.data();
+		}
+
+		[[nodiscard]] auto cached_squared_norm() const noexcept -> double {
+			return squared_norm_cache_.load(std::memory_order_relaxed);
+		}
+
+		auto copy_norm_cache(euclidean_vector const& source) noexcept -> void {
+			squared_norm_cache_.store(source.cached_squared_norm(), std::memory_order_relaxed);
+		}
+
+		auto invalidate_norm() noexcept -> void {
+			squared_norm_cache_.store(no_cached_norm, std::memory_order_relaxed);
+		}
+
+		// Keeps a cached sum of squares across multiplying every magnitude by `factor` if it can be
+		// rescaled exactly, so the norm does not depend on how the magnitudes were reached, and
+		// discards it otherwise.
+		auto rescale_norm(double factor) noexcept -> void;
 
 	public:
 		// operator overloading
 		auto operator=(euclidean_vector const&) noexcept -> euclidean_vector&;
 		auto operator=(euclidean_vector&&) noexcept -> euclidean_vector&;
+		template<vector_expression Expression>
+		auto operator=(Expression const& expression) -> euclidean_vector&;
+		template<vector_expression Expression>
+		requires detail::owns_operand<Expression>
+		auto operator=(Expression&& expression) -> euclidean_vector&;
 		auto operator[](int i) const noexcept -> double;
 		auto operator[](int i) noexcept -> double&;
 		auto operator+() const noexcept -> euclidean_vector;
-		auto operator-() noexcept -> euclidean_vector;
+		auto operator-() const& noexcept -> euclidean_vector;
+		// negates a temporary in place
+		auto operator-() && noexcept -> euclidean_vector;
 		auto operator+=(euclidean_vector const& vector) -> euclidean_vector&;
 		auto operator-=(euclidean_vector const& vector) -> euclidean_vector&;
 		auto operator*=(double const& mult) noexcept -> euclidean_vector&;
@@ -68,27 +262,532 @@ namespace comp6771 {
 		// member functions
 		[[nodiscard]] auto at(int const& dimension) const -> double;
 		auto at(int const& dimension) -> double&;
+		// Scales this vector to unit length in place, keeping its storage. Throws like unit().
+		auto normalize() -> euclidean_vector&;
+		// unit(*this); a temporary is normalised in place instead of being copied
+		[[nodiscard]] auto normalized() const& -> euclidean_vector;
+		[[nodiscard]] auto normalized() && -> euclidean_vector;
 
 		[[nodiscard]] auto dimensions() const noexcept -> int;
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type {
+			return allocator_type(magnitude_.get_deleter().resource);
+		}
+		[[nodiscard]] auto data() const noexcept -> double const* {
+			return magnitude_ != nullptr ? magnitude_.get() : inline_magnitude_.data();
+		}
 
 		[[nodiscard]] auto calculate_norm() const noexcept -> double;
-		[[nodiscard]] auto calculate_unit(double& norm) const noexcept -> std::vector<double>;
 		auto calculate_dot(euclidean_vector const& y) const -> double;
+		// dot product with y; both norms are read from or stored in the caches
+		auto calculate_dot_and_norms(euclidean_vector const& y, double& x_norm, double& y_norm) const
+		   -> double;
+		auto calculate_squared_distance(euclidean_vector const& y) const -> double;
+
+		[[nodiscard]] static auto cache_statistics() noexcept -> norm_cache_statistics;
+		static auto reset_cache_statistics() noexcept -> void;
 		// friends
 		friend auto operator==(euclidean_vector const&, euclidean_vector const&) noexcept -> bool;
 		friend auto operator!=(euclidean_vector const&, euclidean_vector const&) noexcept -> bool;
-		friend auto operator+(euclidean_vector const&, euclidean_vector const&) -> euclidean_vector;
-		friend auto operator-(euclidean_vector const&, euclidean_vector const&) -> euclidean_vector;
-		friend auto operator*(euclidean_vector const&, double) noexcept -> euclidean_vector;
-		friend auto operator*(double, euclidean_vector const&) noexcept -> euclidean_vector;
-		friend auto operator/(euclidean_vector const&, double) -> euclidean_vector;
 		friend auto operator<<(std::ostream& os, euclidean_vector const& vector) noexcept
 		   -> std::ostream&;
+		friend auto axpy(double alpha, euclidean_vector const& x, euclidean_vector& y) -> void;
+		friend class vector_value;
+	};
+
+	// Also declared here so that argument-dependent lookup finds them for expression nodes.
+	auto operator==(euclidean_vector const&, euclidean_vector const&) noexcept -> bool;
+	auto operator!=(euclidean_vector const&, euclidean_vector const&) noexcept -> bool;
+	auto operator<<(std::ostream& os, euclidean_vector const& vector) noexcept -> std::ostream&;
+	auto axpy(double alpha, euclidean_vector const& x, euclidean_vector& y) -> void;
+
+	// leaf node referring to a named euclidean_vector
+	class vector_reference : public vector_expression_base {
+	public:
+		explicit vector_reference(euclidean_vector const& vector) noexcept
+		: data_{vector.data()}
+		, dimension_{vector.dimensions()} {}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		auto operator[](std::size_t i) const noexcept -> double {
+			return data_[i];
+		}
+
+		[[nodiscard]] auto data() const noexcept -> double const* {
+			return data_;
+		}
+
+		[[nodiscard]] auto is_contiguous() const noexcept -> bool {
+			return true;
+		}
+
+	private:
+		double const* data_;
+		int dimension_;
+	};
+
+	// leaf node that takes ownership of a temporary euclidean_vector, so that an expression stored
+	// in an `auto` variable never dangles
+	class vector_value : public vector_expression_base {
+	public:
+		explicit vector_value(euclidean_vector&& vector) noexcept
+		: vector_{std::move(vector)} {}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return vector_.dimensions();
+		}
+
+		auto operator[](std::size_t i) const noexcept -> double {
+			return vector_.data()[i];
+		}
+
+		[[nodiscard]] auto data() const noexcept -> double const* {
+			return vector_.data();
+		}
+
+		[[nodiscard]] auto is_contiguous() const noexcept -> bool {
+			return true;
+		}
+
+		// the operand whose storage a result can take over
+		auto owned_value() noexcept -> vector_value* {
+			return this;
+		}
+
+		// Evaluates `expression`, which owns this operand, into this operand's storage and hands
+		// that storage over. Each element only depends on the same element of every operand, so
+		// overwriting an operand while it is read is safe.
+		template<vector_expression Expression>
+		auto evaluate_in_place(Expression const& expression) noexcept -> euclidean_vector&& {
+			COMP6771_INSTRUMENT(evaluate,
+			                    static_cast<std::size_t>(vector_.dimension_) * sizeof(double));
+			expression.evaluate(vector_.storage());
+			vector_.invalidate_norm();
+			return std::move(vector_);
+		}
+
+	private:
+		euclidean_vector vector_;
+	};
+
+	namespace detail {
+		template<>
+		inline constexpr auto owns_operand<vector_value> = true;
+	} // namespace detail
+
+	namespace detail {
+		// Leaves expose their storage, so a node whose operands are all contiguous leaves runs a SIMD
+		// kernel instead of the generic fused loop.
+		template<typename T>
+		concept contiguous_operand = requires(T const& t) {
+			{ t.data() } -> std::convertible_to<double const*>;
+			{ t.is_contiguous() } -> std::same_as<bool>;
+		};
+
+		inline auto apply_kernel(std::plus<>,
+		                         double* out,
+		                         double const* x,
+		                         double const* y,
+		                         std::size_t size) noexcept -> void {
+			kernels::add(out, x, y, size);
+		}
+
+		inline auto apply_kernel(std::minus<>,
+		                         double* out,
+		                         double const* x,
+		                         double const* y,
+		                         std::size_t size) noexcept -> void {
+			kernels::subtract(out, x, y, size);
+		}
+
+		inline auto apply_kernel(std::multiplies<>,
+		                         double* out,
+		                         double const* x,
+		                         double s,
+		                         std::size_t size) noexcept -> void {
+			kernels::multiply(out, x, s, size);
+		}
+
+		inline auto apply_kernel(std::divides<>,
+		                         double* out,
+		                         double const* x,
+		                         double s,
+		                         std::size_t size) noexcept -> void {
+			kernels::divide(out, x, s, size);
+		}
+
+		// a + t * (b - a), or exactly b when t is 1
+		struct lerp_operation {
+			auto operator()(double a, double b, double t) const noexcept -> double {
+				return t == 1 ? b : a + t * (b - a);
+			}
+		};
+
+		// alpha * x + y, rounded once
+		struct fused_scale_add_operation {
+			auto operator()(double x, double y, double alpha) const noexcept -> double {
+				return std::fma(alpha, x, y);
+			}
+		};
+
+		inline auto apply_kernel(lerp_operation,
+		                         double* out,
+		                         double const* x,
+		                         double const* y,
+		                         double s,
+		                         std::size_t size) noexcept -> void {
+			kernels::lerp(out, x, y, s, size);
+		}
+
+		inline auto apply_kernel(fused_scale_add_operation,
+		                         double* out,
+		                         double const* x,
+		                         double const* y,
+		                         double s,
+		                         std::size_t size) noexcept -> void {
+			kernels::fused_scale_add(out, s, x, y, size);
+		}
+	} // namespace detail
+
+	template<typename Operation, typename Lhs, typename Rhs>
+	class binary_expression : public vector_expression_base {
+	public:
+		binary_expression(Lhs lhs, Rhs rhs)
+		: lhs_{std::move(lhs)}
+		, rhs_{std::move(rhs)} {
+			if (lhs_.dimensions() != rhs_.dimensions()) {
+				detail::throw_dimension_mismatch(lhs_.dimensions(), rhs_.dimensions());
+			}
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return lhs_.dimensions();
+		}
+
+		auto operator[](std::size_t i) const noexcept -> double {
+			return Operation{}(lhs_[i], rhs_[i]);
+		}
+
+		auto evaluate(double* out) const noexcept -> void {
+			auto const size = static_cast<std::size_t>(dimensions());
+			if constexpr (detail::contiguous_operand<Lhs> and detail::contiguous_operand<Rhs>) {
+				if (lhs_.is_contiguous() and rhs_.is_contiguous()) {
+					detail::apply_kernel(Operation{}, out, lhs_.data(), rhs_.data(), size);
+					return;
+				}
+			}
+			for (auto i = std::size_t{0}; i < size; ++i) {
+				out[i] = (*this)[i];
+			}
+		}
+
+		auto owned_value() noexcept -> vector_value*
+		requires(detail::owns_operand<Lhs> or detail::owns_operand<Rhs>)
+		{
+			if constexpr (detail::owns_operand<Lhs>) {
+				return lhs_.owned_value();
+			}
+			else {
+				return rhs_.owned_value();
+			}
+		}
+
+	private:
+		Lhs lhs_;
+		Rhs rhs_;
+	};
+
+	namespace detail {
+		template<typename Operation, typename Lhs, typename Rhs>
+		inline constexpr auto owns_operand<binary_expression<Operation, Lhs, Rhs>> =
+		   owns_operand<Lhs> or owns_operand<Rhs>;
+	} // namespace detail
+
+	template<typename Operation, typename Operand>
+	class scalar_expression : public vector_expression_base {
+	public:
+		scalar_expression(Operand operand, double scalar) noexcept
+		: operand_{std::move(operand)}
+		, scalar_{scalar} {}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return operand_.dimensions();
+		}
+
+		auto operator[](std::size_t i) const noexcept -> double {
+			return Operation{}(operand_[i], scalar_);
+		}
+
+		auto evaluate(double* out) const noexcept -> void {
+			auto const size = static_cast<std::size_t>(dimensions());
+			if constexpr (detail::contiguous_operand<Operand>) {
+				if (operand_.is_contiguous()) {
+					detail::apply_kernel(Operation{}, out, operand_.data(), scalar_, size);
+					return;
+				}
+			}
+			for (auto i = std::size_t{0}; i < size; ++i) {
+				out[i] = (*this)[i];
+			}
+		}
+
+		auto owned_value() noexcept -> vector_value* requires detail::owns_operand<Operand> {
+			return operand_.owned_value();
+		}
+
+	private:
+		Operand operand_;
+		double scalar_;
 	};
 
+	namespace detail {
+		template<typename Operation, typename Operand>
+		inline constexpr auto owns_operand<scalar_expression<Operation, Operand>> =
+		   owns_operand<Operand>;
+	} // namespace detail
+
+	// node for an operation on the same element of two operands and a scalar
+	template<typename Operation, typename Lhs, typename Rhs>
+	class fused_expression : public vector_expression_base {
+	public:
+		fused_expression(Lhs lhs, Rhs rhs, double scalar)
+		: lhs_{std::move(lhs)}
+		, rhs_{std::move(rhs)}
+		, scalar_{scalar} {
+			if (lhs_.dimensions() != rhs_.dimensions()) {
+				detail::throw_dimension_mismatch(lhs_.dimensions(), rhs_.dimensions());
+			}
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return lhs_.dimensions();
+		}
+
+		auto operator[](std::size_t i) const noexcept -> double {
+			return Operation{}(lhs_[i], rhs_[i], scalar_);
+		}
+
+		auto evaluate(double* out) const noexcept -> void {
+			auto const size = static_cast<std::size_t>(dimensions());
+			if constexpr (detail::contiguous_operand<Lhs> and detail::contiguous_operand<Rhs>) {
+				if (lhs_.is_contiguous() and rhs_.is_contiguous()) {
+					detail::apply_kernel(Operation{}, out, lhs_.data(), rhs_.data(), scalar_, size);
+					return;
+				}
+			}
+			for (auto i = std::size_t{0}; i < size; ++i) {
+				out[i] = (*this)[i];
+			}
+		}
+
+		auto owned_value() noexcept -> vector_value*
+		requires(detail::owns_operand<Lhs> or detail::owns_operand<Rhs>)
+		{
+			if constexpr (detail::owns_operand<Lhs>) {
+				return lhs_.owned_value();
+			}
+			else {
+				return rhs_.owned_value();
+			}
+		}
+
+	private:
+		Lhs lhs_;
+		Rhs rhs_;
+		double scalar_;
+	};
+
+	namespace detail {
+		template<typename Operation, typename Lhs, typename Rhs>
+		inline constexpr auto owns_operand<fused_expression<Operation, Lhs, Rhs>> =
+		   owns_operand<Lhs> or owns_operand<Rhs>;
+
+		template<vector_operand T>
+		auto as_operand(T&& operand) {
+			if constexpr (vector_expression<T>) {
+				return std::remove_cvref_t<T>(std::forward<T>(operand));
+			}
+			else if constexpr (std::is_lvalue_reference_v<T>) {
+				return vector_reference(operand);
+			}
+			else {
+				return vector_value(euclidean_vector(std::forward<T>(operand)));
+			}
+		}
+
+		template<typename T>
+		using operand_t = decltype(as_operand(std::declval<T>()));
+	} // namespace detail
+
+	template<vector_operand Lhs, vector_operand Rhs>
+	auto operator+(Lhs&& lhs, Rhs&& rhs)
+	   -> binary_expression<std::plus<>, detail::operand_t<Lhs>, detail::operand_t<Rhs>> {
+		return {detail::as_operand(std::forward<Lhs>(lhs)),
+		        detail::as_operand(std::forward<Rhs>(rhs))};
+	}
+
+	template<vector_operand Lhs, vector_operand Rhs>
+	auto operator-(Lhs&& lhs, Rhs&& rhs)
+	   -> binary_expression<std::minus<>, detail::operand_t<Lhs>, detail::operand_t<Rhs>> {
+		return {detail::as_operand(std::forward<Lhs>(lhs)),
+		        detail::as_operand(std::forward<Rhs>(rhs))};
+	}
+
+	template<vector_operand Operand>
+	auto operator*(Operand&& operand, double multiplier) noexcept
+	   -> scalar_expression<std::multiplies<>, detail::operand_t<Operand>> {
+		return {detail::as_operand(std::forward<Operand>(operand)), multiplier};
+	}
+
+	template<vector_operand Operand>
+	auto operator*(double multiplier, Operand&& operand) noexcept
+	   -> scalar_expression<std::multiplies<>, detail::operand_t<Operand>> {
+		return {detail::as_operand(std::forward<Operand>(operand)), multiplier};
+	}
+
+	template<vector_operand Operand>
+	auto operator/(Operand&& operand, double divisor)
+	   -> scalar_expression<std::divides<>, detail::operand_t<Operand>> {
+		if (divisor == 0) {
+			throw std::logic_error("Invalid vector division by 0");
+		}
+		return {detail::as_operand(std::forward<Operand>(operand)), divisor};
+	}
+
+	// a + t * (b - a) in every dimension, exactly b when t is 1
+	template<vector_operand Lhs, vector_operand Rhs>
+	auto lerp(Lhs&& a, Rhs&& b, double t)
+	   -> fused_expression<detail::lerp_operation, detail::operand_t<Lhs>, detail::operand_t<Rhs>> {
+		return {detail::as_operand(std::forward<Lhs>(a)),
+		        detail::as_operand(std::forward<Rhs>(b)),
+		        t};
+	}
+
+	// alpha * x + y in every dimension, each rounded once with a fused multiply-add
+	template<vector_operand X, vector_operand Y>
+	auto scale_add(double alpha, X&& x, Y&& y)
+	   -> fused_expression<detail::fused_scale_add_operation,
+	                       detail::operand_t<X>,
+	                       detail::operand_t<Y>> {
+		return {detail::as_operand(std::forward<X>(x)),
+		        detail::as_operand(std::forward<Y>(y)),
+		        alpha};
+	}
+
+	template<detail::magnitude_generator Generator>
+	euclidean_vector::euclidean_vector(int dim, Generator generator, allocator_type const& allocator)
+	: euclidean_vector(uninitialized, dim, allocator) {
+		auto* const magnitudes = storage();
+		for (auto i = 0; i < dim; ++i) {
+			if constexpr (std::invocable<Generator&, int>) {
+				magnitudes[i] = static_cast<double>(std::invoke(generator, i));
+			}
+			else {
+				magnitudes[i] = static_cast<double>(std::invoke(generator));
+			}
+		}
+	}
+
+	template<detail::magnitude_range Range>
+	euclidean_vector::euclidean_vector(Range&& range, allocator_type const& allocator)
+	: euclidean_vector(uninitialized, 0, allocator) {
+		if constexpr (std::ranges::sized_range<Range> or std::ranges::forward_range<Range>) {
+			prepare_storage(static_cast<int>(std::ranges::distance(range)));
+			std::ranges::copy(range, storage());
+		}
+		else {
+			auto buffer = std::vector<double>();
+			for (auto&& magnitude : range) {
+				buffer.push_back(static_cast<double>(magnitude));
+			}
+			prepare_storage(static_cast<int>(buffer.size()));
+			std::ranges::copy(buffer, storage());
+		}
+	}
+
+	template<vector_expression Expression>
+	euclidean_vector::euclidean_vector(Expression const& expression)
+	: dimension_{expression.dimensions()}
+	, magnitude_{allocate_magnitude(dimension_, std::pmr::get_default_resource())}
+	, squared_norm_cache_{no_cached_norm} {
+		COMP6771_INSTRUMENT(evaluate, static_cast<std::size_t>(dimension_) * sizeof(double));
+		expression.evaluate(storage());
+	}
+
+	template<vector_expression Expression>
+	auto euclidean_vector::operator=(Expression const& expression) -> euclidean_vector& {
+		// An expression that refers to *this has the same dimensions as *this, so storage is only
+		// replaced when the expression cannot be reading from it. Each element only depends on the
+		// same element of every operand, so evaluating in place is safe otherwise.
+		COMP6771_INSTRUMENT(evaluate,
+		                    static_cast<std::size_t>(expression.dimensions()) * sizeof(double));
+		if (dimension_ != expression.dimensions()) {
+			prepare_storage(expression.dimensions());
+		}
+		expression.evaluate(storage());
+		invalidate_norm();
+		return *this;
+	}
+
+	template<vector_expression Expression>
+	requires detail::owns_operand<Expression>
+	euclidean_vector::euclidean_vector(Expression&& expression)
+	: euclidean_vector(expression.owned_value()->evaluate_in_place(expression)) {}
+
+	template<vector_expression Expression>
+	requires detail::owns_operand<Expression>
+	auto euclidean_vector::operator=(Expression&& expression) -> euclidean_vector& {
+		if (dimension_ == expression.dimensions()) {
+			return *this = std::as_const(expression);
+		}
+		// storage of the wrong size is replaced by the temporary's rather than by a new allocation
+		return *this = euclidean_vector(std::move(expression));
+	}
+
 	auto euclidean_norm(euclidean_vector const& v) -> double;
+	// v multiplied by the reciprocal of its norm, in one pass into one allocation
 	auto unit(euclidean_vector const& v) -> euclidean_vector;
 	auto dot(euclidean_vector const& x, euclidean_vector const& y) -> double;
+	// Accumulate with `policy` (see euclidean_vector_kernels.hpp). Only the naive norm is cached;
+	// the others read every magnitude on each call.
+	auto euclidean_norm(euclidean_vector const& v, accumulation policy) -> double;
+	auto dot(euclidean_vector const& x, euclidean_vector const& y, accumulation policy) -> double;
+
+	// Distances and cosine similarity read both operands once, without a temporary.
+	auto squared_distance(euclidean_vector const& x, euclidean_vector const& y) -> double;
+	auto distance(euclidean_vector const& x, euclidean_vector const& y) -> double;
+	// dot(x, y) / (euclidean_norm(x) * euclidean_norm(y)); the dot product and any norm that is not
+	// cached yet are computed in the same pass
+	auto cosine_similarity(euclidean_vector const& x, euclidean_vector const& y) -> double;
+
+	// Whether x and y have the same dimensions and each pair of magnitudes is equal or close, as
+	// kernels::approx_equal defines it. Like Python's math.isclose, the defaults allow a relative
+	// error of 1e-9 and no absolute error, so only 0 is close to 0.
+	[[nodiscard]] auto approx_equal(euclidean_vector const& x,
+	                                euclidean_vector const& y,
+	                                double absolute_tolerance = 0.0,
+	                                double relative_tolerance = 1e-9) noexcept -> bool;
+	// the largest kernels::ulp_distance between a pair of magnitudes; throws std::logic_error if
+	// the dimensions differ
+	[[nodiscard]] auto ulp_distance(euclidean_vector const& x, euclidean_vector const& y)
+	   -> std::uint64_t;
+	// whether x and y have the same dimensions and ulp_distance(x, y) <= max_ulps
+	[[nodiscard]] auto
+	ulp_equal(euclidean_vector const& x, euclidean_vector const& y, std::uint64_t max_ulps) noexcept
+	   -> bool;
+	// A 64-bit hash of the magnitudes (see kernels::hash): vectors that compare equal hash equally,
+	// whatever their memory resources.
+	[[nodiscard]] auto hash_value(euclidean_vector const& v, std::uint64_t seed = 0) noexcept
+	   -> std::uint64_t;
 
 } // namespace comp6771
+
+template<>
+struct std::hash<comp6771::euclidean_vector> {
+	auto operator()(comp6771::euclidean_vector const& v) const noexcept -> std::size_t {
+		return static_cast<std::size_t>(comp6771::hash_value(v));
+	}
+};
 #endif // COMP6771_EUCLIDEAN_VECTOR_HPP
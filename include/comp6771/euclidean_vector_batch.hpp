@@ -0,0 +1,160 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_BATCH_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_BATCH_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	enum class batch_layout {
+		// each vector's magnitudes are adjacent (array of structures)
+		row_major,
+		// each dimension's magnitudes are adjacent (structure of arrays)
+		column_major,
+	};
+
+	// A fixed number of vectors with the same dimensions, stored in one slab from a memory
+	// resource instead of one heap block per vector. Every row (column_major: every column) starts
+	// on a 64-byte boundary; the padding between them is never read.
+	class euclidean_vector_batch {
+	public:
+		using allocator_type = euclidean_vector::allocator_type;
+
+		// `size` vectors of `dimensions` zeroes
+		euclidean_vector_batch(int size,
+		                       int dimensions,
+		                       batch_layout layout = batch_layout::row_major,
+		                       allocator_type const& allocator = {});
+
+		// copies `vectors`, which must all have the same dimensions
+		explicit euclidean_vector_batch(std::span<euclidean_vector const> vectors,
+		                                batch_layout layout = batch_layout::row_major,
+		                                allocator_type const& allocator = {});
+
+		euclidean_vector_batch(euclidean_vector_batch const& other);
+
+		euclidean_vector_batch(euclidean_vector_batch const& other, allocator_type const& allocator);
+
+		euclidean_vector_batch(euclidean_vector_batch&& other) noexcept;
+
+		~euclidean_vector_batch() = default;
+
+		auto operator=(euclidean_vector_batch const& other) -> euclidean_vector_batch&;
+		auto operator=(euclidean_vector_batch&& other) -> euclidean_vector_batch&;
+
+		// the vector in row `row`
+		auto operator[](int row) const noexcept -> euclidean_vector_view {
+			return euclidean_vector_view(magnitudes_.get() + offset(row, 0), dimension_, step());
+		}
+
+		auto operator[](int row) noexcept -> euclidean_vector_ref {
+			return euclidean_vector_ref(magnitudes_.get() + offset(row, 0), dimension_, step());
+		}
+
+		auto operator()(int row, int dimension) const noexcept -> double {
+			return magnitudes_[offset(row, dimension)];
+		}
+
+		auto operator()(int row, int dimension) noexcept -> double& {
+			return magnitudes_[offset(row, dimension)];
+		}
+
+		[[nodiscard]] auto at(int row) const -> euclidean_vector_view;
+
+		// overwrites row `row` with `vector`
+		auto assign(int row, euclidean_vector_view vector) -> void;
+
+		[[nodiscard]] auto size() const noexcept -> int {
+			return size_;
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		[[nodiscard]] auto layout() const noexcept -> batch_layout {
+			return layout_;
+		}
+
+		// distance between the first elements of adjacent rows (column_major: columns)
+		[[nodiscard]] auto leading_dimension() const noexcept -> std::size_t {
+			return leading_dimension_;
+		}
+
+		[[nodiscard]] auto data() const noexcept -> double const* {
+			return magnitudes_.get();
+		}
+
+		[[nodiscard]] auto data() noexcept -> double* {
+			return magnitudes_.get();
+		}
+
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type {
+			return allocator_type(magnitudes_.get_deleter().resource);
+		}
+
+		// the same vectors in the other layout
+		[[nodiscard]] auto to_layout(batch_layout layout) const -> euclidean_vector_batch;
+
+	private:
+		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
+		using magnitude_pointer = std::unique_ptr<double[], detail::magnitude_deleter>;
+
+		int size_;
+		int dimension_;
+		batch_layout layout_;
+		std::size_t leading_dimension_;
+		magnitude_pointer magnitudes_;
+
+		[[nodiscard]] auto offset(int row, int dimension) const noexcept -> std::size_t {
+			auto const r = static_cast<std::size_t>(row);
+			auto const d = static_cast<std::size_t>(dimension);
+			return layout_ == batch_layout::row_major ? r * leading_dimension_ + d
+			                                          : d * leading_dimension_ + r;
+		}
+
+		// distance between adjacent magnitudes of one vector
+		[[nodiscard]] auto step() const noexcept -> std::ptrdiff_t {
+			return layout_ == batch_layout::row_major
+			          ? 1
+			          : static_cast<std::ptrdiff_t>(leading_dimension_);
+		}
+	};
+
+	// Batch operations run one kernel per row, or for column_major batches one pass per dimension
+	// across every vector. Row-major results are bitwise identical to the single-vector functions;
+	// column_major results sum in dimension order, so they may differ in the last bits.
+
+	// dot(batch[i], query) for every row
+	auto dot(euclidean_vector_batch const& batch, euclidean_vector_view query)
+	   -> std::vector<double>;
+	// euclidean_norm(batch[i]) for every row
+	auto euclidean_norm(euclidean_vector_batch const& batch) -> std::vector<double>;
+	// unit(batch[i]) for every row, in the batch's layout
+	auto unit(euclidean_vector_batch const& batch) -> euclidean_vector_batch;
+	// replaces every row with its unit vector, without allocating a second batch
+	auto normalize(euclidean_vector_batch& batch) -> void;
+	// As above, but only rows [0, rows), leaving the rest as they are. Throws std::out_of_range
+	// unless `rows` is from 0 to batch.size().
+	auto normalize(euclidean_vector_batch& batch, int rows) -> void;
+	// y[i] += alpha * x[i] for every row
+	auto axpy(double alpha, euclidean_vector_batch const& x, euclidean_vector_batch& y) -> void;
+	// squared_distance(batch[i], query) for every row
+	auto squared_distance(euclidean_vector_batch const& batch, euclidean_vector_view query)
+	   -> std::vector<double>;
+	// euclidean_norm(batch[i] - query) for every row
+	auto distance(euclidean_vector_batch const& batch, euclidean_vector_view query)
+	   -> std::vector<double>;
+	// cosine_similarity(batch[i], query) for every row
+	auto cosine_similarity(euclidean_vector_batch const& batch, euclidean_vector_view query)
+	   -> std::vector<double>;
+	// euclidean_norm(x[i] - y[j]) at index i * y.size() + j
+	auto pairwise_distance(euclidean_vector_batch const& x, euclidean_vector_batch const& y)
+	   -> std::vector<double>;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_BATCH_HPP
@@ -0,0 +1,173 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_FILE_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_FILE_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace comp6771 {
+	// A vector file holds vectors with the same dimensions as raw IEEE-754 doubles, so that they
+	// are written and read without formatting or parsing, and without losing precision. The file
+	// starts with a 64-byte header:
+	//
+	//    offset  field
+	//         0  "EVECTORS"
+	//         8  format version, 1 (uint32)
+	//        12  byte order mark, 0x01020304 (uint32)
+	//        16  dimensions (uint32)
+	//        20  row alignment in bytes: a power of two from 8 to 4096 (uint32)
+	//        24  number of vectors, or 2^64 - 1 if the writer could not seek back to record it
+	//            (uint64)
+	//        32  reserved, zero
+	//
+	// Every field and magnitude is in the writer's byte order, which the byte order mark records.
+	// The vectors follow the header, each padded to a multiple of the row alignment; readers skip
+	// the padding. Since the header is 64 bytes long, the vectors of a file that is mapped into
+	// memory start on row alignment boundaries up to 64 bytes, like euclidean_vector_batch rows.
+	inline constexpr auto vector_file_header_size = std::size_t{64};
+
+	// Writes vectors to a binary stream in the format above. The number of vectors is recorded
+	// when the writer finishes, if the stream can seek back to the header.
+	class vector_file_writer {
+	public:
+		// Writes the header for vectors of `dimensions` magnitudes to `out`, which should be opened
+		// in binary mode. Throws std::logic_error if `row_alignment` is not a power of two from 8
+		// to 4096.
+		vector_file_writer(std::ostream& out, int dimensions, std::size_t row_alignment = 8);
+
+		vector_file_writer(vector_file_writer const&) = delete;
+		auto operator=(vector_file_writer const&) -> vector_file_writer& = delete;
+
+		// finishes the file, unless finish() already has, ignoring any error
+		~vector_file_writer();
+
+		// throws std::logic_error if `vector` does not have the file's dimensions
+		auto write(euclidean_vector_view vector) -> void;
+		// writes every row of `batch`; a row_major batch whose rows are padded like the file's is
+		// written in a single call
+		auto write(euclidean_vector_batch const& batch) -> void;
+
+		// Records the number of vectors in the header and flushes the stream. Throws
+		// std::runtime_error if the stream has failed.
+		auto finish() -> void;
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		// the number of vectors written so far
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+
+	private:
+		std::ostream* out_;
+		std::ostream::pos_type header_;
+		int dimension_;
+		std::size_t row_bytes_;
+		std::size_t size_ = 0;
+		bool finished_ = false;
+		std::vector<double> scratch_;
+
+		auto write_row(double const* magnitudes) -> void;
+		auto record_size() -> void;
+	};
+
+	// Reads vectors from a binary stream in the format above, in either byte order.
+	class vector_file_reader {
+	public:
+		// Reads the header from `in`, which should be opened in binary mode. Throws
+		// std::runtime_error if `in` does not start with a valid header, if the header counts more
+		// than INT_MAX vectors, or if `in` can seek and holds fewer vectors than the header counts.
+		explicit vector_file_reader(std::istream& in);
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		// the number of vectors in the file, if its writer recorded it
+		[[nodiscard]] auto size() const noexcept -> std::optional<std::size_t> {
+			return size_;
+		}
+
+		// Reads the next vector into `vector`, reusing its storage when it already has the file's
+		// dimensions. Returns false at the end of the file; throws std::runtime_error if the file
+		// ends part of the way through a vector.
+		auto read(euclidean_vector& vector) -> bool;
+		// as above, but `vector` must have the file's dimensions
+		auto read(euclidean_vector_ref vector) -> bool;
+		// reads every vector that has not been read yet
+		auto read_all(batch_layout layout = batch_layout::row_major) -> euclidean_vector_batch;
+
+	private:
+		std::istream* in_;
+		int dimension_;
+		std::size_t row_bytes_;
+		std::optional<std::size_t> size_;
+		std::size_t read_ = 0;
+		bool swap_bytes_;
+		std::vector<double> scratch_;
+
+		auto read_row(double* magnitudes) -> bool;
+	};
+
+	// A vector file mapped read-only into memory. The vectors are exposed as views of the
+	// mapping, so they are neither copied nor parsed, and the operating system only reads the
+	// pages that are used. Views must not outlive the mapped_vector_file.
+	class mapped_vector_file {
+	public:
+		// Maps the file at `path`. Throws std::system_error if it cannot be opened or mapped, and
+		// std::runtime_error if it is not a valid vector file in this machine's byte order; files
+		// from a machine with the other byte order are read with vector_file_reader instead.
+		explicit mapped_vector_file(std::filesystem::path const& path);
+
+		mapped_vector_file(mapped_vector_file&& other) noexcept;
+		auto operator=(mapped_vector_file&& other) noexcept -> mapped_vector_file&;
+		mapped_vector_file(mapped_vector_file const&) = delete;
+		auto operator=(mapped_vector_file const&) -> mapped_vector_file& = delete;
+		~mapped_vector_file();
+
+		auto operator[](std::size_t i) const noexcept -> euclidean_vector_view {
+			return euclidean_vector_view(magnitudes_ + i * leading_dimension_, dimension_);
+		}
+
+		[[nodiscard]] auto at(std::size_t i) const -> euclidean_vector_view;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		// distance between the first magnitudes of adjacent vectors
+		[[nodiscard]] auto leading_dimension() const noexcept -> std::size_t {
+			return leading_dimension_;
+		}
+
+		[[nodiscard]] auto data() const noexcept -> double const* {
+			return magnitudes_;
+		}
+
+	private:
+		void* mapping_ = nullptr;
+		std::size_t length_ = 0;
+		double const* magnitudes_ = nullptr;
+		std::size_t size_ = 0;
+		int dimension_ = 0;
+		std::size_t leading_dimension_ = 0;
+
+		auto unmap() noexcept -> void;
+	};
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_FILE_HPP
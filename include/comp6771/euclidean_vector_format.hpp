@@ -0,0 +1,120 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_FORMAT_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_FORMAT_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <fmt/format.h>
+#include <string_view>
+
+namespace comp6771 {
+	// Opts a vector into the formatter below, as in fmt::format("{:.3f}", formatted(v)). Vectors
+	// are not formatted by it directly, so fmt::format("{}", v) does not depend on whether a
+	// translation unit includes this header.
+	struct formatted_vector {
+		euclidean_vector_view vector;
+	};
+
+	[[nodiscard]] inline auto formatted(euclidean_vector_view vector) noexcept -> formatted_vector {
+		return formatted_vector{vector};
+	}
+} // namespace comp6771
+
+// Formats vectors as "[a b c]", like operator<<, except that magnitudes are written with fmt's
+// shortest representation that parses back to the same double instead of six significant
+// digits, and without iostreams or locales. The format specification is
+//
+//    [n][element-spec][;separator]
+//
+// where "n" leaves out the brackets, element-spec is any specification for a double, such as
+// ".3f" (dynamic widths and precisions are not supported), and the separator, which is " " by
+// default, is everything after the ';'. For example, "{:.2f;, }" writes "[1.00, 0.50]" and
+// "{:n;,}" writes a CSV row.
+template<>
+struct fmt::formatter<comp6771::formatted_vector> {
+	template<typename ParseContext>
+	constexpr auto parse(ParseContext& ctx) -> decltype(ctx.begin()) {
+		auto it = ctx.begin();
+		auto const end = ctx.end();
+		if (it != end and *it == 'n') {
+			brackets_ = false;
+			++it;
+		}
+		auto element_end = it;
+		while (element_end != end and *element_end != ';' and *element_end != '}') {
+			++element_end;
+		}
+		auto element_context =
+		   format_parse_context(string_view(it, static_cast<std::size_t>(element_end - it)));
+		if (element_.parse(element_context) != element_end) {
+			ctx.on_error("invalid format specifier for the magnitudes of a euclidean_vector");
+		}
+		if (element_end == end or *element_end != ';') {
+			return element_end;
+		}
+		auto const separator_begin = element_end + 1;
+		auto separator_end = separator_begin;
+		while (separator_end != end and *separator_end != '}') {
+			++separator_end;
+		}
+		separator_ = string_view(separator_begin,
+		                         static_cast<std::size_t>(separator_end - separator_begin));
+		return separator_end;
+	}
+
+	template<typename FormatContext>
+	auto format(comp6771::formatted_vector value, FormatContext& ctx) const
+	   -> decltype(ctx.out()) {
+		auto const& vector = value.vector;
+		auto out = ctx.out();
+		if (brackets_) {
+			*out++ = '[';
+		}
+		for (auto i = 0; i < vector.dimensions(); ++i) {
+			if (i != 0) {
+				out = std::copy(separator_.begin(), separator_.end(), out);
+			}
+			ctx.advance_to(out);
+			out = element_.format(vector[i], ctx);
+		}
+		if (brackets_) {
+			*out++ = ']';
+		}
+		return out;
+	}
+
+private:
+	formatter<double> element_;
+	string_view separator_ = " ";
+	bool brackets_ = true;
+};
+
+namespace comp6771 {
+	// The parsers read magnitudes with std::from_chars, so they neither allocate per magnitude nor
+	// depend on the locale, and they read back exactly what the formatter above writes. They throw
+	// std::invalid_argument, naming the offset of the first character they could not parse.
+
+	// Parses text that holds one vector written as "[a b c]". Magnitudes are separated by
+	// whitespace, a comma, or both, and whitespace may surround the brackets.
+	[[nodiscard]] auto parse_euclidean_vector(std::string_view text) -> euclidean_vector;
+	// Parses one "[a b c]" vector from the start of `text` into `vector`, reusing its storage
+	// when it has the right dimensions. Returns the number of characters consumed.
+	auto parse_euclidean_vector(std::string_view text, euclidean_vector& vector) -> std::size_t;
+
+	// Parses one row of comma-separated magnitudes, which ends at a newline or at the end of
+	// `text`, into `vector`. Spaces around magnitudes and a "\r" before the newline are ignored.
+	// Returns the number of characters consumed, including the newline.
+	auto parse_csv_row(std::string_view text, euclidean_vector& vector) -> std::size_t;
+	// as above, but the row must have as many magnitudes as `vector` has dimensions
+	auto parse_csv_row(std::string_view text, euclidean_vector_ref vector) -> std::size_t;
+	// Parses every row of `text` into a batch. Blank lines are skipped; every other row must have
+	// the same number of magnitudes.
+	[[nodiscard]] auto parse_csv(std::string_view text,
+	                             batch_layout layout = batch_layout::row_major)
+	   -> euclidean_vector_batch;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_FORMAT_HPP
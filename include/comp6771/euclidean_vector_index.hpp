@@ -0,0 +1,150 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_INDEX_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_INDEX_HPP
+
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Nearest-neighbour search over a euclidean_vector_batch. Every index answers the same queries:
+//   search(query, k)   the k vectors nearest to `query`
+//   search(queries, k) search(queries[i], k) for every row of a batch of queries
+// Results are ordered by distance and then by row, and hold at most k neighbours. The distances
+// are bitwise equal to distance(batch[row], query).
+//
+// Indexes copy the vectors they are built from. `threads` counts the calling thread: building
+// and batch queries share their work across that many threads, and an index with one thread
+// never starts any. Searches on one index from several threads at once are safe, but their
+// batches take turns on the index's threads. Queries whose dimensions differ from the index's
+// throw std::logic_error, and a negative k throws std::invalid_argument.
+namespace comp6771 {
+	struct neighbour {
+		// the row of the batch the index was built from
+		int row;
+		double distance;
+
+		friend auto operator==(neighbour const&, neighbour const&) noexcept -> bool = default;
+	};
+
+	// Exact: compares the query against every vector. Batch queries are tiled, so that a block of
+	// vectors small enough to stay in cache is compared against several queries before the scan
+	// moves on.
+	class brute_force_index {
+	public:
+		explicit brute_force_index(euclidean_vector_batch const& vectors, std::size_t threads = 1);
+
+		[[nodiscard]] auto search(euclidean_vector_view query, int k) const -> std::vector<neighbour>;
+		[[nodiscard]] auto search(euclidean_vector_batch const& queries, int k) const
+		   -> std::vector<std::vector<neighbour>>;
+
+		[[nodiscard]] auto size() const noexcept -> int {
+			return vectors_.size();
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return vectors_.dimensions();
+		}
+
+	private:
+		euclidean_vector_batch vectors_;
+		std::shared_ptr<thread_pool> pool_;
+	};
+
+	// Exact: a balanced KD-tree that splits each node at the median of its widest dimension. A
+	// search visits the nearer side of each split first and skips the far side when the split is
+	// farther away than the k-th neighbour found so far. Worthwhile for up to about 20 dimensions;
+	// beyond that almost every leaf is visited, and brute_force_index is faster.
+	class kd_tree_index {
+	public:
+		// leaves hold at most this many vectors
+		static constexpr auto leaf_size = 16;
+
+		explicit kd_tree_index(euclidean_vector_batch const& vectors, std::size_t threads = 1);
+
+		[[nodiscard]] auto search(euclidean_vector_view query, int k) const -> std::vector<neighbour>;
+		[[nodiscard]] auto search(euclidean_vector_batch const& queries, int k) const
+		   -> std::vector<std::vector<neighbour>>;
+
+		[[nodiscard]] auto size() const noexcept -> int {
+			return vectors_.size();
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return vectors_.dimensions();
+		}
+
+	private:
+		// the vectors in leaf order, so that each leaf is one contiguous block
+		euclidean_vector_batch vectors_;
+		// rows_[i] is the row of the original batch that vectors_[i] came from
+		std::vector<int> rows_;
+		// node i has children 2i + 1 and 2i + 2, and covers a range of vectors_ that depth alone
+		// determines, so the tree needs no pointers
+		std::vector<int> split_dimension_;
+		std::vector<double> split_value_;
+		int depth_;
+		std::shared_ptr<thread_pool> pool_;
+
+		auto search(double const* query, int k, std::vector<neighbour>& heap) const -> void;
+	};
+
+	struct ivf_options {
+		// how many clusters the vectors are divided into; at most the number of vectors
+		int lists = 256;
+		// rounds of k-means that place the clusters' centroids
+		int iterations = 10;
+		// picks the vectors that seed the centroids
+		std::uint64_t seed = 0;
+	};
+
+	// Approximate: an inverted file. k-means divides the vectors into clusters, and a search only
+	// scans the `probes` clusters whose centroids are nearest the query, so a neighbour in another
+	// cluster can be missed. More probes trade speed for recall; probing every list is exact.
+	// Building is deterministic for a given seed, whatever the number of threads.
+	class ivf_index {
+	public:
+		explicit ivf_index(euclidean_vector_batch const& vectors,
+		                   ivf_options const& options = {},
+		                   std::size_t threads = 1);
+
+		// throws std::invalid_argument unless `probes` is positive
+		[[nodiscard]] auto search(euclidean_vector_view query, int k, int probes) const
+		   -> std::vector<neighbour>;
+		[[nodiscard]] auto search(euclidean_vector_batch const& queries, int k, int probes) const
+		   -> std::vector<std::vector<neighbour>>;
+
+		[[nodiscard]] auto size() const noexcept -> int {
+			return vectors_.size();
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return vectors_.dimensions();
+		}
+
+		[[nodiscard]] auto lists() const noexcept -> int {
+			return centroids_.size();
+		}
+
+		[[nodiscard]] auto centroids() const noexcept -> euclidean_vector_batch const& {
+			return centroids_;
+		}
+
+	private:
+		euclidean_vector_batch centroids_;
+		// the vectors grouped by cluster: list i is rows [offsets_[i], offsets_[i + 1])
+		euclidean_vector_batch vectors_;
+		std::vector<int> offsets_;
+		// rows_[i] is the row of the original batch that vectors_[i] came from
+		std::vector<int> rows_;
+		std::shared_ptr<thread_pool> pool_;
+
+		auto search(double const* query, int k, int probes, std::vector<neighbour>& heap) const
+		   -> void;
+	};
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_INDEX_HPP
@@ -0,0 +1,165 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_KERNELS_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_KERNELS_HPP
+
+#include "comp6771/bfloat16.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Element-wise and reduction kernels shared by euclidean_vector and the types built on it. Each
+// kernel has a scalar, SSE2, AVX2 and AVX-512 implementation; the widest one supported by the CPU
+// is picked the first time a kernel is called.
+//
+// Reductions use one summation order for every instruction set, so the result is bitwise identical
+// regardless of which implementation runs:
+//   1. element i is accumulated into lane i % 16, for every i below n - n % 16;
+//   2. the upper half of the lanes is added onto the lower half (lane j += lane j + 8, then
+//      j + 4, j + 2 and j + 1) until a single lane remains;
+//   3. the remaining n % 16 elements are added to that lane in order.
+// Products are rounded before they are accumulated (no fused multiply-add). For non-negative terms
+// the result is therefore within n / 16 + 20 ULPs of the exact sum. Only fused_scale_add and the
+// compensated reductions use FMA, which is correctly rounded, so they too give the same result on
+// every instruction set.
+//
+// Parallel execution is off by default. Once enabled, kernels on at least `threshold` elements are
+// split into chunks of parallel_chunk_size elements that are shared out across the threads.
+// Reductions sum each chunk in the order above and then add the chunk sums from first to last, so
+// their results depend on the size alone: they are the same run to run and for any thread count,
+// but may differ from serial execution in the last bits.
+namespace comp6771::kernels {
+	enum class simd_level { scalar, sse2, avx2, avx512 };
+
+	// the widest instruction set this CPU supports
+	[[nodiscard]] auto detected_simd_level() noexcept -> simd_level;
+	// the instruction set the kernels currently run with
+	[[nodiscard]] auto active_simd_level() noexcept -> simd_level;
+	// throws std::invalid_argument if the CPU does not support `level`
+	auto set_simd_level(simd_level level) -> void;
+
+	inline constexpr auto parallel_chunk_size = std::size_t{1} << 15;
+	inline constexpr auto default_parallel_threshold = std::size_t{1} << 18;
+
+	// `threads` counts the calling thread; throws std::invalid_argument if it is 0
+	auto enable_parallel_execution(std::size_t threads,
+	                               std::size_t threshold = default_parallel_threshold) -> void;
+	auto disable_parallel_execution() -> void;
+	// 0 while parallel execution is disabled
+	[[nodiscard]] auto parallel_threads() noexcept -> std::size_t;
+
+	[[nodiscard]] auto dot(double const* x, double const* y, std::size_t size) noexcept -> double;
+	[[nodiscard]] auto sum_of_squares(double const* x, std::size_t size) noexcept -> double;
+	// sum of (x[i] - y[i])^2, each difference rounded before it is squared
+	[[nodiscard]] auto squared_distance(double const* x, double const* y, std::size_t size) noexcept
+	   -> double;
+
+	struct dot_terms {
+		double xy;
+		double xx;
+		double yy;
+	};
+	// dot(x, y), sum_of_squares(x) and sum_of_squares(y) in a single pass; each sum is bitwise
+	// identical to the one the separate kernel returns
+	[[nodiscard]] auto dot_terms_of(double const* x, double const* y, std::size_t size) noexcept
+	   -> dot_terms;
+
+	// How dot and norm accumulate their terms. Every policy gives the same result at every SIMD
+	// level.
+	enum class accumulation {
+		// the summation order above
+		naive,
+		// The summation order above, but each lane also accumulates the rounding errors of its
+		// products and additions (Ogita, Rump and Oishi's Dot2, a branch-free Neumaier sum). The
+		// result is as accurate as a naive sum in twice the precision, whatever the size. Parallel
+		// chunk sums are added with their errors too, so chunking barely changes the result.
+		compensated,
+		// Naive sums of blocks of at most pairwise_block_size elements, added pairwise, so the
+		// error grows with log(size) rather than size. Always runs serially.
+		pairwise,
+		// Compensated, but when the products or their sum overflow or underflow, x and y are scaled
+		// by powers of two first, as std::hypot does. A sum that is not finite or is tiny costs a
+		// pass to find each array's largest magnitude, and a scaled pass only if the products could
+		// have overflowed or underflowed.
+		scaled,
+	};
+	inline constexpr auto pairwise_block_size = std::size_t{512};
+
+	[[nodiscard]] auto
+	dot(double const* x, double const* y, std::size_t size, accumulation policy) noexcept -> double;
+	// the square root of the sum of x[i]^2
+	[[nodiscard]] auto norm(double const* x, std::size_t size, accumulation policy) noexcept
+	   -> double;
+
+	// Dot products of reduced-precision arrays, accumulated in a wider type. Products of floats and
+	// of bfloat16s are exact in double and are summed in the order above, so they equal the double
+	// dot product of the widened arrays; int8 products are summed exactly in 64-bit integers. AVX-512
+	// has no 16-bit integer multiply-add without AVX512BW, so int8 runs the AVX2 kernel there. These
+	// always run serially.
+	[[nodiscard]] auto dot(float const* x, float const* y, std::size_t size) noexcept -> double;
+	[[nodiscard]] auto dot(bfloat16 const* x, bfloat16 const* y, std::size_t size) noexcept
+	   -> double;
+	[[nodiscard]] auto dot(std::int8_t const* x, std::int8_t const* y, std::size_t size) noexcept
+	   -> std::int64_t;
+
+	// Comparisons check a block of 16 pairs at a time and stop at the first block with a pair that
+	// differs. They always run serially.
+	// whether x[i] == y[i] for every i
+	[[nodiscard]] auto equal(double const* x, double const* y, std::size_t size) noexcept -> bool;
+	// Whether, for every i, x[i] == y[i], or their difference is finite and at most the larger of
+	// `absolute_tolerance` and `relative_tolerance` * max(|x[i]|, |y[i]|). NaNs are close to
+	// nothing and infinities only to themselves.
+	[[nodiscard]] auto approx_equal(double const* x,
+	                                double const* y,
+	                                std::size_t size,
+	                                double absolute_tolerance,
+	                                double relative_tolerance) noexcept -> bool;
+	// The largest number of steps between adjacent doubles that separate x[i] from y[i], counting
+	// -0 and +0 as the same; the maximum std::uint64_t if either is NaN, and 0 if size is 0.
+	[[nodiscard]] auto ulp_distance(double const* x, double const* y, std::size_t size) noexcept
+	   -> std::uint64_t;
+	// XXH64 of the magnitudes' bits, except that -0 is hashed as +0, so that arrays that compare
+	// equal hash equally. Not for use against adversarial input.
+	[[nodiscard]] auto hash(double const* x, std::size_t size, std::uint64_t seed) noexcept
+	   -> std::uint64_t;
+
+	// `out` may be the same array as `x` or `y`
+	auto add(double* out, double const* x, double const* y, std::size_t size) noexcept -> void;
+	auto subtract(double* out, double const* x, double const* y, std::size_t size) noexcept -> void;
+	auto multiply(double* out, double const* x, double multiplier, std::size_t size) noexcept
+	   -> void;
+	auto divide(double* out, double const* x, double divisor, std::size_t size) noexcept -> void;
+	// y[i] += alpha * x[i], with the product rounded before it is added
+	auto axpy(double* y, double alpha, double const* x, std::size_t size) noexcept -> void;
+	auto copy(double* out, double const* x, std::size_t size) noexcept -> void;
+	// sums[i] += (x[i] - s)^2
+	auto add_squared_difference(double* sums, double const* x, double s, std::size_t size) noexcept
+	   -> void;
+	// out[i] = x[i] + t * (y[i] - x[i]), or exactly y[i] when t is 1
+	auto lerp(double* out, double const* x, double const* y, double t, std::size_t size) noexcept
+	   -> void;
+	// out[i] = alpha * x[i] + y[i], rounded once (fused multiply-add)
+	auto fused_scale_add(double* out,
+	                     double alpha,
+	                     double const* x,
+	                     double const* y,
+	                     std::size_t size) noexcept -> void;
+
+	// running statistics of each component, for welford_step
+	struct welford_accumulators {
+		double* sum;
+		double* mean;
+		double* m2;
+		double* min;
+		double* max;
+	};
+	// Adds x as the next observation of every component, by Welford's method: sum[i] += x[i];
+	// with delta = x[i] - mean[i], mean[i] += delta * reciprocal_count and
+	// m2[i] += delta * (x[i] - mean[i]); min[i] and max[i] take x[i] if it is smaller or larger, so
+	// they ignore NaNs. `reciprocal_count` is 1 / the number of observations, counting x. Always
+	// runs serially.
+	auto welford_step(welford_accumulators const& accumulators,
+	                  double const* x,
+	                  double reciprocal_count,
+	                  std::size_t size) noexcept -> void;
+} // namespace comp6771::kernels
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_KERNELS_HPP
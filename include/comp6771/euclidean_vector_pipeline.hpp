@@ -0,0 +1,172 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_PIPELINE_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_PIPELINE_HPP
+
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_file.hpp"
+#include "comp6771/instrumentation.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Streaming pipelines that pass batches of vectors from a source, through stages that each run on
+// their own threads, to a sink. While one batch is being written the next can be scored and the
+// one after that read, so neither the cores nor the I/O wait for a whole stream to finish a step.
+namespace comp6771 {
+	// A first-in, first-out queue of at most `capacity` values for handing work between threads.
+	// push waits while the queue is full, which holds a producer back to its consumer's pace. The
+	// storage is allocated once, when the queue is made.
+	template<typename T>
+	class bounded_queue {
+	public:
+		// throws std::invalid_argument if `capacity` is zero
+		explicit bounded_queue(std::size_t capacity)
+		: values_(capacity) {
+			if (capacity == 0) {
+				throw std::invalid_argument("a bounded_queue needs room for at least one value");
+			}
+		}
+
+		bounded_queue(bounded_queue const&) = delete;
+		auto operator=(bounded_queue const&) -> bounded_queue& = delete;
+
+		// Waits for room, then appends `value`. Returns false, dropping `value`, if the queue is
+		// closed first.
+		auto push(T value) -> bool {
+			auto lock = std::unique_lock(mutex_);
+			not_full_.wait(lock, [this] { return closed_ or size_ < values_.size(); });
+			if (closed_) {
+				return false;
+			}
+			values_[(head_ + size_) % values_.size()] = std::move(value);
+			++size_;
+			lock.unlock();
+			not_empty_.notify_one();
+			return true;
+		}
+
+		// waits for a value; returns std::nullopt once the queue is closed and empty
+		auto pop() -> std::optional<T> {
+			auto lock = std::unique_lock(mutex_);
+			not_empty_.wait(lock, [this] { return closed_ or size_ != 0; });
+			if (size_ == 0) {
+				return std::nullopt;
+			}
+			auto value = std::optional<T>(std::move(values_[head_]));
+			head_ = (head_ + 1) % values_.size();
+			--size_;
+			lock.unlock();
+			not_full_.notify_one();
+			return value;
+		}
+
+		// Wakes every waiting thread. Pushes fail from now on; pops return what is left, then
+		// std::nullopt.
+		auto close() -> void {
+			{
+				auto const lock = std::scoped_lock(mutex_);
+				closed_ = true;
+			}
+			not_full_.notify_all();
+			not_empty_.notify_all();
+		}
+
+		[[nodiscard]] auto capacity() const noexcept -> std::size_t {
+			return values_.size();
+		}
+
+	private:
+		std::mutex mutex_;
+		std::condition_variable not_full_;
+		std::condition_variable not_empty_;
+		std::vector<T> values_;
+		std::size_t head_ = 0;
+		std::size_t size_ = 0;
+		bool closed_ = false;
+	};
+
+	// a batch of vectors on its way through a pipeline
+	struct pipeline_batch {
+		// the vectors read, in rows [0, size); later rows hold whatever an earlier batch left
+		euclidean_vector_batch vectors;
+		// where stages that change the vectors' dimensions write, a row for each vector
+		euclidean_vector_batch results;
+		int size = 0;
+		// the batch's position in the stream, counting from 0
+		std::uint64_t sequence = 0;
+		// when the source started to fill the batch
+		std::chrono::steady_clock::time_point started;
+	};
+
+	struct pipeline_options {
+		// the rows of each batch
+		int batch_size = 1024;
+		// The batches allocated up front and reused. The source waits while every one is in use,
+		// so this bounds both the pipeline's memory and how far reading runs ahead of writing.
+		std::size_t batches = 8;
+	};
+
+	// A step of a pipeline, which `workers` threads run on different batches at once. Batches
+	// may leave a stage with several workers out of order; the sink still sees them in order.
+	struct pipeline_stage {
+		std::function<void(pipeline_batch&)> run;
+		std::size_t workers = 1;
+	};
+
+	// Fills rows from 0 of the batch it is given and returns how many. Returning fewer rows than
+	// the batch has ends the stream.
+	using pipeline_source = std::function<int(euclidean_vector_batch&)>;
+	// consumes each batch, in the order the source filled them
+	using pipeline_sink = std::function<void(pipeline_batch const&)>;
+
+	struct pipeline_report {
+		std::uint64_t vectors = 0;
+		// A call for each batch, timed from when the source started to fill it until the sink
+		// returned; bytes counts the magnitudes read.
+		instrumentation::operation_statistics batches;
+	};
+
+	// Runs `source` on a thread of its own, each stage on its workers, and `sink` on the calling
+	// thread, until the source ends the stream and every batch has been sunk. Batches have
+	// `dimensions` and results have `result_dimensions`; nothing is allocated after they are.
+	//
+	// If the source, a stage or the sink throws, the pipeline stops, drops the batches in flight,
+	// and rethrows the first exception once its threads have finished. Throws
+	// std::invalid_argument if the batch size, the number of batches or a stage's workers is not
+	// positive.
+	auto run_pipeline(int dimensions,
+	                  int result_dimensions,
+	                  pipeline_source const& source,
+	                  std::span<pipeline_stage const> stages,
+	                  pipeline_sink const& sink,
+	                  pipeline_options const& options = {}) -> pipeline_report;
+
+	struct scoring_workers {
+		std::size_t unit = 1;
+		std::size_t dot = 1;
+	};
+
+	// Reads each vector `in` has not read yet, and writes transform(references, unit(v)), its dot
+	// products with every reference vector, to `out` in the order read. Reading, normalising,
+	// scoring and writing overlap, as a run_pipeline with a stage for each of unit and dot.
+	//
+	// Throws std::logic_error if references.columns() is not in.dimensions(), if
+	// out.dimensions() is not references.rows(), or if a vector has no unit vector. In the last
+	// case `out` may already hold the scores of some of the vectors before it.
+	auto score_stream(vector_file_reader& in,
+	                  euclidean_matrix const& references,
+	                  vector_file_writer& out,
+	                  scoring_workers const& workers = {},
+	                  pipeline_options const& options = {}) -> pipeline_report;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_PIPELINE_HPP
@@ -0,0 +1,131 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_STATISTICS_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_STATISTICS_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_file.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+// Statistics of a collection of euclidean_vectors gathered in a single pass: the sum, mean,
+// variance, minimum and maximum of each component, and a histogram of the vectors' norms. The
+// mean and variance use Welford's method, which stays accurate when the components' spread is
+// small next to their mean.
+//
+// The statistics of two disjoint collections merge into the statistics of their union (by Chan,
+// Golub and LeVeque's formulae), so partial results from several threads, files or machines can
+// be combined. A merged mean or variance agrees with adding the vectors one at a time up to
+// rounding.
+namespace comp6771 {
+	struct norm_histogram_options {
+		// how many bins divide [low, high) evenly; 0 leaves the histogram out
+		int bins = 0;
+		double low = 0.0;
+		double high = 1.0;
+	};
+
+	struct norm_histogram {
+		double low = 0.0;
+		double high = 1.0;
+		std::vector<std::uint64_t> counts;
+		// norms below low
+		std::uint64_t below = 0;
+		// norms of at least high, and NaNs
+		std::uint64_t above = 0;
+
+		friend auto operator==(norm_histogram const&, norm_histogram const&) -> bool = default;
+	};
+
+	class vector_statistics {
+	public:
+		// Throws std::invalid_argument if histogram.bins is negative, or if it is positive and
+		// histogram.low is not below histogram.high.
+		explicit vector_statistics(int dimensions, norm_histogram_options const& histogram = {});
+
+		// throws std::logic_error if `vector` does not have the statistics' dimensions
+		auto add(euclidean_vector_view vector) -> void;
+		auto add(euclidean_vector_batch const& vectors) -> void;
+
+		// adds every vector of `vectors` in order, which may be read from a stream as they are added
+		template<std::ranges::input_range Range>
+		requires std::convertible_to<std::ranges::range_reference_t<Range>, euclidean_vector_view>
+		auto add(Range&& vectors) -> void {
+			for (auto&& vector : vectors) {
+				add(euclidean_vector_view(vector));
+			}
+		}
+
+		// Adds the vectors `other` was gathered from. Throws std::logic_error if the dimensions or
+		// the histograms' bins differ.
+		auto merge(vector_statistics const& other) -> void;
+
+		[[nodiscard]] auto count() const noexcept -> std::uint64_t {
+			return count_;
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return sum_.dimensions();
+		}
+
+		[[nodiscard]] auto sum() const noexcept -> euclidean_vector const& {
+			return sum_;
+		}
+
+		// The mean, minimum, maximum and variance throw std::logic_error until a vector is added.
+		// Minimums and maximums ignore NaNs.
+		[[nodiscard]] auto mean() const -> euclidean_vector const&;
+		[[nodiscard]] auto min() const -> euclidean_vector const&;
+		[[nodiscard]] auto max() const -> euclidean_vector const&;
+		// the population variance of each component
+		[[nodiscard]] auto variance() const -> euclidean_vector;
+		// the sample variance of each component; throws std::logic_error with fewer than two vectors
+		[[nodiscard]] auto sample_variance() const -> euclidean_vector;
+
+		// the histogram of euclidean_norm(vector) over the vectors added; empty without bins
+		[[nodiscard]] auto histogram() const noexcept -> norm_histogram const& {
+			return histogram_;
+		}
+
+	private:
+		std::uint64_t count_ = 0;
+		euclidean_vector sum_;
+		euclidean_vector mean_;
+		// sum of squared differences from the mean
+		euclidean_vector m2_;
+		euclidean_vector min_;
+		euclidean_vector max_;
+		norm_histogram histogram_;
+		// strided vectors are gathered here before they are added
+		std::vector<double> scratch_;
+
+		auto add_contiguous(double const* magnitudes) -> void;
+		auto check_count(std::uint64_t minimum) const -> void;
+	};
+
+	// describe() gathers the statistics of each chunk of this many vectors separately and merges
+	// them in order, so its result is the same for any number of threads, but may differ from
+	// adding the vectors one at a time in the last bits.
+	inline constexpr auto statistics_chunk_size = std::size_t{4096};
+
+	[[nodiscard]] auto describe(euclidean_vector_batch const& vectors,
+	                            norm_histogram_options const& histogram = {}) -> vector_statistics;
+	[[nodiscard]] auto describe(euclidean_vector_batch const& vectors,
+	                            norm_histogram_options const& histogram,
+	                            thread_pool& pool) -> vector_statistics;
+
+	// Reads every vector `reader` has not read yet, a few chunks at a time into one reused buffer,
+	// so files larger than memory can be described. The result equals describe(reader.read_all()).
+	[[nodiscard]] auto describe(vector_file_reader& reader,
+	                            norm_histogram_options const& histogram = {}) -> vector_statistics;
+	[[nodiscard]] auto describe(vector_file_reader& reader,
+	                            norm_histogram_options const& histogram,
+	                            thread_pool& pool) -> vector_statistics;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_STATISTICS_HPP
@@ -0,0 +1,205 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_VIEW_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_VIEW_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	class euclidean_vector_view;
+	class euclidean_vector_ref;
+
+	namespace detail {
+		template<>
+		inline constexpr auto is_vector_view<euclidean_vector_view> = true;
+
+		template<>
+		inline constexpr auto is_vector_view<euclidean_vector_ref> = true;
+	} // namespace detail
+
+	// Non-owning, read-only view of `dimensions` magnitudes that are `stride` elements apart. The
+	// viewed memory must outlive the view. Views take part in arithmetic expressions like any
+	// euclidean_vector, so data that already lives in a std::vector, a memory-mapped file or a
+	// network buffer is never copied just to be computed on.
+	class euclidean_vector_view : public vector_expression_base {
+	public:
+		euclidean_vector_view(double const* magnitudes,
+		                      int dimensions,
+		                      std::ptrdiff_t stride = 1) noexcept
+		: magnitudes_{magnitudes}
+		, dimension_{dimensions}
+		, stride_{stride} {}
+
+		// views any contiguous range of doubles: std::span, std::vector, std::array, ...
+		template<typename Range>
+		requires std::convertible_to<Range const&, std::span<double const>>
+		euclidean_vector_view(Range const& magnitudes) noexcept // NOLINT(google-explicit-constructor)
+		: euclidean_vector_view(std::span<double const>(magnitudes).data(),
+		                        static_cast<int>(std::span<double const>(magnitudes).size())) {}
+
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		euclidean_vector_view(euclidean_vector const& vector) noexcept
+		: euclidean_vector_view(vector.data(), vector.dimensions()) {}
+
+		auto operator[](int i) const noexcept -> double {
+			return magnitudes_[i * stride_];
+		}
+
+		auto operator[](std::size_t i) const noexcept -> double {
+			return magnitudes_[static_cast<std::ptrdiff_t>(i) * stride_];
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		[[nodiscard]] auto stride() const noexcept -> std::ptrdiff_t {
+			return stride_;
+		}
+
+		[[nodiscard]] auto data() const noexcept -> double const* {
+			return magnitudes_;
+		}
+
+		// the SIMD kernels can only run on views whose magnitudes are adjacent
+		[[nodiscard]] auto is_contiguous() const noexcept -> bool {
+			return stride_ == 1 or dimension_ <= 1;
+		}
+
+		auto evaluate(double* out) const noexcept -> void {
+			if (is_contiguous()) {
+				kernels::copy(out, magnitudes_, static_cast<std::size_t>(dimension_));
+				return;
+			}
+			for (auto i = 0; i < dimension_; ++i) {
+				out[i] = (*this)[i];
+			}
+		}
+
+		explicit operator std::vector<double>() const noexcept {
+			auto magnitudes = std::vector<double>(static_cast<std::size_t>(dimension_));
+			evaluate(magnitudes.data());
+			return magnitudes;
+		}
+
+	private:
+		double const* magnitudes_;
+		int dimension_;
+		std::ptrdiff_t stride_;
+	};
+
+	// Non-owning view whose magnitudes can be written through. Assigning to a reference writes
+	// to the referenced magnitudes, which must already have the right dimensions; it never
+	// rebinds the reference.
+	class euclidean_vector_ref : public vector_expression_base {
+	public:
+		euclidean_vector_ref(double* magnitudes, int dimensions, std::ptrdiff_t stride = 1) noexcept
+		: magnitudes_{magnitudes}
+		, dimension_{dimensions}
+		, stride_{stride} {}
+
+		// refers to any contiguous range of mutable doubles: std::span, std::vector, ...
+		template<typename Range>
+		requires std::convertible_to<Range&, std::span<double>>
+		euclidean_vector_ref(Range& magnitudes) noexcept // NOLINT(google-explicit-constructor)
+		: euclidean_vector_ref(std::span<double>(magnitudes).data(),
+		                       static_cast<int>(std::span<double>(magnitudes).size())) {}
+
+		euclidean_vector_ref(euclidean_vector_ref const&) noexcept = default;
+		~euclidean_vector_ref() = default;
+
+		auto operator=(euclidean_vector_ref const& source) -> euclidean_vector_ref& {
+			return *this = euclidean_vector_view(source);
+		}
+
+		auto operator=(euclidean_vector const& source) -> euclidean_vector_ref& {
+			return *this = euclidean_vector_view(source);
+		}
+
+		template<vector_expression Expression>
+		auto operator=(Expression const& expression) -> euclidean_vector_ref& {
+			if (dimension_ != expression.dimensions()) {
+				detail::throw_dimension_mismatch(dimension_, expression.dimensions());
+			}
+			if (is_contiguous()) {
+				expression.evaluate(magnitudes_);
+				return *this;
+			}
+			// element i of an expression only reads element i of its operands, so writing in
+			// place is safe even when the expression refers to this reference
+			for (auto i = std::size_t{0}; i < static_cast<std::size_t>(dimension_); ++i) {
+				(*this)[i] = expression[i];
+			}
+			return *this;
+		}
+
+		auto operator+=(euclidean_vector_view vector) -> euclidean_vector_ref&;
+		auto operator-=(euclidean_vector_view vector) -> euclidean_vector_ref&;
+		auto operator*=(double multiplier) noexcept -> euclidean_vector_ref&;
+		auto operator/=(double divisor) -> euclidean_vector_ref&;
+
+		auto operator[](int i) const noexcept -> double& {
+			return magnitudes_[i * stride_];
+		}
+
+		auto operator[](std::size_t i) const noexcept -> double& {
+			return magnitudes_[static_cast<std::ptrdiff_t>(i) * stride_];
+		}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		[[nodiscard]] auto stride() const noexcept -> std::ptrdiff_t {
+			return stride_;
+		}
+
+		[[nodiscard]] auto data() const noexcept -> double* {
+			return magnitudes_;
+		}
+
+		[[nodiscard]] auto is_contiguous() const noexcept -> bool {
+			return stride_ == 1 or dimension_ <= 1;
+		}
+
+		auto evaluate(double* out) const noexcept -> void {
+			euclidean_vector_view(*this).evaluate(out);
+		}
+
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		operator euclidean_vector_view() const noexcept {
+			return euclidean_vector_view(magnitudes_, dimension_, stride_);
+		}
+
+		explicit operator std::vector<double>() const noexcept {
+			return static_cast<std::vector<double>>(euclidean_vector_view(*this));
+		}
+
+	private:
+		double* magnitudes_;
+		int dimension_;
+		std::ptrdiff_t stride_;
+	};
+
+	// Magnitudes are compared exactly, like euclidean_vector's operator==.
+	auto operator==(euclidean_vector_view x, euclidean_vector_view y) noexcept -> bool;
+	auto operator!=(euclidean_vector_view x, euclidean_vector_view y) noexcept -> bool;
+
+	// The same results as the euclidean_vector overloads, bit for bit. Strided views are gathered
+	// into a temporary first so that they use the same kernels.
+	auto euclidean_norm(euclidean_vector_view v) -> double;
+	auto unit(euclidean_vector_view v) -> euclidean_vector;
+	auto dot(euclidean_vector_view x, euclidean_vector_view y) -> double;
+	auto euclidean_norm(euclidean_vector_view v, accumulation policy) -> double;
+	auto dot(euclidean_vector_view x, euclidean_vector_view y, accumulation policy) -> double;
+	auto squared_distance(euclidean_vector_view x, euclidean_vector_view y) -> double;
+	auto distance(euclidean_vector_view x, euclidean_vector_view y) -> double;
+	auto cosine_similarity(euclidean_vector_view x, euclidean_vector_view y) -> double;
+	// y += alpha * x, with the product rounded before it is added
+	auto axpy(double alpha, euclidean_vector_view x, euclidean_vector_ref y) -> void;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_VIEW_HPP
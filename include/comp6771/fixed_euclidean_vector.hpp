@@ -0,0 +1,332 @@
+#ifndef COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace comp6771 {
+	namespace detail {
+		// loops over at most this many magnitudes are unrolled completely
+		inline constexpr auto unroll_limit = std::size_t{64};
+
+		template<std::size_t First, typename Function, std::size_t... I>
+		constexpr auto unroll(Function& f, std::index_sequence<I...>) -> void {
+			(f(First + I), ...);
+		}
+
+		// f(i) for every i in [First, Last), in order
+		template<std::size_t First, std::size_t Last, typename Function>
+		constexpr auto for_each_index(Function f) -> void {
+			if constexpr (Last - First <= unroll_limit) {
+				unroll<First>(f, std::make_index_sequence<Last - First>{});
+			}
+			else {
+				for (auto i = First; i < Last; ++i) {
+					f(i);
+				}
+			}
+		}
+
+		// The sum of term(i) for every i in [0, N), in the order euclidean_vector_kernels.hpp
+		// documents, so that fixed vectors reduce to the same results as serial euclidean_vectors.
+		template<std::size_t N, typename Term>
+		constexpr auto ordered_sum(Term term) -> double {
+			constexpr auto lanes = std::size_t{16};
+			constexpr auto blocked = N - N % lanes;
+			auto acc = std::array<double, lanes>{};
+			for_each_index<0, blocked>([&](std::size_t i) { acc[i % lanes] += term(i); });
+			for (auto width = lanes / 2; width > 0; width /= 2) {
+				for (auto j = std::size_t{0}; j < width; ++j) {
+					acc[j] += acc[j + width];
+				}
+			}
+			for_each_index<blocked, N>([&](std::size_t i) { acc[0] += term(i); });
+			return acc[0];
+		}
+	} // namespace detail
+
+	// A euclidean_vector whose dimensions are part of its type. The magnitudes are a std::array, so
+	// a fixed vector never allocates, and its arithmetic is constexpr and unrolled completely for
+	// up to detail::unroll_limit dimensions. Combining vectors of different dimensions does not
+	// compile. Fixed vectors are contiguous ranges, so they convert to euclidean_vector_view and
+	// euclidean_vector_ref without copying.
+	template<int N>
+	requires(N >= 0)
+	class fixed_euclidean_vector {
+	public:
+		// N zeroes
+		constexpr fixed_euclidean_vector() noexcept = default;
+
+		// N copies of `magnitude`; for one dimension the constructor below does the same
+		explicit constexpr fixed_euclidean_vector(double magnitude) noexcept requires(N != 1) {
+			magnitudes_.fill(magnitude);
+		}
+
+		template<typename... Magnitudes>
+		requires(N != 0 and sizeof...(Magnitudes) == N
+		         and (std::convertible_to<Magnitudes, double> and ...))
+		constexpr fixed_euclidean_vector(Magnitudes... magnitudes) noexcept
+		: magnitudes_{static_cast<double>(magnitudes)...} {}
+
+		// copies `vector`; throws std::logic_error unless it has N dimensions
+		explicit fixed_euclidean_vector(euclidean_vector_view vector) {
+			if (vector.dimensions() != N) {
+				detail::throw_dimension_mismatch(N, vector.dimensions());
+			}
+			for (auto i = 0; i < N; ++i) {
+				magnitudes_[static_cast<std::size_t>(i)] = vector[i];
+			}
+		}
+
+		// the dimensions of two fixed vectors are known to differ
+		template<int M>
+		requires(M != N)
+		explicit fixed_euclidean_vector(fixed_euclidean_vector<M> const&) = delete;
+
+		constexpr auto operator[](int i) const noexcept -> double {
+			return magnitudes_[static_cast<std::size_t>(i)];
+		}
+
+		constexpr auto operator[](int i) noexcept -> double& {
+			return magnitudes_[static_cast<std::size_t>(i)];
+		}
+
+		[[nodiscard]] constexpr auto at(int dimension) const -> double {
+			check_index(dimension);
+			return (*this)[dimension];
+		}
+
+		constexpr auto at(int dimension) -> double& {
+			check_index(dimension);
+			return (*this)[dimension];
+		}
+
+		[[nodiscard]] static constexpr auto dimensions() noexcept -> int {
+			return N;
+		}
+
+		[[nodiscard]] static constexpr auto size() noexcept -> std::size_t {
+			return static_cast<std::size_t>(N);
+		}
+
+		[[nodiscard]] constexpr auto data() const noexcept -> double const* {
+			return magnitudes_.data();
+		}
+
+		[[nodiscard]] constexpr auto data() noexcept -> double* {
+			return magnitudes_.data();
+		}
+
+		[[nodiscard]] constexpr auto begin() const noexcept -> double const* {
+			return data();
+		}
+
+		[[nodiscard]] constexpr auto begin() noexcept -> double* {
+			return data();
+		}
+
+		[[nodiscard]] constexpr auto end() const noexcept -> double const* {
+			return data() + N;
+		}
+
+		[[nodiscard]] constexpr auto end() noexcept -> double* {
+			return data() + N;
+		}
+
+		constexpr auto operator+() const noexcept -> fixed_euclidean_vector {
+			return *this;
+		}
+
+		constexpr auto operator-() const noexcept -> fixed_euclidean_vector {
+			auto result = fixed_euclidean_vector();
+			for_each([&](std::size_t i) { result.magnitudes_[i] = -magnitudes_[i]; });
+			return result;
+		}
+
+		constexpr auto operator+=(fixed_euclidean_vector const& vector) noexcept
+		   -> fixed_euclidean_vector& {
+			for_each([&](std::size_t i) { magnitudes_[i] += vector.magnitudes_[i]; });
+			return *this;
+		}
+
+		constexpr auto operator-=(fixed_euclidean_vector const& vector) noexcept
+		   -> fixed_euclidean_vector& {
+			for_each([&](std::size_t i) { magnitudes_[i] -= vector.magnitudes_[i]; });
+			return *this;
+		}
+
+		constexpr auto operator*=(double multiplier) noexcept -> fixed_euclidean_vector& {
+			for_each([&](std::size_t i) { magnitudes_[i] *= multiplier; });
+			return *this;
+		}
+
+		constexpr auto operator/=(double divisor) -> fixed_euclidean_vector& {
+			if (divisor == 0) {
+				throw std::logic_error("Invalid vector division by 0");
+			}
+			for_each([&](std::size_t i) { magnitudes_[i] /= divisor; });
+			return *this;
+		}
+
+		explicit operator euclidean_vector() const {
+			return euclidean_vector(euclidean_vector_view(*this));
+		}
+
+		explicit operator std::vector<double>() const {
+			return std::vector<double>(begin(), end());
+		}
+
+		friend constexpr auto operator==(fixed_euclidean_vector const&,
+		                                 fixed_euclidean_vector const&) noexcept -> bool = default;
+
+		friend constexpr auto operator+(fixed_euclidean_vector lhs,
+		                                fixed_euclidean_vector const& rhs) noexcept
+		   -> fixed_euclidean_vector {
+			return lhs += rhs;
+		}
+
+		friend constexpr auto operator-(fixed_euclidean_vector lhs,
+		                                fixed_euclidean_vector const& rhs) noexcept
+		   -> fixed_euclidean_vector {
+			return lhs -= rhs;
+		}
+
+		friend constexpr auto operator*(fixed_euclidean_vector vector, double multiplier) noexcept
+		   -> fixed_euclidean_vector {
+			return vector *= multiplier;
+		}
+
+		friend constexpr auto operator*(double multiplier, fixed_euclidean_vector vector) noexcept
+		   -> fixed_euclidean_vector {
+			return vector *= multiplier;
+		}
+
+		friend constexpr auto operator/(fixed_euclidean_vector vector, double divisor)
+		   -> fixed_euclidean_vector {
+			return vector /= divisor;
+		}
+
+		// the same format as euclidean_vector
+		friend auto operator<<(std::ostream& os, fixed_euclidean_vector const& vector)
+		   -> std::ostream& {
+			os << "[";
+			for (auto i = 0; i < N; ++i) {
+				os << vector[i] << (i + 1 == N ? "" : " ");
+			}
+			return os << "]";
+		}
+
+	private:
+		std::array<double, static_cast<std::size_t>(N)> magnitudes_ = {};
+
+		template<typename Function>
+		static constexpr auto for_each(Function f) -> void {
+			detail::for_each_index<0, static_cast<std::size_t>(N)>(f);
+		}
+
+		static constexpr auto check_index(int dimension) -> void {
+			if (dimension < 0 or dimension >= N) {
+				throw std::out_of_range("Index " + std::to_string(dimension)
+				                        + " is not Valid for this fixed_euclidean_vector object");
+			}
+		}
+	};
+
+	template<int N>
+	constexpr auto
+	dot(fixed_euclidean_vector<N> const& x, fixed_euclidean_vector<N> const& y) noexcept -> double {
+		return detail::ordered_sum<static_cast<std::size_t>(N)>(
+		   [&](std::size_t i) { return x[static_cast<int>(i)] * y[static_cast<int>(i)]; });
+	}
+
+	template<int N>
+	constexpr auto squared_distance(fixed_euclidean_vector<N> const& x,
+	                                fixed_euclidean_vector<N> const& y) noexcept -> double {
+		return detail::ordered_sum<static_cast<std::size_t>(N)>([&](std::size_t i) {
+			auto const difference = x[static_cast<int>(i)] - y[static_cast<int>(i)];
+			return difference * difference;
+		});
+	}
+
+	// A vector with no dimensions has no norm, so these do not compile for N = 0.
+	template<int N>
+	requires(N > 0)
+	auto euclidean_norm(fixed_euclidean_vector<N> const& v) noexcept -> double {
+		return std::sqrt(dot(v, v));
+	}
+
+	template<int N>
+	auto distance(fixed_euclidean_vector<N> const& x, fixed_euclidean_vector<N> const& y) noexcept
+	   -> double {
+		return std::sqrt(squared_distance(x, y));
+	}
+
+	template<int N>
+	requires(N > 0)
+	auto unit(fixed_euclidean_vector<N> const& v) -> fixed_euclidean_vector<N> {
+		auto const norm = euclidean_norm(v);
+		if (norm == 0) {
+			throw std::logic_error("euclidean_vector with zero euclidean normal does not have a unit "
+			                       "vector");
+		}
+		// the reciprocal euclidean_vector's unit multiplies by, so the results match bit for bit
+		return v * (1.0 / norm);
+	}
+
+	template<int N>
+	requires(N > 0)
+	auto cosine_similarity(fixed_euclidean_vector<N> const& x, fixed_euclidean_vector<N> const& y)
+	   -> double {
+		auto const x_norm = euclidean_norm(x);
+		auto const y_norm = euclidean_norm(y);
+		if (x_norm == 0 or y_norm == 0) {
+			throw std::logic_error("euclidean_vector with zero euclidean normal does not have a "
+			                       "cosine similarity");
+		}
+		return dot(x, y) / (x_norm * y_norm);
+	}
+
+	// Without these, fixed vectors of different (or no) dimensions would convert to views and only
+	// be rejected at run time.
+	template<int N>
+	requires(N == 0)
+	auto euclidean_norm(fixed_euclidean_vector<N> const&) -> double = delete;
+	template<int N>
+	requires(N == 0)
+	auto unit(fixed_euclidean_vector<N> const&) -> fixed_euclidean_vector<N> = delete;
+	template<int N>
+	requires(N == 0)
+	auto cosine_similarity(fixed_euclidean_vector<N> const&, fixed_euclidean_vector<N> const&)
+	   -> double = delete;
+	template<int N, int M>
+	requires(N != M)
+	auto operator==(fixed_euclidean_vector<N> const&, fixed_euclidean_vector<M> const&) -> bool
+	   = delete;
+	template<int N, int M>
+	requires(N != M)
+	auto dot(fixed_euclidean_vector<N> const&, fixed_euclidean_vector<M> const&) -> double = delete;
+	template<int N, int M>
+	requires(N != M)
+	auto squared_distance(fixed_euclidean_vector<N> const&, fixed_euclidean_vector<M> const&)
+	   -> double = delete;
+	template<int N, int M>
+	requires(N != M)
+	auto distance(fixed_euclidean_vector<N> const&, fixed_euclidean_vector<M> const&)
+	   -> double = delete;
+	template<int N, int M>
+	requires(N != M)
+	auto cosine_similarity(fixed_euclidean_vector<N> const&, fixed_euclidean_vector<M> const&)
+	   -> double = delete;
+} // namespace comp6771
+
+#endif // COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
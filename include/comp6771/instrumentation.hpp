@@ -0,0 +1,148 @@
+#ifndef COMP6771_INSTRUMENTATION_HPP
+#define COMP6771_INSTRUMENTATION_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Counts and times euclidean_vector's operations, for finding hot spots without a profiler.
+// Instrumentation is compiled in only when COMP6771_INSTRUMENTATION is defined to 1 (the CMake
+// option COMP6771_EUCLIDEAN_VECTOR_ENABLE_INSTRUMENTATION does this), and every translation unit
+// must agree on it. Otherwise the COMP6771_INSTRUMENT and COMP6771_COUNT hooks expand to nothing,
+// and collect() always returns zeroes.
+//
+// Each thread counts into its own counters, so instrumented operations never contend; collect()
+// totals every thread's, including those of threads that have exited.
+namespace comp6771::instrumentation {
+#if defined(COMP6771_INSTRUMENTATION) && COMP6771_INSTRUMENTATION
+	inline constexpr auto enabled = true;
+#else
+	inline constexpr auto enabled = false;
+#endif
+
+	enum class operation {
+		// every constructor except the copy and move constructors
+		construct,
+		copy,
+		move,
+		copy_assign,
+		move_assign,
+		// evaluating an arithmetic expression such as x + y * 2 into a euclidean_vector
+		evaluate,
+		add,
+		subtract,
+		multiply,
+		divide,
+		negate,
+		dot,
+		euclidean_norm,
+		unit,
+		normalize,
+	};
+	inline constexpr auto operation_count = std::size_t{15};
+
+	enum class event {
+		// heap allocations of magnitudes; vectors that fit inline do not allocate
+		allocation,
+		allocated_bytes,
+		// std::logic_errors thrown because two operands' dimensions differ
+		dimension_mismatch,
+	};
+	// euclidean_vector::cache_statistics() counts the norm cache's hits, misses and updates
+	inline constexpr auto event_count = std::size_t{3};
+
+	// Latency histograms have power-of-two buckets: bucket 0 counts calls that took under a
+	// nanosecond, bucket i calls that took [2^(i - 1), 2^i) nanoseconds, and the last bucket
+	// everything slower.
+	inline constexpr auto latency_buckets = std::size_t{32};
+
+	struct operation_statistics {
+		std::uint64_t calls = 0;
+		// magnitude bytes read and written; evaluate only counts those it writes
+		std::uint64_t bytes = 0;
+		std::uint64_t nanoseconds = 0;
+		std::array<std::uint64_t, latency_buckets> latency = {};
+
+		// an upper bound on the latency of the fraction `quantile` of calls, or 0 without calls
+		[[nodiscard]] auto latency_quantile(double quantile) const noexcept -> std::uint64_t;
+	};
+
+	struct snapshot {
+		std::array<operation_statistics, operation_count> operations = {};
+		std::array<std::uint64_t, event_count> events = {};
+
+		[[nodiscard]] auto operator[](operation op) const noexcept -> operation_statistics const& {
+			return operations[static_cast<std::size_t>(op)];
+		}
+
+		[[nodiscard]] auto operator[](event e) const noexcept -> std::uint64_t {
+			return events[static_cast<std::size_t>(e)];
+		}
+	};
+
+	[[nodiscard]] auto name(operation op) noexcept -> std::string_view;
+	[[nodiscard]] auto name(event e) noexcept -> std::string_view;
+
+	// totals every thread's counters
+	[[nodiscard]] auto collect() -> snapshot;
+	// Counters are reset while their threads may still be counting, so a concurrent operation may
+	// survive the reset.
+	auto reset() noexcept -> void;
+
+	// {"operations": {"<name>": {"calls", "bytes", "nanoseconds", "latency": [buckets]}, ...},
+	//  "events": {"<name>": count, ...}}, leaving out operations that were never called
+	[[nodiscard]] auto to_json(snapshot const& statistics) -> std::string;
+	// one row per operation that was called, then one per event, in fixed-width columns
+	[[nodiscard]] auto to_table(snapshot const& statistics) -> std::string;
+
+	namespace detail {
+		auto record(operation op, std::uint64_t bytes, std::uint64_t nanoseconds) noexcept -> void;
+		auto record(event e, std::uint64_t amount) noexcept -> void;
+
+		// records one call of `op` when it goes out of scope
+		class scoped_timer {
+		public:
+			scoped_timer(operation op, std::uint64_t bytes) noexcept
+			: op_{op}
+			, bytes_{bytes}
+			, start_{std::chrono::steady_clock::now()} {}
+
+			scoped_timer(scoped_timer const&) = delete;
+			auto operator=(scoped_timer const&) -> scoped_timer& = delete;
+
+			~scoped_timer() {
+				auto const elapsed = std::chrono::steady_clock::now() - start_;
+				record(op_,
+				       bytes_,
+				       static_cast<std::uint64_t>(
+				          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+			}
+
+		private:
+			operation op_;
+			std::uint64_t bytes_;
+			std::chrono::steady_clock::time_point start_;
+		};
+	} // namespace detail
+} // namespace comp6771::instrumentation
+
+// COMP6771_INSTRUMENT(kind, bytes) times the rest of the enclosing scope as one call of
+// operation::kind; COMP6771_COUNT(kind, amount) adds `amount` to event::kind. Neither evaluates
+// its arguments when instrumentation is disabled.
+#if defined(COMP6771_INSTRUMENTATION) && COMP6771_INSTRUMENTATION
+#define COMP6771_INSTRUMENT(kind, bytes)                                                          \
+	auto const comp6771_instrumentation_timer = ::comp6771::instrumentation::detail::scoped_timer( \
+	   ::comp6771::instrumentation::operation::kind,                                              \
+	   static_cast<std::uint64_t>(bytes))
+#define COMP6771_COUNT(kind, amount)                                                              \
+	::comp6771::instrumentation::detail::record(::comp6771::instrumentation::event::kind,         \
+	                                            static_cast<std::uint64_t>(amount))
+#else
+#define COMP6771_INSTRUMENT(kind, bytes) static_cast<void>(0)
+#define COMP6771_COUNT(kind, amount) static_cast<void>(0)
+#endif
+
+#endif // COMP6771_INSTRUMENTATION_HPP
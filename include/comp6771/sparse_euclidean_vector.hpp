@@ -0,0 +1,128 @@
+#ifndef COMP6771_SPARSE_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_SPARSE_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	// A euclidean_vector that stores only its non-zero magnitudes, as index/value pairs sorted by
+	// index, so memory and the cost of dot, euclidean_norm and arithmetic grow with the number of
+	// non-zeros rather than with the dimensions. Magnitudes that become exactly zero are dropped.
+	//
+	// Sparse vectors convert explicitly to and from euclidean_vector, and mixing vectors of
+	// different dimensions throws the same std::logic_error as euclidean_vector does. Dot products
+	// are accumulated in increasing index order, so they can differ in the last bits from the dense
+	// kernels, which sum in lanes.
+	class sparse_euclidean_vector {
+	public:
+		// one dimension, like euclidean_vector
+		sparse_euclidean_vector() noexcept;
+
+		// `dimensions` zeroes
+		explicit sparse_euclidean_vector(int dimensions) noexcept;
+
+		// magnitude values[i] at index indices[i]; the indices may come in any order, and repeated
+		// ones are summed. Throws std::logic_error if the spans differ in size and
+		// std::out_of_range if an index is not in [0, dimensions).
+		sparse_euclidean_vector(int dimensions,
+		                        std::span<int const> indices,
+		                        std::span<double const> values);
+
+		// the non-zero magnitudes of `vector`
+		explicit sparse_euclidean_vector(euclidean_vector_view vector);
+
+		// the magnitude at `dimension`, found by binary search
+		auto operator[](int dimension) const noexcept -> double;
+		// throws std::out_of_range unless `dimension` is in [0, dimensions())
+		[[nodiscard]] auto at(int dimension) const -> double;
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		[[nodiscard]] auto non_zeros() const noexcept -> int {
+			return static_cast<int>(indices_.size());
+		}
+
+		// the indices of the non-zero magnitudes, in increasing order
+		[[nodiscard]] auto indices() const noexcept -> std::span<int const> {
+			return indices_;
+		}
+
+		// the non-zero magnitudes, in the order of indices()
+		[[nodiscard]] auto values() const noexcept -> std::span<double const> {
+			return values_;
+		}
+
+		auto operator-() const -> sparse_euclidean_vector;
+		auto operator+=(sparse_euclidean_vector const& vector) -> sparse_euclidean_vector&;
+		auto operator-=(sparse_euclidean_vector const& vector) -> sparse_euclidean_vector&;
+		auto operator*=(double multiplier) -> sparse_euclidean_vector&;
+		auto operator/=(double divisor) -> sparse_euclidean_vector&;
+
+		explicit operator euclidean_vector() const;
+		explicit operator std::vector<double>() const;
+
+		friend auto operator==(sparse_euclidean_vector const&, sparse_euclidean_vector const&)
+		   -> bool = default;
+
+		friend auto operator+(sparse_euclidean_vector const& lhs, sparse_euclidean_vector const& rhs)
+		   -> sparse_euclidean_vector;
+		friend auto operator-(sparse_euclidean_vector const& lhs, sparse_euclidean_vector const& rhs)
+		   -> sparse_euclidean_vector;
+
+		friend auto operator*(sparse_euclidean_vector vector, double multiplier)
+		   -> sparse_euclidean_vector {
+			return vector *= multiplier;
+		}
+
+		friend auto operator*(double multiplier, sparse_euclidean_vector vector)
+		   -> sparse_euclidean_vector {
+			return vector *= multiplier;
+		}
+
+		friend auto operator/(sparse_euclidean_vector vector, double divisor)
+		   -> sparse_euclidean_vector {
+			return vector /= divisor;
+		}
+
+		// the same format as euclidean_vector, zeroes included
+		friend auto operator<<(std::ostream& os, sparse_euclidean_vector const& vector)
+		   -> std::ostream&;
+
+	private:
+		int dimension_;
+		std::vector<int> indices_;
+		std::vector<double> values_;
+
+		// erases magnitudes that arithmetic has made exactly zero
+		auto drop_zeros() -> void;
+
+		// the merge behind +=, -= and the binary operators: x + sign * y
+		static auto combine(sparse_euclidean_vector const& x,
+		                    sparse_euclidean_vector const& y,
+		                    double sign) -> sparse_euclidean_vector;
+	};
+
+	// When one vector has at least this many times as many non-zeros as the other, dot gallops
+	// through it (an exponential then a binary search per index of the smaller one) instead of
+	// merging the two, which makes the intersection O(m log(n / m)) instead of O(m + n).
+	inline constexpr auto galloping_ratio = std::size_t{16};
+
+	// Each of these throws std::logic_error if the dimensions differ.
+	auto dot(sparse_euclidean_vector const& x, sparse_euclidean_vector const& y) -> double;
+	auto dot(sparse_euclidean_vector const& x, euclidean_vector_view y) -> double;
+	auto dot(euclidean_vector_view x, sparse_euclidean_vector const& y) -> double;
+	// y += alpha * x, touching only the non-zeros of x
+	auto axpy(double alpha, sparse_euclidean_vector const& x, euclidean_vector_ref y) -> void;
+
+	// throws std::logic_error if `v` has no dimensions
+	auto euclidean_norm(sparse_euclidean_vector const& v) -> double;
+} // namespace comp6771
+
+#endif // COMP6771_SPARSE_EUCLIDEAN_VECTOR_HPP
@@ -0,0 +1,61 @@
+#ifndef COMP6771_THREAD_POOL_HPP
+#define COMP6771_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace comp6771 {
+	// A fixed set of worker threads that share out the indices of one loop at a time. Idle
+	// participants claim the next unclaimed index, so uneven chunks balance themselves.
+	class thread_pool {
+	public:
+		// `threads` counts the calling thread, so a pool of one thread starts no workers
+		explicit thread_pool(std::size_t threads);
+
+		thread_pool(thread_pool const&) = delete;
+		thread_pool(thread_pool&&) = delete;
+		auto operator=(thread_pool const&) -> thread_pool& = delete;
+		auto operator=(thread_pool&&) -> thread_pool& = delete;
+
+		~thread_pool();
+
+		// Calls task(i) once for every i below `count`, on the calling thread and the workers, and
+		// returns once every call has finished. Loops from different threads run one at a time.
+		// `task` must not throw.
+		auto run(std::size_t count, std::function<void(std::size_t)> const& task) -> void;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return workers_.size() + 1;
+		}
+
+	private:
+		std::mutex run_mutex_;
+		std::mutex mutex_;
+		std::condition_variable wake_;
+		std::condition_variable done_;
+		// bumped once per loop so that a worker never runs the same loop twice
+		std::size_t generation_ = 0;
+		std::size_t busy_ = 0;
+		bool stopping_ = false;
+		std::function<void(std::size_t)> const* task_ = nullptr;
+		std::size_t count_ = 0;
+		std::atomic<std::size_t> next_ = 0;
+		std::vector<std::jthread> workers_;
+
+		auto work() -> void;
+		auto drain(std::function<void(std::size_t)> const& task, std::size_t count) -> void;
+	};
+
+	// task(i) for every i below `count`, across the pool's threads, or in order on the calling
+	// thread if `pool` is null
+	auto for_each_index(thread_pool* pool,
+	                    std::size_t count,
+	                    std::function<void(std::size_t)> const& task) -> void;
+} // namespace comp6771
+
+#endif // COMP6771_THREAD_POOL_HPP
@@ -0,0 +1,99 @@
+#ifndef COMP6771_THREAD_REGISTRY_HPP
+#define COMP6771_THREAD_REGISTRY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace comp6771::detail {
+	// Adds to a counter that only its own thread writes. A relaxed load and store is enough to
+	// count, and other threads can still read the counter while they total it.
+	inline auto add(std::atomic<std::uint64_t>& counter, std::uint64_t const amount) noexcept
+	   -> void {
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	// Process-wide counts kept as one `Counters` per thread, so counting costs no synchronisation.
+	// `Counters` is nothrow default constructible and has add_to(Totals&) const noexcept and
+	// reset() noexcept; the totals of threads that have exited are kept.
+	template<typename Counters, typename Totals>
+	class thread_registry {
+		static_assert(std::is_nothrow_default_constructible_v<Counters>);
+
+	public:
+		// The calling thread's counters, registered the first time the thread asks for them. If
+		// registering fails the thread still counts, but total() leaves its counts out.
+		[[nodiscard]] static auto local() noexcept -> Counters& {
+			thread_local auto registration = registered();
+			return registration.counters;
+		}
+
+		// totals every thread's counters
+		[[nodiscard]] static auto total() -> Totals {
+			auto& all = instance();
+			auto const lock = std::scoped_lock(all.mutex_);
+			auto total = all.retired_;
+			for (auto const* const thread : all.threads_) {
+				thread->add_to(total);
+			}
+			return total;
+		}
+
+		// Counters are reset while their threads may still be counting, so a concurrent increment
+		// may survive the reset.
+		static auto reset() noexcept -> void {
+			auto& all = instance();
+			auto const lock = std::scoped_lock(all.mutex_);
+			all.retired_ = Totals();
+			for (auto* const thread : all.threads_) {
+				thread->reset();
+			}
+		}
+
+	private:
+		std::mutex mutex_;
+		std::vector<Counters*> threads_;
+		Totals retired_;
+
+		thread_registry() = default;
+
+		static auto instance() -> thread_registry& {
+			static auto registry = thread_registry();
+			return registry;
+		}
+
+		// a thread's counters, which it adds to the retired totals when it exits
+		struct registered {
+			Counters counters;
+			bool listed = false;
+
+			// counting happens in noexcept code, so a failure to register is swallowed
+			registered() noexcept {
+				try {
+					auto& all = instance();
+					auto const lock = std::scoped_lock(all.mutex_);
+					all.threads_.push_back(&counters);
+					listed = true;
+				} catch (...) {
+				}
+			}
+
+			registered(registered const&) = delete;
+			auto operator=(registered const&) -> registered& = delete;
+
+			~registered() {
+				if (not listed) {
+					return;
+				}
+				auto& all = instance();
+				auto const lock = std::scoped_lock(all.mutex_);
+				counters.add_to(all.retired_);
+				std::erase(all.threads_, &counters);
+			}
+		};
+	};
+} // namespace comp6771::detail
+
+#endif // COMP6771_THREAD_REGISTRY_HPP
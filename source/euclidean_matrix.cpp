@@ -0,0 +1,593 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define COMP6771_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+	using comp6771::batch_layout;
+	using comp6771::euclidean_matrix;
+	using comp6771::euclidean_vector_batch;
+	using comp6771::euclidean_vector_view;
+	using comp6771::for_each_index;
+	using comp6771::thread_pool;
+	using comp6771::kernels::simd_level;
+
+	// Products are blocked so that a block_depth x block_rows block of the matrix stays in the L2
+	// cache while every vector streams past it, and a tile of vectors' block_depth magnitudes stays
+	// in L1 while every tile of the block's rows streams past them.
+	constexpr auto block_depth = std::size_t{128};
+	constexpr auto block_rows = std::size_t{256};
+	// a task of a matrix-vector product; enough rows that their columns stream past in long runs
+	constexpr auto gemv_rows = std::size_t{512};
+
+	auto cast(int i) -> std::size_t {
+		return static_cast<std::size_t>(i);
+	}
+
+	// C = M X^T, where M is column-major and each row of X is one vector, so that row j of C is the
+	// transform of row j of X
+	struct product {
+		// rows x depth, column-major
+		double const* m;
+		std::size_t m_stride;
+		std::size_t rows;
+		std::size_t depth;
+		// vectors x depth, row-major
+		double const* x;
+		std::size_t x_stride;
+		std::size_t vectors;
+		// vectors x rows, row-major, and zero on entry
+		double* c;
+		std::size_t c_stride;
+	};
+
+	// Every kernel below computes each element as c = fma(m, x, c) for each dimension in order, so
+	// all of them agree bit for bit.
+
+	// y[i] += sum of m[p * m_stride + i] * x[p], for every i below `rows`
+	auto gemv_scalar(double* y,
+	                 double const* m,
+	                 std::size_t const m_stride,
+	                 double const* x,
+	                 std::size_t const rows,
+	                 std::size_t const depth) noexcept -> void {
+		for (auto p = std::size_t{0}; p < depth; ++p) {
+			auto const* const column = m + p * m_stride;
+			for (auto i = std::size_t{0}; i < rows; ++i) {
+				y[i] = std::fma(column[i], x[p], y[i]);
+			}
+		}
+	}
+
+	// The matrix's rows are packed into panels of Columns rows each, so that a tile's magnitudes
+	// for one dimension are adjacent: panel[p * Columns + i] is row i of the panel in dimension p.
+	// Rows past the end of the matrix are packed as zeroes.
+	template<std::size_t Columns>
+	auto pack(double* panels,
+	          product const& job,
+	          std::size_t const first_row,
+	          std::size_t const rows,
+	          std::size_t const first_dimension,
+	          std::size_t const depth) noexcept -> void {
+		for (auto r = std::size_t{0}; r < rows; r += Columns) {
+			auto* const panel = panels + r * depth;
+			auto const width = std::min(Columns, rows - r);
+			for (auto p = std::size_t{0}; p < depth; ++p) {
+				auto const* const column = job.m + (first_dimension + p) * job.m_stride + first_row + r;
+				std::copy_n(column, width, panel + p * Columns);
+				std::fill(panel + p * Columns + width, panel + (p + 1) * Columns, 0.0);
+			}
+		}
+	}
+
+	// c[r * c_stride + i] += sum of a[r * a_stride + p] * panel[p * Columns + i] for a full tile
+	struct scalar_tile {
+		static constexpr auto rows = std::size_t{4};
+		static constexpr auto columns = std::size_t{4};
+
+		static auto multiply(double* c,
+		                     std::size_t const c_stride,
+		                     double const* a,
+		                     std::size_t const a_stride,
+		                     double const* panel,
+		                     std::size_t const depth) noexcept -> void {
+			auto acc = std::array<std::array<double, columns>, rows>();
+			for (auto r = std::size_t{0}; r < rows; ++r) {
+				std::copy_n(c + r * c_stride, columns, acc[r].begin());
+			}
+			for (auto p = std::size_t{0}; p < depth; ++p) {
+				for (auto r = std::size_t{0}; r < rows; ++r) {
+					auto const x = a[r * a_stride + p];
+					for (auto i = std::size_t{0}; i < columns; ++i) {
+						acc[r][i] = std::fma(x, panel[p * columns + i], acc[r][i]);
+					}
+				}
+			}
+			for (auto r = std::size_t{0}; r < rows; ++r) {
+				std::copy_n(acc[r].begin(), columns, c + r * c_stride);
+			}
+		}
+	};
+
+#ifdef COMP6771_X86_KERNELS
+	[[gnu::target("avx2,fma")]] auto gemv_avx2(double* y,
+	                                           double const* m,
+	                                           std::size_t const m_stride,
+	                                           double const* x,
+	                                           std::size_t const rows,
+	                                           std::size_t const depth) noexcept -> void {
+		auto const vectorised = rows - rows % 4;
+		auto p = std::size_t{0};
+		// four columns at a time, so that y is loaded and stored once per four multiply-adds
+		for (; p + 4 <= depth; p += 4) {
+			auto const* const m0 = m + p * m_stride;
+			auto const* const m1 = m0 + m_stride;
+			auto const* const m2 = m1 + m_stride;
+			auto const* const m3 = m2 + m_stride;
+			auto const x0 = _mm256_set1_pd(x[p]);
+			auto const x1 = _mm256_set1_pd(x[p + 1]);
+			auto const x2 = _mm256_set1_pd(x[p + 2]);
+			auto const x3 = _mm256_set1_pd(x[p + 3]);
+			for (auto i = std::size_t{0}; i < vectorised; i += 4) {
+				auto acc = _mm256_loadu_pd(y + i);
+				acc = _mm256_fmadd_pd(_mm256_loadu_pd(m0 + i), x0, acc);
+				acc = _mm256_fmadd_pd(_mm256_loadu_pd(m1 + i), x1, acc);
+				acc = _mm256_fmadd_pd(_mm256_loadu_pd(m2 + i), x2, acc);
+				acc = _mm256_fmadd_pd(_mm256_loadu_pd(m3 + i), x3, acc);
+				_mm256_storeu_pd(y + i, acc);
+			}
+		}
+		for (; p < depth; ++p) {
+			auto const* const column = m + p * m_stride;
+			auto const xp = _mm256_set1_pd(x[p]);
+			for (auto i = std::size_t{0}; i < vectorised; i += 4) {
+				auto const acc = _mm256_loadu_pd(y + i);
+				_mm256_storeu_pd(y + i, _mm256_fmadd_pd(_mm256_loadu_pd(column + i), xp, acc));
+			}
+		}
+		gemv_scalar(y + vectorised, m + vectorised, m_stride, x, rows - vectorised, depth);
+	}
+
+	// one row of a tile: eight columns in two registers
+	struct tile_row_avx2 {
+		__m256d low;
+		__m256d high;
+	};
+
+	struct avx2_tile {
+		static constexpr auto rows = std::size_t{6};
+		static constexpr auto columns = std::size_t{8};
+
+		[[gnu::target("avx2,fma")]] static auto multiply(double* c,
+		                                                 std::size_t const c_stride,
+		                                                 double const* a,
+		                                                 std::size_t const a_stride,
+		                                                 double const* panel,
+		                                                 std::size_t const depth) noexcept -> void {
+			// Twelve accumulators, two panel registers and a broadcast fit in the sixteen registers.
+			// The loops over rows are unrolled so that the accumulators stay in registers.
+			auto acc = std::array<tile_row_avx2, rows>();
+#pragma GCC unroll 8
+			for (auto r = std::size_t{0}; r < rows; ++r) {
+				acc[r] = {_mm256_loadu_pd(c + r * c_stride), _mm256_loadu_pd(c + r * c_stride + 4)};
+			}
+			for (auto p = std::size_t{0}; p < depth; ++p) {
+				auto const low = _mm256_loadu_pd(panel + p * columns);
+				auto const high = _mm256_loadu_pd(panel + p * columns + 4);
+#pragma GCC unroll 8
+				for (auto r = std::size_t{0}; r < rows; ++r) {
+					auto const x = _mm256_broadcast_sd(a + r * a_stride + p);
+					acc[r].low = _mm256_fmadd_pd(x, low, acc[r].low);
+					acc[r].high = _mm256_fmadd_pd(x, high, acc[r].high);
+				}
+			}
+#pragma GCC unroll 8
+			for (auto r = std::size_t{0}; r < rows; ++r) {
+				_mm256_storeu_pd(c + r * c_stride, acc[r].low);
+				_mm256_storeu_pd(c + r * c_stride + 4, acc[r].high);
+			}
+		}
+	};
+
+	[[gnu::target("avx512f")]] auto gemv_avx512(double* y,
+	                                            double const* m,
+	                                            std::size_t const m_stride,
+	                                            double const* x,
+	                                            std::size_t const rows,
+	                                            std::size_t const depth) noexcept -> void {
+		auto const vectorised = rows - rows % 8;
+		auto p = std::size_t{0};
+		for (; p + 4 <= depth; p += 4) {
+			auto const* const m0 = m + p * m_stride;
+			auto const* const m1 = m0 + m_stride;
+			auto const* const m2 = m1 + m_stride;
+			auto const* const m3 = m2 + m_stride;
+			auto const x0 = _mm512_set1_pd(x[p]);
+			auto const x1 = _mm512_set1_pd(x[p + 1]);
+			auto const x2 = _mm512_set1_pd(x[p + 2]);
+			auto const x3 = _mm512_set1_pd(x[p + 3]);
+			for (auto i = std::size_t{0}; i < vectorised; i += 8) {
+				auto acc = _mm512_loadu_pd(y + i);
+				acc = _mm512_fmadd_pd(_mm512_loadu_pd(m0 + i), x0, acc);
+				acc = _mm512_fmadd_pd(_mm512_loadu_pd(m1 + i), x1, acc);
+				acc = _mm512_fmadd_pd(_mm512_loadu_pd(m2 + i), x2, acc);
+				acc = _mm512_fmadd_pd(_mm512_loadu_pd(m3 + i), x3, acc);
+				_mm512_storeu_pd(y + i, acc);
+			}
+		}
+		for (; p < depth; ++p) {
+			auto const* const column = m + p * m_stride;
+			auto const xp = _mm512_set1_pd(x[p]);
+			for (auto i = std::size_t{0}; i < vectorised; i += 8) {
+				auto const acc = _mm512_loadu_pd(y + i);
+				_mm512_storeu_pd(y + i, _mm512_fmadd_pd(_mm512_loadu_pd(column + i), xp, acc));
+			}
+		}
+		gemv_scalar(y + vectorised, m + vectorised, m_stride, x, rows - vectorised, depth);
+	}
+
+	// one row of a tile: sixteen columns in two registers
+	struct tile_row_avx512 {
+		__m512d low;
+		__m512d high;
+	};
+
+	struct avx512_tile {
+		static constexpr auto rows = std::size_t{8};
+		static constexpr auto columns = std::size_t{16};
+
+		[[gnu::target("avx512f")]] static auto multiply(double* c,
+		                                                std::size_t const c_stride,
+		                                                double const* a,
+		                                                std::size_t const a_stride,
+		                                                double const* panel,
+		                                                std::size_t const depth) noexcept -> void {
+			auto acc = std::array<tile_row_avx512, rows>();
+#pragma GCC unroll 8
+			for (auto r = std::size_t{0}; r < rows; ++r) {
+				acc[r] = {_mm512_loadu_pd(c + r * c_stride), _mm512_loadu_pd(c + r * c_stride + 8)};
+			}
+			for (auto p = std::size_t{0}; p < depth; ++p) {
+				auto const low = _mm512_loadu_pd(panel + p * columns);
+				auto const high = _mm512_loadu_pd(panel + p * columns + 8);
+#pragma GCC unroll 8
+				for (auto r = std::size_t{0}; r < rows; ++r) {
+					auto const x = _mm512_set1_pd(a[r * a_stride + p]);
+					acc[r].low = _mm512_fmadd_pd(x, low, acc[r].low);
+					acc[r].high = _mm512_fmadd_pd(x, high, acc[r].high);
+				}
+			}
+#pragma GCC unroll 8
+			for (auto r = std::size_t{0}; r < rows; ++r) {
+				_mm512_storeu_pd(c + r * c_stride, acc[r].low);
+				_mm512_storeu_pd(c + r * c_stride + 8, acc[r].high);
+			}
+		}
+	};
+#endif // COMP6771_X86_KERNELS
+
+	// Multiplies the rows [first_row, first_row + rows) of the matrix by the vectors
+	// [first_vector, first_vector + vectors). Tiles cut short by the edge of the matrix or of the
+	// vectors are copied into full-sized scratch tiles, so that Tile only handles full tiles.
+	template<typename Tile>
+	auto multiply_block(product const& job,
+	                    std::size_t const first_row,
+	                    std::size_t const rows,
+	                    std::size_t const first_vector,
+	                    std::size_t const vectors) -> void {
+		static_assert(block_rows % Tile::columns == 0);
+		thread_local auto panels = std::vector<double>();
+		panels.resize(block_rows * block_depth);
+		auto edge_a = std::array<double, Tile::rows * block_depth>();
+		auto edge_c = std::array<double, Tile::rows * Tile::columns>();
+		for (auto p0 = std::size_t{0}; p0 < job.depth; p0 += block_depth) {
+			auto const depth = std::min(block_depth, job.depth - p0);
+			pack<Tile::columns>(panels.data(), job, first_row, rows, p0, depth);
+			for (auto j = first_vector; j < first_vector + vectors; j += Tile::rows) {
+				auto const tile_rows = std::min(Tile::rows, first_vector + vectors - j);
+				auto const* a = job.x + j * job.x_stride + p0;
+				auto a_stride = job.x_stride;
+				if (tile_rows < Tile::rows) {
+					edge_a.fill(0.0);
+					for (auto r = std::size_t{0}; r < tile_rows; ++r) {
+						std::copy_n(a + r * a_stride, depth, edge_a.data() + r * depth);
+					}
+					a = edge_a.data();
+					a_stride = depth;
+				}
+				for (auto i = std::size_t{0}; i < rows; i += Tile::columns) {
+					auto const tile_columns = std::min(Tile::columns, rows - i);
+					auto* const c = job.c + j * job.c_stride + first_row + i;
+					auto const* const panel = panels.data() + i * depth;
+					if (tile_rows == Tile::rows and tile_columns == Tile::columns) {
+						Tile::multiply(c, job.c_stride, a, a_stride, panel, depth);
+						continue;
+					}
+					edge_c.fill(0.0);
+					auto* const edge = edge_c.data();
+					for (auto r = std::size_t{0}; r < tile_rows; ++r) {
+						std::copy_n(c + r * job.c_stride, tile_columns, edge + r * Tile::columns);
+					}
+					Tile::multiply(edge, Tile::columns, a, a_stride, panel, depth);
+					for (auto r = std::size_t{0}; r < tile_rows; ++r) {
+						std::copy_n(edge + r * Tile::columns, tile_columns, c + r * job.c_stride);
+					}
+				}
+			}
+		}
+	}
+
+	// Shares blocks of block_rows rows by a few hundred vectors out across the pool. Each task
+	// packs its own panels, which costs a small fraction of its multiply-adds.
+	template<typename Tile>
+	auto multiply_with(product const& job, thread_pool* pool) -> void {
+		constexpr auto task_vectors = Tile::rows * 32;
+		auto const row_blocks = (job.rows + block_rows - 1) / block_rows;
+		auto const vector_blocks = (job.vectors + task_vectors - 1) / task_vectors;
+		for_each_index(pool, row_blocks * vector_blocks, [&](std::size_t const t) {
+			auto const first_row = t % row_blocks * block_rows;
+			auto const first_vector = t / row_blocks * task_vectors;
+			multiply_block<Tile>(job,
+			                     first_row,
+			                     std::min(block_rows, job.rows - first_row),
+			                     first_vector,
+			                     std::min(task_vectors, job.vectors - first_vector));
+		});
+	}
+
+	// SSE2 has no fused multiply-add, so it uses the scalar kernels, like kernels::fused_scale_add
+	auto multiply(product const& job, thread_pool* pool) -> void {
+		if (job.rows == 0 or job.vectors == 0 or job.depth == 0) {
+			return;
+		}
+		switch (comp6771::kernels::active_simd_level()) {
+#ifdef COMP6771_X86_KERNELS
+		case simd_level::avx512: return multiply_with<avx512_tile>(job, pool);
+		case simd_level::avx2: return multiply_with<avx2_tile>(job, pool);
+#endif // COMP6771_X86_KERNELS
+		default: return multiply_with<scalar_tile>(job, pool);
+		}
+	}
+
+	using gemv_kernel = auto (*)(double*,
+	                             double const*,
+	                             std::size_t,
+	                             double const*,
+	                             std::size_t,
+	                             std::size_t) noexcept -> void;
+
+	auto gemv_for(simd_level const level) noexcept -> gemv_kernel {
+		switch (level) {
+#ifdef COMP6771_X86_KERNELS
+		case simd_level::avx512: return gemv_avx512;
+		case simd_level::avx2: return gemv_avx2;
+#endif // COMP6771_X86_KERNELS
+		default: return gemv_scalar;
+		}
+	}
+
+	// A strided vector is gathered into `scratch` so that the SIMD kernels can read it.
+	auto contiguous(euclidean_vector_view x, std::vector<double>& scratch) -> double const* {
+		if (x.is_contiguous()) {
+			return x.data();
+		}
+		scratch = static_cast<std::vector<double>>(x);
+		return scratch.data();
+	}
+
+	auto transform_vector(euclidean_matrix const& m, euclidean_vector_view x, thread_pool* pool)
+	   -> comp6771::euclidean_vector {
+		if (m.columns() != x.dimensions()) {
+			comp6771::detail::throw_dimension_mismatch(m.columns(), x.dimensions());
+		}
+		auto result = comp6771::euclidean_vector(m.rows());
+		if (m.rows() == 0) {
+			return result;
+		}
+		auto scratch = std::vector<double>();
+		auto const* const magnitudes = contiguous(x, scratch);
+		auto* const y = &result[0];
+		auto const rows = cast(m.rows());
+		auto const gemv = gemv_for(comp6771::kernels::active_simd_level());
+		for_each_index(pool, (rows + gemv_rows - 1) / gemv_rows, [&](std::size_t const t) {
+			auto const first = t * gemv_rows;
+			gemv(y + first,
+			     m.data() + first,
+			     m.leading_dimension(),
+			     magnitudes,
+			     std::min(gemv_rows, rows - first),
+			     cast(m.columns()));
+		});
+		return result;
+	}
+
+	// transform(m, vectors[i]) for every row into `result`, which is already row_major with a row
+	// per vector
+	auto transform_rows(euclidean_matrix const& m,
+	                    euclidean_vector_batch const& vectors,
+	                    euclidean_vector_batch& result,
+	                    thread_pool* pool) -> void {
+		multiply(product{m.data(),
+		                 m.leading_dimension(),
+		                 cast(m.rows()),
+		                 cast(m.columns()),
+		                 vectors.data(),
+		                 vectors.leading_dimension(),
+		                 cast(vectors.size()),
+		                 result.data(),
+		                 result.leading_dimension()},
+		         pool);
+	}
+
+	auto transform_batch(euclidean_matrix const& m,
+	                     euclidean_vector_batch const& vectors,
+	                     thread_pool* pool) -> euclidean_vector_batch {
+		if (m.columns() != vectors.dimensions()) {
+			comp6771::detail::throw_dimension_mismatch(m.columns(), vectors.dimensions());
+		}
+		if (vectors.layout() == batch_layout::column_major) {
+			return transform_batch(m, vectors.to_layout(batch_layout::row_major), pool)
+			   .to_layout(batch_layout::column_major);
+		}
+		auto result = euclidean_vector_batch(vectors.size(),
+		                                     m.rows(),
+		                                     batch_layout::row_major,
+		                                     vectors.get_allocator());
+		transform_rows(m, vectors, result, pool);
+		return result;
+	}
+
+	auto transform_batch_into(euclidean_matrix const& m,
+	                          euclidean_vector_batch const& vectors,
+	                          euclidean_vector_batch& result,
+	                          thread_pool* pool) -> void {
+		if (m.columns() != vectors.dimensions()) {
+			comp6771::detail::throw_dimension_mismatch(m.columns(), vectors.dimensions());
+		}
+		if (m.rows() != result.dimensions()) {
+			comp6771::detail::throw_dimension_mismatch(m.rows(), result.dimensions());
+		}
+		if (vectors.size() != result.size() or result.layout() != batch_layout::row_major) {
+			throw std::logic_error("a transform's result must be a row_major batch with a row for "
+			                       "each vector");
+		}
+		// the result is zeroed before the vectors are read, so it cannot be one of them
+		if (&result == &vectors) {
+			throw std::logic_error("a transform's result must not be the vectors it transforms");
+		}
+		// the products accumulate into the result, as they would into a new, zeroed batch
+		std::fill_n(result.data(), result.leading_dimension() * cast(result.size()), 0.0);
+		if (vectors.layout() == batch_layout::column_major) {
+			transform_rows(m, vectors.to_layout(batch_layout::row_major), result, pool);
+			return;
+		}
+		transform_rows(m, vectors, result, pool);
+	}
+
+	// Column j of a b is a times column j of b, and both are stored column by column, so the
+	// columns of b are the vectors of the product and the columns of the result its output.
+	auto multiply_matrices(euclidean_matrix const& a, euclidean_matrix const& b, thread_pool* pool)
+	   -> euclidean_matrix {
+		if (a.columns() != b.rows()) {
+			comp6771::detail::throw_dimension_mismatch(a.columns(), b.rows());
+		}
+		auto result = euclidean_matrix(a.rows(), b.columns(), a.get_allocator());
+		multiply(product{a.data(),
+		                 a.leading_dimension(),
+		                 cast(a.rows()),
+		                 cast(a.columns()),
+		                 b.data(),
+		                 b.leading_dimension(),
+		                 cast(b.columns()),
+		                 result.data(),
+		                 result.leading_dimension()},
+		         pool);
+		return result;
+	}
+} // namespace
+
+namespace comp6771 {
+	euclidean_matrix::euclidean_matrix(int rows, int columns, allocator_type const& allocator)
+	: rows_(rows, columns, batch_layout::column_major, allocator) {}
+
+	euclidean_matrix::euclidean_matrix(std::initializer_list<std::initializer_list<double>> rows)
+	: rows_(static_cast<int>(rows.size()),
+	        rows.size() == 0 ? 0 : static_cast<int>(rows.begin()->size()),
+	        batch_layout::column_major) {
+		auto r = 0;
+		for (auto const& row : rows) {
+			rows_.assign(r, std::span<double const>(row.begin(), row.size()));
+			++r;
+		}
+	}
+
+	euclidean_matrix::euclidean_matrix(std::span<euclidean_vector const> rows,
+	                                   allocator_type const& allocator)
+	: rows_(rows, batch_layout::column_major, allocator) {}
+
+	euclidean_matrix::euclidean_matrix(euclidean_vector_batch const& rows,
+	                                   allocator_type const& allocator)
+	: rows_(rows.size(), rows.dimensions(), batch_layout::column_major, allocator) {
+		for (auto r = 0; r < rows.size(); ++r) {
+			rows_.assign(r, rows[r]);
+		}
+	}
+
+	auto euclidean_matrix::identity(int size) -> euclidean_matrix {
+		auto result = euclidean_matrix(size, size);
+		for (auto i = 0; i < size; ++i) {
+			result(i, i) = 1.0;
+		}
+		return result;
+	}
+
+	auto euclidean_matrix::transpose() const -> euclidean_matrix {
+		auto result = euclidean_matrix(columns(), rows(), get_allocator());
+		// column c of this matrix is row c of the result
+		for (auto c = 0; c < columns(); ++c) {
+			result[c] = column(c);
+		}
+		return result;
+	}
+
+	auto euclidean_matrix::to_batch() const -> euclidean_vector_batch {
+		return rows_.to_layout(batch_layout::row_major);
+	}
+
+	auto transform(euclidean_matrix const& m, euclidean_vector_view x) -> euclidean_vector {
+		return transform_vector(m, x, nullptr);
+	}
+
+	auto transform(euclidean_matrix const& m, euclidean_vector_view x, thread_pool& pool)
+	   -> euclidean_vector {
+		return transform_vector(m, x, &pool);
+	}
+
+	auto transform(euclidean_matrix const& m, euclidean_vector_batch const& vectors)
+	   -> euclidean_vector_batch {
+		return transform_batch(m, vectors, nullptr);
+	}
+
+	auto transform(euclidean_matrix const& m,
+	               euclidean_vector_batch const& vectors,
+	               thread_pool& pool) -> euclidean_vector_batch {
+		return transform_batch(m, vectors, &pool);
+	}
+
+	auto transform(euclidean_matrix const& m,
+	               euclidean_vector_batch const& vectors,
+	               euclidean_vector_batch& result) -> void {
+		transform_batch_into(m, vectors, result, nullptr);
+	}
+
+	auto transform(euclidean_matrix const& m,
+	               euclidean_vector_batch const& vectors,
+	               euclidean_vector_batch& result,
+	               thread_pool& pool) -> void {
+		transform_batch_into(m, vectors, result, &pool);
+	}
+
+	auto multiply(euclidean_matrix const& a, euclidean_matrix const& b) -> euclidean_matrix {
+		return multiply_matrices(a, b, nullptr);
+	}
+
+	auto multiply(euclidean_matrix const& a, euclidean_matrix const& b, thread_pool& pool)
+	   -> euclidean_matrix {
+		return multiply_matrices(a, b, &pool);
+	}
+} // namespace comp6771
@@ -2,9 +2,15 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
 #include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/instrumentation.hpp"
+#include "comp6771/thread_registry.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <fmt/format.h>
 #include <functional>
 #include <gsl/gsl-lite.hpp>
@@ -16,6 +22,8 @@
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 // private helper functions for now
 namespace {
 
@@ -24,24 +32,81 @@ namespace {
 		return (a.dimensions() != b.dimensions());
 	}
 
-	// ass2 spec requires we use double[]
-	// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-	auto initialize_magnitude(int dimensions, double magnitude) -> std::unique_ptr<double[]> {
-		// ass2 spec requires we use double[]
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		auto retval = std::make_unique<double[]>(gsl_lite::narrow_cast<size_t>(dimensions));
-		ranges::fill(retval.get(), retval.get() + dimensions, magnitude);
-		return retval;
-	}
-
 	auto cast(int i) -> size_t {
 		return gsl_lite::narrow_cast<size_t>(i);
 	}
 
+	// the size of `vectors` passes over `dimensions` magnitudes, for instrumentation
+	[[maybe_unused]] auto bytes(int const dimensions, int const vectors) -> size_t {
+		return cast(dimensions) * cast(vectors) * sizeof(double);
+	}
+
+	// the norm of a vector that has a unit vector
+	auto unit_norm(comp6771::euclidean_vector const& v) -> double {
+		if (v.dimensions() == 0) {
+			comp6771::detail::throw_no_unit_vector(0);
+		}
+		auto const norm = comp6771::euclidean_norm(v);
+		if (norm == 0) {
+			comp6771::detail::throw_no_unit_vector(v.dimensions());
+		}
+		return norm;
+	}
+
+	// Below this, the sum of squares may have been rounded by subnormal terms that rescaling would
+	// round differently.
+	constexpr auto smallest_rescaled = 0x1p-900;
+
+	// one thread's norm cache counters, which comp6771::detail::thread_registry totals
+	struct thread_statistics {
+		std::atomic<std::uint64_t> hits = 0;
+		std::atomic<std::uint64_t> misses = 0;
+		std::atomic<std::uint64_t> updates = 0;
+
+		auto add_to(comp6771::norm_cache_statistics& total) const noexcept -> void {
+			total.hits += hits.load(std::memory_order_relaxed);
+			total.misses += misses.load(std::memory_order_relaxed);
+			total.updates += updates.load(std::memory_order_relaxed);
+		}
+
+		auto reset() noexcept -> void {
+			hits.store(0, std::memory_order_relaxed);
+			misses.store(0, std::memory_order_relaxed);
+			updates.store(0, std::memory_order_relaxed);
+		}
+	};
+
+	using registry =
+	   comp6771::detail::thread_registry<thread_statistics, comp6771::norm_cache_statistics>;
+
+	// a norm that was (`hit`) or was not found in the cache
+	auto count_lookup(bool const hit) noexcept -> void {
+		auto& statistics = registry::local();
+		comp6771::detail::add(hit ? statistics.hits : statistics.misses, 1);
+	}
+
+	auto count_update() noexcept -> void {
+		comp6771::detail::add(registry::local().updates, 1);
+	}
+
 } // namespace
 
 namespace comp6771 {
 
+	auto detail::throw_dimension_mismatch(int lhs, int rhs) -> void {
+		COMP6771_COUNT(dimension_mismatch, 1);
+		throw std::logic_error(
+		   fmt::format("Dimensions of LHS({}) and RHS({}) do not match", lhs, rhs));
+	}
+
+	auto detail::throw_no_unit_vector(int const dimensions) -> void {
+		if (dimensions == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a unit vector");
+		}
+		throw std::logic_error("euclidean_vector with zero euclidean normal does not have a unit "
+		                       "vector");
+	}
+
 	euclidean_vector::~euclidean_vector() noexcept {
 		magnitude_.reset();
 	};
@@ -49,92 +114,120 @@ namespace comp6771 {
 	// constructors
 	euclidean_vector::euclidean_vector() noexcept
 	: dimension_{1} {
-		// ass2 spec requires we use double[]
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		this->magnitude_ = std::make_unique<double[]>(1);
-		this->magnitude_[0] = 0.0;
-		this->mag_cache_ = -1;
+		COMP6771_INSTRUMENT(construct, bytes(1, 1));
+		this->inline_magnitude_[0] = 0.0;
 	}
 
 	euclidean_vector::euclidean_vector(int dimension) noexcept
-	: dimension_{dimension}
-	, magnitude_{initialize_magnitude(dimension, 0)}
-	, mag_cache_{-1} {}
-	// namespace comp6771
+	: euclidean_vector(dimension, 0.0) {}
 
 	euclidean_vector::euclidean_vector(int dimension, double magnitude) noexcept
+	: euclidean_vector(dimension, magnitude, allocator_type()) {}
+
+	euclidean_vector::euclidean_vector(int dimension, allocator_type const& allocator) noexcept
+	: euclidean_vector(dimension, 0.0, allocator) {}
+
+	euclidean_vector::euclidean_vector(int dimension,
+	                                   double magnitude,
+	                                   allocator_type const& allocator) noexcept
 	: dimension_{dimension}
-	, magnitude_{initialize_magnitude(dimension, magnitude)}
-	, mag_cache_{-1} {}
+	, magnitude_{allocate_magnitude(dimension, allocator.resource())} {
+		COMP6771_INSTRUMENT(construct, bytes(dimension, 1));
+		ranges::fill(this->storage(), this->storage() + dimension, magnitude);
+	}
+
+	euclidean_vector::euclidean_vector(uninitialized_t,
+	                                   int dimension,
+	                                   allocator_type const& allocator) noexcept
+	: dimension_{dimension}
+	, magnitude_{allocate_magnitude(dimension, allocator.resource())} {
+		COMP6771_INSTRUMENT(construct, 0);
+	}
 
 	euclidean_vector::euclidean_vector(std::vector<double>::const_iterator start,
 	                                   std::vector<double>::const_iterator end) noexcept {
+		COMP6771_INSTRUMENT(construct, bytes(gsl_lite::narrow_cast<int>(end - start), 2));
 		this->dimension_ = gsl_lite::narrow_cast<int>(std::distance(start, end));
-		// ass2 spec requires we use double[]
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		this->magnitude_ = std::make_unique<double[]>(cast(this->dimension_));
-		std::transform(start, end, this->magnitude_.get(), [](auto const& a) -> double { return a; });
-		this->mag_cache_ = -1;
+		this->magnitude_ = allocate_magnitude(this->dimension_, std::pmr::get_default_resource());
+		std::copy(start, end, this->storage());
 	}
 
 	euclidean_vector::euclidean_vector(std::initializer_list<double> init_list) noexcept {
+		COMP6771_INSTRUMENT(construct, bytes(gsl_lite::narrow_cast<int>(init_list.size()), 2));
 		this->dimension_ = gsl::narrow<int>(std::size(init_list));
-		// ass2 spec requires we use double[]
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		this->magnitude_ = std::make_unique<double[]>(cast(this->dimension_));
-		std::transform(init_list.begin(),
-		               init_list.end(),
-		               this->magnitude_.get(),
-		               [](auto const& a) -> double { return a; });
-		this->mag_cache_ = -1;
+		this->magnitude_ = allocate_magnitude(this->dimension_, std::pmr::get_default_resource());
+		std::copy(init_list.begin(), init_list.end(), this->storage());
 	}
 
 	euclidean_vector::euclidean_vector(euclidean_vector const& copy_from) noexcept
-	: dimension_{copy_from.dimension_} {
-		// ass2 spec requires we use double[]
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		this->magnitude_ = std::make_unique<double[]>(cast(copy_from.dimension_));
-		auto size = copy_from.dimensions();
-		std::transform(copy_from.magnitude_.get(),
-		               copy_from.magnitude_.get() + size,
-		               this->magnitude_.get(),
-		               [](auto const& a) -> double { return a; });
-		this->mag_cache_ = -1;
+	: euclidean_vector(copy_from, allocator_type()) {}
+
+	euclidean_vector::euclidean_vector(euclidean_vector const& copy_from,
+	                                   allocator_type const& allocator) noexcept
+	: dimension_{copy_from.dimension_}
+	, magnitude_{allocate_magnitude(copy_from.dimension_, allocator.resource())} {
+		COMP6771_INSTRUMENT(copy, bytes(copy_from.dimension_, 2));
+		kernels::copy(this->storage(), copy_from.data(), cast(copy_from.dimension_));
+		this->copy_norm_cache(copy_from);
 	}
 
 	euclidean_vector::euclidean_vector(euclidean_vector&& move_from) noexcept
 	: dimension_{std::exchange(move_from.dimension_, 0)}
 	, magnitude_{std::move(move_from.magnitude_)}
-	, mag_cache_{move_from.mag_cache_} {}
+	, squared_norm_cache_{move_from.cached_squared_norm()} {
+		COMP6771_INSTRUMENT(move, this->magnitude_ == nullptr ? bytes(this->dimension_, 2) : 0);
+		// inline magnitudes cannot be stolen, but there are at most inline_capacity of them
+		if (this->magnitude_ == nullptr) {
+			std::copy_n(move_from.inline_magnitude_.data(), this->dimension_, this->storage());
+		}
+	}
 
 	// operator overloading
 
+	// Assignment never changes the destination's memory resource: an arena-backed vector stays in
+	// its arena, and a long-lived vector never adopts storage from an arena that may be released.
 	auto euclidean_vector::operator=(euclidean_vector const& copy_from) noexcept -> euclidean_vector& {
-		auto copy = copy_from;
-		std::swap(copy, *this);
+		COMP6771_INSTRUMENT(copy_assign, bytes(copy_from.dimension_, 2));
+		if (this != &copy_from) {
+			this->prepare_storage(copy_from.dimension_);
+			kernels::copy(this->storage(), copy_from.data(), cast(copy_from.dimension_));
+			this->copy_norm_cache(copy_from);
+		}
 		return *this;
 	}
 
 	auto euclidean_vector::operator=(euclidean_vector&& source) noexcept -> euclidean_vector& {
-		std::swap(this->dimension_, source.dimension_);
-		std::swap(this->magnitude_, source.magnitude_);
-		std::swap(this->mag_cache_, source.mag_cache_);
-		// to clear it i guess just set it to 0/empty
-		source.dimension_ = 0;
-		source.magnitude_.reset(nullptr);
+		if (this == &source) {
+			return *this;
+		}
+		if (*this->magnitude_.get_deleter().resource != *source.magnitude_.get_deleter().resource) {
+			// counted as the copy assignment it is
+			*this = source;
+			source.dimension_ = 0;
+			source.magnitude_.reset();
+			return *this;
+		}
+		COMP6771_INSTRUMENT(move_assign,
+		                    source.magnitude_ == nullptr ? bytes(source.dimension_, 2) : 0);
+		this->dimension_ = std::exchange(source.dimension_, 0);
+		this->magnitude_ = std::move(source.magnitude_);
+		this->copy_norm_cache(source);
+		if (this->magnitude_ == nullptr) {
+			std::copy_n(source.inline_magnitude_.data(), this->dimension_, this->storage());
+		}
 
 		return *this;
 	}
 
 	auto euclidean_vector::operator[](int i) const noexcept -> double {
 		assert(i >= 0 and this->dimension_ >= i);
-		return this->magnitude_[cast(i)];
+		return this->data()[cast(i)];
 	}
 
 	auto euclidean_vector::operator[](int i) noexcept -> double& {
 		assert(i >= 0 and euclidean_vector::dimensions() >= i);
-		this->mag_cache_ = -1;
-		return this->magnitude_[cast(i)];
+		this->invalidate_norm();
+		return this->storage()[cast(i)];
 	}
 
 	auto euclidean_vector::operator+() const noexcept -> euclidean_vector {
@@ -142,78 +235,66 @@ namespace comp6771 {
 		return return_vector;
 	}
 
-	auto euclidean_vector::operator-() noexcept -> euclidean_vector {
-		auto return_vector = euclidean_vector(*this);
-		std::for_each (return_vector.magnitude_.get(),
-		               return_vector.magnitude_.get() + return_vector.dimension_,
-		               [](double& a) -> double { return -a; });
+	auto euclidean_vector::operator-() const& noexcept -> euclidean_vector {
+		return -euclidean_vector(*this);
+	}
 
-		return return_vector;
+	// negation is exact, so the cached norm stays valid
+	auto euclidean_vector::operator-() && noexcept -> euclidean_vector {
+		COMP6771_INSTRUMENT(negate, bytes(this->dimension_, 2));
+		kernels::multiply(this->storage(), this->data(), -1.0, cast(this->dimension_));
+		return std::move(*this);
 	}
 
 	auto euclidean_vector::operator+=(euclidean_vector const& vector) -> euclidean_vector& {
+		COMP6771_INSTRUMENT(add, bytes(this->dimension_, 3));
 		if (this->dimension_ != vector.dimension_) {
-			throw std::logic_error(fmt::format("Dimensions of LHS({}) and RHS({}) do not match",
-			                                   this->dimensions(),
-			                                   vector.dimensions()));
+			detail::throw_dimension_mismatch(this->dimensions(), vector.dimensions());
 		}
-		for (auto i = 0; i < this->dimension_; ++i) {
-			this->magnitude_[cast(i)] = this->magnitude_[cast(i)] + vector.magnitude_[cast(i)];
-		}
-
-		this->mag_cache_ = -1;
+		kernels::add(this->storage(), this->data(), vector.data(), cast(this->dimension_));
+		// Updating the cache would need dot(*this, vector): a pass as long as recomputing the norm
+		// when it is next asked for, and inaccurate when the vectors nearly cancel.
+		this->invalidate_norm();
 		return *this;
 	}
 
 	auto euclidean_vector::operator-=(euclidean_vector const& vector) -> euclidean_vector& {
+		COMP6771_INSTRUMENT(subtract, bytes(this->dimension_, 3));
 		if (this->dimension_ != vector.dimension_) {
-			throw std::logic_error(fmt::format("Dimensions of LHS({}) and RHS({}) do not match",
-			                                   this->dimensions(),
-			                                   vector.dimensions()));
+			detail::throw_dimension_mismatch(this->dimensions(), vector.dimensions());
 		}
-		for (auto i = 0; i < this->dimension_; ++i) {
-			this->magnitude_[cast(i)] = this->magnitude_[cast(i)] - vector.magnitude_[cast(i)];
-		}
-		this->mag_cache_ = -1;
+		kernels::subtract(this->storage(), this->data(), vector.data(), cast(this->dimension_));
+		this->invalidate_norm();
 		return *this;
 	}
 
 	auto euclidean_vector::operator*=(double const& mult) noexcept -> euclidean_vector& {
-		std::transform(this->magnitude_.get(),
-		               this->magnitude_.get() + this->dimension_,
-		               this->magnitude_.get(),
-		               [&mult](double& x) -> double { return x * mult; });
-		this->mag_cache_ = -1;
+		COMP6771_INSTRUMENT(multiply, bytes(this->dimension_, 2));
+		kernels::multiply(this->storage(), this->data(), mult, cast(this->dimension_));
+		this->rescale_norm(mult);
 		return *this;
 	}
 
 	auto euclidean_vector::operator/=(double const& divisor) -> euclidean_vector& {
+		COMP6771_INSTRUMENT(divide, bytes(this->dimension_, 2));
 		if (divisor == 0) {
 			throw std::logic_error("Invalid vector division by 0");
 		}
 
-		std::transform(this->magnitude_.get(),
-		               this->magnitude_.get() + this->dimension_,
-		               this->magnitude_.get(),
-		               [&divisor](double& x) -> double { return x / divisor; });
-		this->mag_cache_ = -1;
+		kernels::divide(this->storage(), this->data(), divisor, cast(this->dimension_));
+		// 1 / divisor is exact whenever divisor is a power of two
+		this->rescale_norm(1 / divisor);
 		return *this;
 	}
 
 	euclidean_vector::operator std::vector<double>() const noexcept {
-		auto vec = std::vector<double>();
-		vec.reserve(cast(this->dimension_));
-		for (auto i = 0; i < this->dimensions(); ++i) {
-			vec.emplace_back(this->magnitude_[cast(i)]);
-		}
-		// std::fill()
-		return vec;
+		return std::vector<double>(this->data(), this->data() + this->dimension_);
 	}
 
 	euclidean_vector::operator std::list<double>() const noexcept {
 		auto list = std::list<double>();
 		for (auto i = 0; i < dimensions(); ++i) {
-			list.emplace_back(euclidean_vector::magnitude_[cast(i)]);
+			list.emplace_back(euclidean_vector::data()[cast(i)]);
 		}
 		return list;
 	}
@@ -224,7 +305,7 @@ namespace comp6771 {
 			   fmt::format("Index {} is not Valid for this euclidean_vector object", dimension));
 		}
 
-		return this->magnitude_[gsl_lite::narrow_cast<size_t>(dimension)];
+		return this->data()[gsl_lite::narrow_cast<size_t>(dimension)];
 	}
 
 	auto euclidean_vector::at(int const& dimension) -> double& {
@@ -233,101 +314,19 @@ namespace comp6771 {
 			   fmt::format("Index {} is not Valid for this euclidean_vector object", dimension));
 		}
 
-		return this->magnitude_[gsl_lite::narrow_cast<size_t>(dimension)];
+		return this->storage()[gsl_lite::narrow_cast<size_t>(dimension)];
 	}
 
 	auto operator==(euclidean_vector const& a, euclidean_vector const& b) noexcept -> bool {
-		if (check_dimensions(a, b)) {
-			return false;
-		}
-
-		auto size = a.dimensions();
-		return std::equal(a.magnitude_.get(),
-		                  a.magnitude_.get() + size,
-		                  b.magnitude_.get(),
-		                  b.magnitude_.get() + size);
+		return not check_dimensions(a, b)
+		       and kernels::equal(a.data(), b.data(), cast(a.dimensions()));
 	}
 	auto operator!=(euclidean_vector const& a, euclidean_vector const& b) noexcept -> bool {
-		if (check_dimensions(a, b)) {
-			return true;
-		}
-
-		auto size = a.dimensions();
-		return !(std::equal(a.magnitude_.get(),
-		                    a.magnitude_.get() + size,
-		                    b.magnitude_.get(),
-		                    b.magnitude_.get() + size));
-	}
-
-	auto operator+(euclidean_vector const& a, euclidean_vector const& b) -> euclidean_vector {
-		if (check_dimensions(a, b)) {
-			throw std::logic_error(fmt::format("Dimensions of LHS({}) and RHS({}) do not match",
-			                                   a.dimensions(),
-			                                   b.dimensions()));
-		}
-		auto ret_vec = euclidean_vector(a.dimensions());
-
-		auto size = a.dimension_;
-		std::transform(a.magnitude_.get(),
-		               a.magnitude_.get() + size,
-		               b.magnitude_.get(),
-		               ret_vec.magnitude_.get(),
-		               [](double& a, double& b) -> double { return a + b; });
-
-		return ret_vec;
-	}
-
-	auto operator-(euclidean_vector const& a, euclidean_vector const& b) -> euclidean_vector {
-		if (check_dimensions(a, b)) {
-			throw std::logic_error(fmt::format("Dimensions of LHS({}) and RHS({}) do not match",
-			                                   a.dimensions(),
-			                                   b.dimensions()));
-		}
-		auto ret_vec = euclidean_vector(a.dimensions());
-		auto size = a.dimension_;
-		std::transform(a.magnitude_.get(),
-		               a.magnitude_.get() + size,
-		               b.magnitude_.get(),
-		               ret_vec.magnitude_.get(),
-		               [](double& a, double& b) -> double { return a - b; });
-		return ret_vec;
-	}
-
-	auto operator*(euclidean_vector const& a, double multiplier) noexcept -> euclidean_vector {
-		auto ret_vec = euclidean_vector(a.dimensions());
-
-		auto size = a.dimension_;
-		std::transform(a.magnitude_.get(),
-		               a.magnitude_.get() + size,
-		               ret_vec.magnitude_.get(),
-		               [&multiplier](double& a) -> double { return a * multiplier; });
-		return ret_vec;
-	}
-
-	auto operator*(double multiplier, euclidean_vector const& a) noexcept -> euclidean_vector {
-		return operator*(a, multiplier);
-	}
-
-	auto operator/(euclidean_vector const& a, double divisor) -> euclidean_vector {
-		if (divisor == 0) {
-			throw std::logic_error("Invalid vector division by 0");
-		}
-
-		auto ret_vec = euclidean_vector(a.dimensions());
-		for (auto i = 0; i < a.dimension_; ++i) {
-			ret_vec.magnitude_[cast(i)] = a.magnitude_[cast(i)] / divisor;
-		}
-
-		auto size = a.dimension_;
-		std::transform(a.magnitude_.get(),
-		               a.magnitude_.get() + size,
-		               ret_vec.magnitude_.get(),
-		               [&divisor](double& a) -> double { return a / divisor; });
-		return ret_vec;
+		return not(a == b);
 	}
 
 	auto operator<<(std::ostream& os, euclidean_vector const& vector) noexcept -> std::ostream& {
-		auto const& magnitudes = vector.magnitude_;
+		auto const* magnitudes = vector.data();
 		auto last = vector.dimension_ - 1;
 		os << "[";
 		for (auto i = 0; i < vector.dimension_; i++) {
@@ -348,66 +347,195 @@ namespace comp6771 {
 		if (v.dimensions() == 0) {
 			throw std::logic_error("euclidean_vector with no dimensions does not have a norm");
 		}
-		// check cache if we have
-		// auto norm = v.mag_cache();
-		// if (norm == -1) {
-		// 	norm = v.calculate_norm();
-		// 	v.set_cache(norm);
-		// }
 		return v.calculate_norm();
 	}
 
+	auto euclidean_norm(euclidean_vector const& v, accumulation const policy) -> double {
+		// the cache holds the naive sum
+		if (policy == accumulation::naive) {
+			return euclidean_norm(v);
+		}
+		if (v.dimensions() == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		COMP6771_INSTRUMENT(euclidean_norm, bytes(v.dimensions(), 1));
+		return kernels::norm(v.data(), cast(v.dimensions()), policy);
+	}
+
 	auto euclidean_vector::calculate_norm() const noexcept -> double {
-		auto norm = this->mag_cache_;
-		if (norm == -1) {
-			norm = 0.0;
-			std::for_each (this->magnitude_.get(),
-			               this->magnitude_.get() + this->dimension_,
-			               [&norm](double& mag) -> void { norm += mag * mag; });
-			norm = std::sqrt(norm);
-			this->mag_cache_ = norm;
+		auto squared_norm = this->cached_squared_norm();
+		// a cached norm reads no magnitudes
+		COMP6771_INSTRUMENT(euclidean_norm,
+		                    squared_norm == no_cached_norm ? bytes(this->dimension_, 1) : 0);
+		count_lookup(squared_norm != no_cached_norm);
+		if (squared_norm == no_cached_norm) {
+			squared_norm = kernels::sum_of_squares(this->data(), cast(this->dimension_));
+			this->squared_norm_cache_.store(squared_norm, std::memory_order_relaxed);
 		}
 
-		return norm;
+		return std::sqrt(squared_norm);
 	}
 
-	auto unit(euclidean_vector const& v) -> euclidean_vector {
-		if (v.dimensions() == 0) {
-			throw std::logic_error("euclidean_vector with no dimensions does not have a unit vector");
+	auto euclidean_vector::rescale_norm(double const factor) noexcept -> void {
+		auto const cached = this->cached_squared_norm();
+		if (cached == no_cached_norm) {
+			return;
 		}
-		auto norm = euclidean_norm(v);
-		if (norm == 0) {
-			throw std::logic_error("euclidean_vector with zero euclidean normal does not have a unit "
-			                       "vector");
+		// Only a power of two, or its negation, multiplies each square and so every partial sum
+		// without rounding.
+		auto exponent = 0;
+		auto const power_of_two = std::abs(std::frexp(factor, &exponent)) == 0.5;
+		auto const rescaled = std::ldexp(cached, 2 * (exponent - 1));
+		if (not power_of_two or not std::isfinite(rescaled)
+		    or std::min(cached, rescaled) < smallest_rescaled)
+		{
+			this->invalidate_norm();
+			return;
 		}
-		auto unit_mags = v.calculate_unit(norm);
-		return euclidean_vector(unit_mags.begin(), unit_mags.end());
+		this->squared_norm_cache_.store(rescaled, std::memory_order_relaxed);
+		count_update();
+	}
+
+	auto euclidean_vector::cache_statistics() noexcept -> norm_cache_statistics {
+		return registry::total();
 	}
 
-	auto euclidean_vector::calculate_unit(double& norm) const noexcept -> std::vector<double> {
-		auto unit_mags = std::vector<double>();
-		std::for_each (this->magnitude_.get(),
-		               this->magnitude_.get() + this->dimension_,
-		               [&unit_mags, &norm](double& mag) -> void { unit_mags.emplace_back(mag / norm); });
-		return unit_mags;
+	auto euclidean_vector::reset_cache_statistics() noexcept -> void {
+		registry::reset();
+	}
+
+	auto unit(euclidean_vector const& v) -> euclidean_vector {
+		COMP6771_INSTRUMENT(unit, bytes(v.dimensions(), 2));
+		return euclidean_vector(v * (1.0 / unit_norm(v)));
+	}
+
+	auto euclidean_vector::normalize() -> euclidean_vector& {
+		COMP6771_INSTRUMENT(normalize, bytes(this->dimension_, 2));
+		return *this *= 1.0 / unit_norm(*this);
+	}
+
+	auto euclidean_vector::normalized() const& -> euclidean_vector {
+		return unit(*this);
+	}
+
+	auto euclidean_vector::normalized() && -> euclidean_vector {
+		return std::move(normalize());
 	}
 
 	auto dot(euclidean_vector const& x, euclidean_vector const& y) -> double {
+		COMP6771_INSTRUMENT(dot, bytes(x.dimensions(), 2));
 		if (check_dimensions(x, y)) {
-			throw std::logic_error(fmt::format("Dimensions of LHS({}) and RHS({}) do not match",
-			                                   x.dimensions(),
-			                                   y.dimensions()));
+			detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
 		}
 
 		return x.calculate_dot(y);
 	}
 
+	auto dot(euclidean_vector const& x, euclidean_vector const& y, accumulation const policy)
+	   -> double {
+		COMP6771_INSTRUMENT(dot, bytes(x.dimensions(), 2));
+		if (check_dimensions(x, y)) {
+			detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
+		}
+		return kernels::dot(x.data(), y.data(), cast(x.dimensions()), policy);
+	}
+
 	auto euclidean_vector::calculate_dot(euclidean_vector const& y) const -> double {
-		auto size = this->dimension_;
-		return std::inner_product(this->magnitude_.get(),
-		                          this->magnitude_.get() + size,
-		                          y.magnitude_.get(),
-		                          0.0);
+		return kernels::dot(this->data(), y.data(), cast(this->dimension_));
+	}
+
+	auto squared_distance(euclidean_vector const& x, euclidean_vector const& y) -> double {
+		if (check_dimensions(x, y)) {
+			detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
+		}
+
+		return x.calculate_squared_distance(y);
+	}
+
+	auto distance(euclidean_vector const& x, euclidean_vector const& y) -> double {
+		return std::sqrt(squared_distance(x, y));
+	}
+
+	auto euclidean_vector::calculate_squared_distance(euclidean_vector const& y) const -> double {
+		return kernels::squared_distance(this->data(), y.data(), cast(this->dimension_));
+	}
+
+	auto cosine_similarity(euclidean_vector const& x, euclidean_vector const& y) -> double {
+		if (check_dimensions(x, y)) {
+			detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
+		}
+		if (x.dimensions() == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a cosine "
+			                       "similarity");
+		}
+		auto x_norm = 0.0;
+		auto y_norm = 0.0;
+		auto const product = x.calculate_dot_and_norms(y, x_norm, y_norm);
+		if (x_norm == 0 or y_norm == 0) {
+			throw std::logic_error("euclidean_vector with zero euclidean normal does not have a "
+			                       "cosine similarity");
+		}
+		return product / (x_norm * y_norm);
+	}
+
+	// A norm that was computed, rather than adjusted, came from the same sum as dot_terms_of's,
+	// so the result does not depend on which norms were cached.
+	auto euclidean_vector::calculate_dot_and_norms(euclidean_vector const& y,
+	                                               double& x_norm,
+	                                               double& y_norm) const -> double {
+		auto const x_cached = this->cached_squared_norm();
+		auto const y_cached = y.cached_squared_norm();
+		count_lookup(x_cached != no_cached_norm);
+		count_lookup(y_cached != no_cached_norm);
+		if (x_cached != no_cached_norm and y_cached != no_cached_norm) {
+			x_norm = std::sqrt(x_cached);
+			y_norm = std::sqrt(y_cached);
+			return calculate_dot(y);
+		}
+		auto const terms = kernels::dot_terms_of(this->data(), y.data(), cast(this->dimension_));
+		this->squared_norm_cache_.store(terms.xx, std::memory_order_relaxed);
+		y.squared_norm_cache_.store(terms.yy, std::memory_order_relaxed);
+		x_norm = std::sqrt(terms.xx);
+		y_norm = std::sqrt(terms.yy);
+		return terms.xy;
+	}
+
+	auto approx_equal(euclidean_vector const& x,
+	                  euclidean_vector const& y,
+	                  double const absolute_tolerance,
+	                  double const relative_tolerance) noexcept -> bool {
+		return not check_dimensions(x, y)
+		       and kernels::approx_equal(x.data(),
+		                                 y.data(),
+		                                 cast(x.dimensions()),
+		                                 absolute_tolerance,
+		                                 relative_tolerance);
+	}
+
+	auto ulp_distance(euclidean_vector const& x, euclidean_vector const& y) -> std::uint64_t {
+		if (check_dimensions(x, y)) {
+			detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
+		}
+		return kernels::ulp_distance(x.data(), y.data(), cast(x.dimensions()));
+	}
+
+	auto ulp_equal(euclidean_vector const& x,
+	               euclidean_vector const& y,
+	               std::uint64_t const max_ulps) noexcept -> bool {
+		return not check_dimensions(x, y)
+		       and kernels::ulp_distance(x.data(), y.data(), cast(x.dimensions())) <= max_ulps;
+	}
+
+	auto hash_value(euclidean_vector const& v, std::uint64_t const seed) noexcept -> std::uint64_t {
+		return kernels::hash(v.data(), cast(v.dimensions()), seed);
+	}
+
+	auto axpy(double alpha, euclidean_vector const& x, euclidean_vector& y) -> void {
+		if (check_dimensions(x, y)) {
+			detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
+		}
+		kernels::axpy(y.storage(), alpha, x.data(), cast(y.dimension_));
+		y.invalidate_norm();
 	}
 
 } // namespace comp6771
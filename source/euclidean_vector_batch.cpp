@@ -0,0 +1,401 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fmt/format.h>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+	using comp6771::batch_layout;
+	using comp6771::euclidean_vector_batch;
+	using comp6771::euclidean_vector_view;
+
+	// rows (column_major: columns) are padded to a whole number of cache lines
+	constexpr auto doubles_per_line = comp6771::detail::magnitude_alignment / sizeof(double);
+
+	// row-major rows of x are compared against this many rows of y at a time, so that the block
+	// of y stays in cache while every row of x streams past it
+	constexpr auto pairwise_block = 64;
+
+	auto cast(int i) -> std::size_t {
+		return static_cast<std::size_t>(i);
+	}
+
+	auto leading_dimension_for(int size, int dimensions, batch_layout layout) -> std::size_t {
+		auto const adjacent = cast(layout == batch_layout::row_major ? dimensions : size);
+		return (adjacent + doubles_per_line - 1) / doubles_per_line * doubles_per_line;
+	}
+
+	auto check_row(euclidean_vector_batch const& batch, int row) -> void {
+		if (row < 0 or row >= batch.size()) {
+			throw std::out_of_range(
+			   fmt::format("Index {} is not Valid for this euclidean_vector_batch object", row));
+		}
+	}
+
+	auto check_sizes(euclidean_vector_batch const& x, euclidean_vector_batch const& y) -> void {
+		if (x.size() != y.size()) {
+			throw std::logic_error(
+			   fmt::format("Sizes of LHS({}) and RHS({}) do not match", x.size(), y.size()));
+		}
+		if (x.dimensions() != y.dimensions()) {
+			comp6771::detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
+		}
+	}
+
+	// A strided query is gathered into `scratch` so that the SIMD kernels can read it.
+	auto contiguous(euclidean_vector_view query, std::vector<double>& scratch) -> double const* {
+		if (query.is_contiguous()) {
+			return query.data();
+		}
+		scratch = static_cast<std::vector<double>>(query);
+		return scratch.data();
+	}
+
+	// the magnitudes of dimension `dimension` for every vector of a column_major batch
+	auto column(euclidean_vector_batch const& batch, int dimension) -> double const* {
+		return batch.data() + cast(dimension) * batch.leading_dimension();
+	}
+
+	auto row(euclidean_vector_batch const& batch, int row) -> double const* {
+		return batch.data() + cast(row) * batch.leading_dimension();
+	}
+
+	// the sum of squares of each of the first `rows` rows
+	auto sum_of_squares(euclidean_vector_batch const& batch, int const rows) -> std::vector<double> {
+		auto sums = std::vector<double>(cast(rows));
+		if (batch.layout() == batch_layout::row_major) {
+			for (auto i = 0; i < rows; ++i) {
+				sums[cast(i)] =
+				   comp6771::kernels::sum_of_squares(row(batch, i), cast(batch.dimensions()));
+			}
+			return sums;
+		}
+		for (auto j = 0; j < batch.dimensions(); ++j) {
+			comp6771::kernels::add_squared_difference(sums.data(), column(batch, j), 0.0, sums.size());
+		}
+		return sums;
+	}
+
+	auto squared_distances(euclidean_vector_batch const& batch, double const* query)
+	   -> std::vector<double> {
+		auto sums = std::vector<double>(cast(batch.size()));
+		if (batch.layout() == batch_layout::row_major) {
+			for (auto i = 0; i < batch.size(); ++i) {
+				sums[cast(i)] =
+				   comp6771::kernels::squared_distance(row(batch, i), query, cast(batch.dimensions()));
+			}
+			return sums;
+		}
+		for (auto j = 0; j < batch.dimensions(); ++j) {
+			auto const* const magnitudes = column(batch, j);
+			comp6771::kernels::add_squared_difference(sums.data(), magnitudes, query[j], sums.size());
+		}
+		return sums;
+	}
+
+	auto square_root(std::vector<double>& sums) -> void {
+		std::for_each (sums.begin(), sums.end(), [](double& sum) { sum = std::sqrt(sum); });
+	}
+
+	// 1 / euclidean_norm(batch[i]) for each of the first `rows` rows; throws unless each of them
+	// has a unit vector
+	auto reciprocal_norms(euclidean_vector_batch const& batch, int const rows)
+	   -> std::vector<double> {
+		if (batch.dimensions() == 0) {
+			comp6771::detail::throw_no_unit_vector(0);
+		}
+		auto norms = sum_of_squares(batch, rows);
+		square_root(norms);
+		if (std::find(norms.begin(), norms.end(), 0.0) != norms.end()) {
+			comp6771::detail::throw_no_unit_vector(batch.dimensions());
+		}
+		std::for_each (norms.begin(), norms.end(), [](double& norm) { norm = 1.0 / norm; });
+		return norms;
+	}
+
+	// Writes batch[i] * scales[i] for each row that has a scale to `out`, which has the batch's
+	// shape and may be the batch's own magnitudes.
+	auto scale_each(euclidean_vector_batch const& batch,
+	                std::vector<double> const& scales,
+	                double* out) -> void {
+		if (batch.layout() == batch_layout::row_major) {
+			for (auto i = 0; i < static_cast<int>(scales.size()); ++i) {
+				comp6771::kernels::multiply(out + cast(i) * batch.leading_dimension(),
+				                            row(batch, i),
+				                            scales[cast(i)],
+				                            cast(batch.dimensions()));
+			}
+			return;
+		}
+		for (auto j = 0; j < batch.dimensions(); ++j) {
+			auto const* const magnitudes = column(batch, j);
+			auto* const scaled = out + cast(j) * batch.leading_dimension();
+			for (auto i = std::size_t{0}; i < scales.size(); ++i) {
+				scaled[i] = magnitudes[i] * scales[i];
+			}
+		}
+	}
+} // namespace
+
+namespace comp6771 {
+	euclidean_vector_batch::euclidean_vector_batch(int size,
+	                                               int dimensions,
+	                                               batch_layout layout,
+	                                               allocator_type const& allocator)
+	: size_{size}
+	, dimension_{dimensions}
+	, layout_{layout}
+	, leading_dimension_{leading_dimension_for(size, dimensions, layout)}
+	, magnitudes_{nullptr, detail::magnitude_deleter{allocator.resource(), 0}} {
+		auto const adjacent = cast(layout == batch_layout::row_major ? size : dimensions);
+		auto const capacity = leading_dimension_ * adjacent;
+		if (capacity == 0) {
+			return;
+		}
+		auto* const magnitudes = static_cast<double*>(
+		   allocator.resource()->allocate(capacity * sizeof(double), detail::magnitude_alignment));
+		magnitudes_ = magnitude_pointer(magnitudes,
+		                                detail::magnitude_deleter{allocator.resource(), capacity});
+		std::fill_n(magnitudes, capacity, 0.0);
+	}
+
+	euclidean_vector_batch::euclidean_vector_batch(std::span<euclidean_vector const> vectors,
+	                                               batch_layout layout,
+	                                               allocator_type const& allocator)
+	: euclidean_vector_batch(static_cast<int>(vectors.size()),
+	                         vectors.empty() ? 0 : vectors.front().dimensions(),
+	                         layout,
+	                         allocator) {
+		for (auto i = 0; i < size_; ++i) {
+			assign(i, vectors[cast(i)]);
+		}
+	}
+
+	euclidean_vector_batch::euclidean_vector_batch(euclidean_vector_batch const& other)
+	: euclidean_vector_batch(other, allocator_type()) {}
+
+	euclidean_vector_batch::euclidean_vector_batch(euclidean_vector_batch const& other,
+	                                               allocator_type const& allocator)
+	: euclidean_vector_batch(other.size_, other.dimension_, other.layout_, allocator) {
+		std::copy_n(other.data(), magnitudes_.get_deleter().capacity, data());
+	}
+
+	euclidean_vector_batch::euclidean_vector_batch(euclidean_vector_batch&& other) noexcept
+	: size_{std::exchange(other.size_, 0)}
+	, dimension_{std::exchange(other.dimension_, 0)}
+	, layout_{other.layout_}
+	, leading_dimension_{std::exchange(other.leading_dimension_, 0)}
+	, magnitudes_{std::move(other.magnitudes_)} {}
+
+	// Like euclidean_vector, assignment keeps the destination's memory resource.
+	auto euclidean_vector_batch::operator=(euclidean_vector_batch const& other)
+	   -> euclidean_vector_batch& {
+		if (this != &other) {
+			*this = euclidean_vector_batch(other, get_allocator());
+		}
+		return *this;
+	}
+
+	auto euclidean_vector_batch::operator=(euclidean_vector_batch&& other)
+	   -> euclidean_vector_batch& {
+		if (this == &other) {
+			return *this;
+		}
+		if (*magnitudes_.get_deleter().resource != *other.magnitudes_.get_deleter().resource) {
+			return *this = euclidean_vector_batch(other, get_allocator());
+		}
+		size_ = std::exchange(other.size_, 0);
+		dimension_ = std::exchange(other.dimension_, 0);
+		layout_ = other.layout_;
+		leading_dimension_ = std::exchange(other.leading_dimension_, 0);
+		magnitudes_ = std::move(other.magnitudes_);
+		return *this;
+	}
+
+	auto euclidean_vector_batch::at(int row) const -> euclidean_vector_view {
+		check_row(*this, row);
+		return (*this)[row];
+	}
+
+	auto euclidean_vector_batch::assign(int row, euclidean_vector_view vector) -> void {
+		check_row(*this, row);
+		(*this)[row] = vector;
+	}
+
+	auto euclidean_vector_batch::to_layout(batch_layout layout) const -> euclidean_vector_batch {
+		auto result = euclidean_vector_batch(size_, dimension_, layout);
+		for (auto i = 0; i < size_; ++i) {
+			result.assign(i, (*this)[i]);
+		}
+		return result;
+	}
+
+	auto dot(euclidean_vector_batch const& batch, euclidean_vector_view query)
+	   -> std::vector<double> {
+		if (batch.dimensions() != query.dimensions()) {
+			detail::throw_dimension_mismatch(batch.dimensions(), query.dimensions());
+		}
+		auto scratch = std::vector<double>();
+		auto const* const q = contiguous(query, scratch);
+		auto products = std::vector<double>(cast(batch.size()));
+		if (batch.layout() == batch_layout::row_major) {
+			for (auto i = 0; i < batch.size(); ++i) {
+				products[cast(i)] = kernels::dot(row(batch, i), q, cast(batch.dimensions()));
+			}
+			return products;
+		}
+		for (auto j = 0; j < batch.dimensions(); ++j) {
+			kernels::axpy(products.data(), q[j], column(batch, j), products.size());
+		}
+		return products;
+	}
+
+	auto euclidean_norm(euclidean_vector_batch const& batch) -> std::vector<double> {
+		if (batch.dimensions() == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		auto norms = sum_of_squares(batch, batch.size());
+		square_root(norms);
+		return norms;
+	}
+
+	auto unit(euclidean_vector_batch const& batch) -> euclidean_vector_batch {
+		auto const reciprocals = reciprocal_norms(batch, batch.size());
+		auto result = euclidean_vector_batch(batch.size(), batch.dimensions(), batch.layout());
+		scale_each(batch, reciprocals, result.data());
+		return result;
+	}
+
+	auto normalize(euclidean_vector_batch& batch) -> void {
+		normalize(batch, batch.size());
+	}
+
+	auto normalize(euclidean_vector_batch& batch, int const rows) -> void {
+		if (rows < 0 or rows > batch.size()) {
+			throw std::out_of_range(
+			   fmt::format("Row count {} is not Valid for this euclidean_vector_batch object", rows));
+		}
+		auto const reciprocals = reciprocal_norms(batch, rows);
+		scale_each(batch, reciprocals, batch.data());
+	}
+
+	auto axpy(double alpha, euclidean_vector_batch const& x, euclidean_vector_batch& y) -> void {
+		check_sizes(x, y);
+		if (x.layout() == y.layout()) {
+			// identical shapes have identical padding, so the whole slab is one kernel call
+			auto const adjacent = x.layout() == batch_layout::row_major ? x.size() : x.dimensions();
+			kernels::axpy(y.data(), alpha, x.data(), x.leading_dimension() * cast(adjacent));
+			return;
+		}
+		for (auto i = 0; i < x.size(); ++i) {
+			for (auto j = 0; j < x.dimensions(); ++j) {
+				auto const product = alpha * x(i, j);
+				y(i, j) += product;
+			}
+		}
+	}
+
+	auto squared_distance(euclidean_vector_batch const& batch, euclidean_vector_view query)
+	   -> std::vector<double> {
+		if (batch.dimensions() != query.dimensions()) {
+			detail::throw_dimension_mismatch(batch.dimensions(), query.dimensions());
+		}
+		auto scratch = std::vector<double>();
+		return squared_distances(batch, contiguous(query, scratch));
+	}
+
+	auto distance(euclidean_vector_batch const& batch, euclidean_vector_view query)
+	   -> std::vector<double> {
+		auto distances = squared_distance(batch, query);
+		square_root(distances);
+		return distances;
+	}
+
+	auto cosine_similarity(euclidean_vector_batch const& batch, euclidean_vector_view query)
+	   -> std::vector<double> {
+		if (batch.dimensions() != query.dimensions()) {
+			detail::throw_dimension_mismatch(batch.dimensions(), query.dimensions());
+		}
+		if (batch.dimensions() == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a cosine "
+			                       "similarity");
+		}
+		auto scratch = std::vector<double>();
+		auto const* const q = contiguous(query, scratch);
+		auto const dimensions = cast(batch.dimensions());
+		auto const query_norm = std::sqrt(kernels::sum_of_squares(q, dimensions));
+		auto similarities = std::vector<double>(cast(batch.size()));
+		auto norms = std::vector<double>(similarities.size());
+		if (batch.layout() == batch_layout::row_major) {
+			for (auto i = 0; i < batch.size(); ++i) {
+				auto const terms = kernels::dot_terms_of(row(batch, i), q, dimensions);
+				similarities[cast(i)] = terms.xy;
+				norms[cast(i)] = std::sqrt(terms.xx);
+			}
+		}
+		else {
+			for (auto j = 0; j < batch.dimensions(); ++j) {
+				kernels::axpy(similarities.data(), q[j], column(batch, j), similarities.size());
+			}
+			norms = euclidean_norm(batch);
+		}
+		if (query_norm == 0 or std::find(norms.begin(), norms.end(), 0.0) != norms.end()) {
+			throw std::logic_error("euclidean_vector with zero euclidean normal does not have a "
+			                       "cosine similarity");
+		}
+		for (auto i = std::size_t{0}; i < similarities.size(); ++i) {
+			similarities[i] /= norms[i] * query_norm;
+		}
+		return similarities;
+	}
+
+	auto pairwise_distance(euclidean_vector_batch const& x, euclidean_vector_batch const& y)
+	   -> std::vector<double> {
+		if (x.dimensions() != y.dimensions()) {
+			detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
+		}
+		auto const columns = cast(y.size());
+		auto distances = std::vector<double>(cast(x.size()) * columns);
+		if (y.layout() == batch_layout::column_major) {
+			auto scratch = std::vector<double>();
+			for (auto i = 0; i < x.size(); ++i) {
+				auto const row_distances = squared_distances(y, contiguous(x[i], scratch));
+				std::copy(row_distances.begin(),
+				          row_distances.end(),
+				          distances.begin() + static_cast<std::ptrdiff_t>(cast(i) * columns));
+			}
+		}
+		else if (x.layout() == batch_layout::column_major) {
+			for (auto j = 0; j < y.size(); ++j) {
+				auto const column_distances = squared_distances(x, row(y, j));
+				for (auto i = std::size_t{0}; i < column_distances.size(); ++i) {
+					distances[i * columns + cast(j)] = column_distances[i];
+				}
+			}
+		}
+		else {
+			auto const dimensions = cast(x.dimensions());
+			for (auto first = 0; first < y.size(); first += pairwise_block) {
+				auto const last = std::min(first + pairwise_block, y.size());
+				for (auto i = 0; i < x.size(); ++i) {
+					for (auto j = first; j < last; ++j) {
+						distances[cast(i) * columns + cast(j)] =
+						   kernels::squared_distance(row(x, i), row(y, j), dimensions);
+					}
+				}
+			}
+		}
+		square_root(distances);
+		return distances;
+	}
+} // namespace comp6771
@@ -0,0 +1,414 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <limits>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+	static_assert(std::numeric_limits<double>::is_iec559, "vector files hold IEEE-754 doubles");
+
+	using header_bytes = std::array<char, comp6771::vector_file_header_size>;
+
+	constexpr auto magic = std::array<char, 8>{'E', 'V', 'E', 'C', 'T', 'O', 'R', 'S'};
+	constexpr auto format_version = std::uint32_t{1};
+	constexpr auto byte_order_mark = std::uint32_t{0x01020304};
+	constexpr auto max_row_alignment = std::size_t{4096};
+	// the number of vectors in a file whose writer could not seek back to record it
+	constexpr auto unknown_size = std::numeric_limits<std::uint64_t>::max();
+
+	// field offsets, as documented in euclidean_vector_file.hpp
+	constexpr auto version_offset = std::size_t{8};
+	constexpr auto byte_order_offset = std::size_t{12};
+	constexpr auto dimensions_offset = std::size_t{16};
+	constexpr auto row_alignment_offset = std::size_t{20};
+	constexpr auto size_offset = std::size_t{24};
+
+	// zeroes to pad rows with
+	constexpr auto padding = std::array<char, max_row_alignment>{};
+
+	auto cast(int i) -> std::size_t {
+		return static_cast<std::size_t>(i);
+	}
+
+	template<typename T>
+	auto byte_swap(T value) noexcept -> T {
+		auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+		std::reverse(bytes.begin(), bytes.end());
+		return std::bit_cast<T>(bytes);
+	}
+
+	template<typename T>
+	auto load(header_bytes const& header, std::size_t offset, bool swap_bytes) noexcept -> T {
+		auto value = T();
+		std::memcpy(&value, header.data() + offset, sizeof(T));
+		return swap_bytes ? byte_swap(value) : value;
+	}
+
+	template<typename T>
+	auto store(header_bytes& header, std::size_t offset, T value) noexcept -> void {
+		std::memcpy(header.data() + offset, &value, sizeof(T));
+	}
+
+	auto valid_row_alignment(std::size_t row_alignment) noexcept -> bool {
+		return row_alignment >= sizeof(double) and row_alignment <= max_row_alignment
+		       and std::has_single_bit(row_alignment);
+	}
+
+	// bytes from the start of one vector to the start of the next
+	auto row_bytes_for(int dimensions, std::size_t row_alignment) noexcept -> std::size_t {
+		auto const bytes = cast(dimensions) * sizeof(double);
+		return (bytes + row_alignment - 1) / row_alignment * row_alignment;
+	}
+
+	struct file_layout {
+		int dimensions;
+		std::size_t row_bytes;
+		std::uint64_t size;
+		bool swap_bytes;
+	};
+
+	auto make_header(int dimensions, std::size_t row_alignment) -> header_bytes {
+		auto header = header_bytes{};
+		std::copy(magic.begin(), magic.end(), header.begin());
+		store(header, version_offset, format_version);
+		store(header, byte_order_offset, byte_order_mark);
+		store(header, dimensions_offset, static_cast<std::uint32_t>(dimensions));
+		store(header, row_alignment_offset, static_cast<std::uint32_t>(row_alignment));
+		store(header, size_offset, unknown_size);
+		return header;
+	}
+
+	auto parse_header(header_bytes const& header) -> file_layout {
+		if (not std::equal(magic.begin(), magic.end(), header.begin())) {
+			throw std::runtime_error("Not a euclidean_vector file");
+		}
+		auto const mark = load<std::uint32_t>(header, byte_order_offset, false);
+		auto const swap_bytes = mark != byte_order_mark;
+		if (swap_bytes and byte_swap(mark) != byte_order_mark) {
+			throw std::runtime_error("euclidean_vector file has an invalid byte order mark");
+		}
+		auto const version = load<std::uint32_t>(header, version_offset, swap_bytes);
+		if (version != format_version) {
+			throw std::runtime_error(
+			   fmt::format("euclidean_vector file version {} is not supported", version));
+		}
+		auto const dimensions = load<std::uint32_t>(header, dimensions_offset, swap_bytes);
+		if (dimensions > static_cast<std::uint32_t>(INT_MAX)) {
+			throw std::runtime_error(
+			   fmt::format("euclidean_vector file has too many dimensions ({})", dimensions));
+		}
+		auto const row_alignment = load<std::uint32_t>(header, row_alignment_offset, swap_bytes);
+		if (not valid_row_alignment(row_alignment)) {
+			throw std::runtime_error(
+			   fmt::format("euclidean_vector file has an invalid row alignment ({})", row_alignment));
+		}
+		return file_layout{static_cast<int>(dimensions),
+		                   row_bytes_for(static_cast<int>(dimensions), row_alignment),
+		                   load<std::uint64_t>(header, size_offset, swap_bytes),
+		                   swap_bytes};
+	}
+
+	[[noreturn]] auto throw_truncated() -> void {
+		throw std::runtime_error("euclidean_vector file is truncated");
+	}
+} // namespace
+
+namespace comp6771 {
+	vector_file_writer::vector_file_writer(std::ostream& out,
+	                                       int dimensions,
+	                                       std::size_t row_alignment)
+	: out_{&out}
+	, header_{out.tellp()}
+	, dimension_{dimensions}
+	, row_bytes_{0} {
+		if (not valid_row_alignment(row_alignment)) {
+			throw std::logic_error(fmt::format("Row alignment {} is not a power of two from 8 to {}",
+			                                   row_alignment,
+			                                   max_row_alignment));
+		}
+		row_bytes_ = row_bytes_for(dimensions, row_alignment);
+		auto const header = make_header(dimensions, row_alignment);
+		out_->write(header.data(), static_cast<std::streamsize>(header.size()));
+	}
+
+	vector_file_writer::~vector_file_writer() {
+		if (not finished_) {
+			// a stream with exceptions enabled may throw while the size is recorded
+			try {
+				record_size();
+			} catch (...) {
+			}
+		}
+	}
+
+	auto vector_file_writer::write(euclidean_vector_view vector) -> void {
+		if (vector.dimensions() != dimension_) {
+			detail::throw_dimension_mismatch(dimension_, vector.dimensions());
+		}
+		if (vector.is_contiguous()) {
+			write_row(vector.data());
+			return;
+		}
+		scratch_.resize(cast(dimension_));
+		vector.evaluate(scratch_.data());
+		write_row(scratch_.data());
+	}
+
+	auto vector_file_writer::write(euclidean_vector_batch const& batch) -> void {
+		if (batch.dimensions() != dimension_) {
+			detail::throw_dimension_mismatch(dimension_, batch.dimensions());
+		}
+		if (batch.layout() == batch_layout::row_major
+		    and batch.leading_dimension() * sizeof(double) == row_bytes_)
+		{
+			out_->write(reinterpret_cast<char const*>(batch.data()),
+			            static_cast<std::streamsize>(cast(batch.size()) * row_bytes_));
+			size_ += cast(batch.size());
+			return;
+		}
+		for (auto i = 0; i < batch.size(); ++i) {
+			write(batch[i]);
+		}
+	}
+
+	auto vector_file_writer::finish() -> void {
+		finished_ = true;
+		record_size();
+		out_->flush();
+		if (out_->fail()) {
+			throw std::runtime_error("Could not write the euclidean_vector file");
+		}
+	}
+
+	auto vector_file_writer::write_row(double const* magnitudes) -> void {
+		auto const bytes = cast(dimension_) * sizeof(double);
+		out_->write(reinterpret_cast<char const*>(magnitudes), static_cast<std::streamsize>(bytes));
+		out_->write(padding.data(), static_cast<std::streamsize>(row_bytes_ - bytes));
+		++size_;
+	}
+
+	// A stream that cannot seek, such as a pipe, keeps unknown_size in the header; readers then
+	// read until the end of the stream.
+	auto vector_file_writer::record_size() -> void {
+		if (header_ == std::ostream::pos_type(-1) or out_->fail()) {
+			return;
+		}
+		auto const end = out_->tellp();
+		auto const size = static_cast<std::uint64_t>(size_);
+		out_->seekp(header_ + static_cast<std::streamoff>(size_offset));
+		out_->write(reinterpret_cast<char const*>(&size), sizeof(size));
+		out_->seekp(end);
+	}
+
+	vector_file_reader::vector_file_reader(std::istream& in)
+	: in_{&in} {
+		auto header = header_bytes{};
+		if (not in_->read(header.data(), static_cast<std::streamsize>(header.size()))) {
+			throw_truncated();
+		}
+		auto const layout = parse_header(header);
+		dimension_ = layout.dimensions;
+		row_bytes_ = layout.row_bytes;
+		swap_bytes_ = layout.swap_bytes;
+		if (layout.size == unknown_size) {
+			return;
+		}
+		if (layout.size > static_cast<std::uint64_t>(INT_MAX)) {
+			throw std::runtime_error(
+			   fmt::format("euclidean_vector file has too many vectors ({})", layout.size));
+		}
+		// a stream that cannot seek is only found to be truncated when it is read
+		auto const start = in_->tellg();
+		if (start != std::istream::pos_type(-1) and row_bytes_ != 0) {
+			in_->seekg(0, std::ios::end);
+			auto const remaining = static_cast<std::uint64_t>(in_->tellg() - start);
+			in_->seekg(start);
+			if (layout.size > remaining / row_bytes_) {
+				throw_truncated();
+			}
+		}
+		size_ = static_cast<std::size_t>(layout.size);
+	}
+
+	auto vector_file_reader::read(euclidean_vector& vector) -> bool {
+		if (vector.dimensions() != dimension_) {
+			vector = euclidean_vector(uninitialized, dimension_);
+		}
+		if (dimension_ == 0) {
+			return read_row(nullptr);
+		}
+		// writing through operator[] also discards the cached norm
+		return read(euclidean_vector_ref(&vector[0], dimension_));
+	}
+
+	auto vector_file_reader::read(euclidean_vector_ref vector) -> bool {
+		if (vector.dimensions() != dimension_) {
+			detail::throw_dimension_mismatch(dimension_, vector.dimensions());
+		}
+		if (vector.is_contiguous()) {
+			return read_row(vector.data());
+		}
+		scratch_.resize(cast(dimension_));
+		if (not read_row(scratch_.data())) {
+			return false;
+		}
+		vector = euclidean_vector_view(scratch_);
+		return true;
+	}
+
+	auto vector_file_reader::read_all(batch_layout layout) -> euclidean_vector_batch {
+		if (size_.has_value()) {
+			auto batch =
+			   euclidean_vector_batch(static_cast<int>(*size_ - read_), dimension_, layout);
+			for (auto i = 0; i < batch.size(); ++i) {
+				if (not read(batch[i])) {
+					throw_truncated();
+				}
+			}
+			return batch;
+		}
+		auto vectors = std::vector<euclidean_vector>();
+		for (auto vector = euclidean_vector(uninitialized, dimension_); read(vector);) {
+			vectors.push_back(vector);
+		}
+		if (vectors.empty()) {
+			// an empty span has no dimensions to take
+			return euclidean_vector_batch(0, dimension_, layout);
+		}
+		return euclidean_vector_batch(vectors, layout);
+	}
+
+	auto vector_file_reader::read_row(double* magnitudes) -> bool {
+		if (size_.has_value() ? read_ == *size_
+		                      : in_->peek() == std::istream::traits_type::eof())
+		{
+			return false;
+		}
+		auto const bytes = cast(dimension_) * sizeof(double);
+		in_->read(reinterpret_cast<char*>(magnitudes), static_cast<std::streamsize>(bytes));
+		in_->ignore(static_cast<std::streamsize>(row_bytes_ - bytes));
+		if (not *in_) {
+			throw_truncated();
+		}
+		if (swap_bytes_) {
+			std::for_each (magnitudes, magnitudes + dimension_, [](double& m) { m = byte_swap(m); });
+		}
+		++read_;
+		return true;
+	}
+
+	mapped_vector_file::mapped_vector_file(std::filesystem::path const& path) {
+		auto const file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file == -1) {
+			throw std::system_error(errno, std::generic_category(), "Cannot open " + path.string());
+		}
+		struct ::stat status = {};
+		if (::fstat(file, &status) == -1) {
+			auto const error = errno;
+			::close(file);
+			throw std::system_error(error, std::generic_category(), "Cannot stat " + path.string());
+		}
+		length_ = static_cast<std::size_t>(status.st_size);
+		if (length_ < vector_file_header_size) {
+			::close(file);
+			throw_truncated();
+		}
+		mapping_ = ::mmap(nullptr, length_, PROT_READ, MAP_SHARED, file, 0);
+		auto const error = errno;
+		::close(file);
+		if (mapping_ == MAP_FAILED) {
+			mapping_ = nullptr;
+			throw std::system_error(error, std::generic_category(), "Cannot map " + path.string());
+		}
+
+		auto header = header_bytes{};
+		std::memcpy(header.data(), mapping_, header.size());
+		try {
+			auto const layout = parse_header(header);
+			if (layout.swap_bytes) {
+				throw std::runtime_error("euclidean_vector file is in the other byte order and cannot "
+				                         "be mapped");
+			}
+			auto size = layout.size;
+			if (layout.row_bytes != 0) {
+				auto const available = (length_ - vector_file_header_size) / layout.row_bytes;
+				if (size == unknown_size) {
+					size = available;
+				}
+				else if (size > available) {
+					throw_truncated();
+				}
+			}
+			else if (size == unknown_size) {
+				// vectors with no dimensions take no room, so only the header can count them
+				size = 0;
+			}
+			magnitudes_ = reinterpret_cast<double const*>(static_cast<char const*>(mapping_)
+			                                              + vector_file_header_size);
+			size_ = static_cast<std::size_t>(size);
+			dimension_ = layout.dimensions;
+			leading_dimension_ = layout.row_bytes / sizeof(double);
+		} catch (...) {
+			unmap();
+			throw;
+		}
+	}
+
+	mapped_vector_file::mapped_vector_file(mapped_vector_file&& other) noexcept
+	: mapping_{std::exchange(other.mapping_, nullptr)}
+	, length_{std::exchange(other.length_, 0)}
+	, magnitudes_{std::exchange(other.magnitudes_, nullptr)}
+	, size_{std::exchange(other.size_, 0)}
+	, dimension_{std::exchange(other.dimension_, 0)}
+	, leading_dimension_{std::exchange(other.leading_dimension_, 0)} {}
+
+	auto mapped_vector_file::operator=(mapped_vector_file&& other) noexcept -> mapped_vector_file& {
+		if (this != &other) {
+			unmap();
+			mapping_ = std::exchange(other.mapping_, nullptr);
+			length_ = std::exchange(other.length_, 0);
+			magnitudes_ = std::exchange(other.magnitudes_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+			dimension_ = std::exchange(other.dimension_, 0);
+			leading_dimension_ = std::exchange(other.leading_dimension_, 0);
+		}
+		return *this;
+	}
+
+	mapped_vector_file::~mapped_vector_file() {
+		unmap();
+	}
+
+	auto mapped_vector_file::at(std::size_t i) const -> euclidean_vector_view {
+		if (i >= size_) {
+			throw std::out_of_range(
+			   fmt::format("Index {} is not Valid for this mapped_vector_file object", i));
+		}
+		return (*this)[i];
+	}
+
+	auto mapped_vector_file::unmap() noexcept -> void {
+		if (mapping_ != nullptr) {
+			::munmap(mapping_, length_);
+			mapping_ = nullptr;
+		}
+	}
+} // namespace comp6771
@@ -0,0 +1,217 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_format.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+namespace {
+	using comp6771::euclidean_vector;
+	using comp6771::euclidean_vector_ref;
+	using comp6771::uninitialized;
+
+	auto is_space(char c) noexcept -> bool {
+		return c == ' ' or c == '\t' or c == '\n' or c == '\r' or c == '\f' or c == '\v';
+	}
+
+	// the whitespace that may surround a CSV magnitude
+	auto is_blank(char c) noexcept -> bool {
+		return c == ' ' or c == '\t';
+	}
+
+	// Offsets are relative to `begin`, the start of the text the caller passed in.
+	[[noreturn]] auto
+	throw_parse_error(char const* begin, char const* position, std::string_view what) -> void {
+		constexpr auto message = "Cannot parse a euclidean_vector: expected {} at offset {}";
+		throw std::invalid_argument(fmt::format(message, what, position - begin));
+	}
+
+	auto parse_magnitude(char const* begin, char const* first, char const* last, double& magnitude)
+	   -> char const* {
+		// from_chars does not accept the leading '+' that some CSV writers emit
+		auto const* const number = first != last and *first == '+' ? first + 1 : first;
+		auto const [end, error] = std::from_chars(number, last, magnitude);
+		if (error == std::errc::result_out_of_range) {
+			throw_parse_error(begin, first, "a magnitude within the range of a double");
+		}
+		if (error != std::errc()) {
+			throw_parse_error(begin, first, "a magnitude");
+		}
+		return end;
+	}
+
+	// Parses `count` magnitudes from [first, last), passing each to `store` with its index. In CSV
+	// magnitudes are separated by a comma and blanks; otherwise by whitespace, a comma, or both.
+	template<typename Store>
+	auto parse_magnitudes(char const* begin,
+	                      char const* first,
+	                      char const* last,
+	                      int count,
+	                      bool csv,
+	                      Store store) -> char const* {
+		auto* const is_separator = csv ? is_blank : is_space;
+		auto it = first;
+		for (auto i = 0; i < count; ++i) {
+			if (i != 0) {
+				auto const* const previous = it;
+				it = std::find_if_not(it, last, is_separator);
+				if (it != last and *it == ',') {
+					it = std::find_if_not(it + 1, last, is_separator);
+				}
+				else if (csv or it == previous) {
+					throw_parse_error(begin, it, csv ? "','" : "a separator");
+				}
+			}
+			auto magnitude = 0.0;
+			it = parse_magnitude(begin, it, last, magnitude);
+			store(i, magnitude);
+		}
+		return it;
+	}
+
+	// the number of runs of characters that are neither whitespace nor commas
+	auto count_tokens(char const* first, char const* last) noexcept -> int {
+		auto count = 0;
+		auto in_token = false;
+		for (auto it = first; it != last; ++it) {
+			auto const separator = is_space(*it) or *it == ',';
+			count += static_cast<int>(not separator and not in_token);
+			in_token = not separator;
+		}
+		return count;
+	}
+
+	auto count_csv_fields(char const* first, char const* last) noexcept -> int {
+		if (std::find_if_not(first, last, is_blank) == last) {
+			return 0;
+		}
+		return static_cast<int>(std::count(first, last, ',')) + 1;
+	}
+
+	// Gives `vector` `dimensions` dimensions, reusing its storage if it already has them.
+	// Writing through operator[] discards the cached norm.
+	auto storage_for(euclidean_vector& vector, int dimensions) -> double* {
+		if (vector.dimensions() != dimensions) {
+			vector = euclidean_vector(uninitialized, dimensions);
+		}
+		return dimensions == 0 ? nullptr : &vector[0];
+	}
+
+	struct csv_row {
+		char const* first;
+		// the end of the row's magnitudes, before any "\r\n"
+		char const* last;
+		// the start of the next row
+		char const* next;
+	};
+
+	auto next_row(char const* first, char const* end) noexcept -> csv_row {
+		auto const* const newline = std::find(first, end, '\n');
+		auto const* last = newline;
+		if (last != first and *(last - 1) == '\r') {
+			--last;
+		}
+		return csv_row{first, last, newline == end ? end : newline + 1};
+	}
+
+	template<typename Store>
+	auto parse_row(char const* begin, csv_row const& row, int count, Store store) -> void {
+		auto const* const first = std::find_if_not(row.first, row.last, is_blank);
+		auto const* const last = parse_magnitudes(begin, first, row.last, count, true, store);
+		if (std::find_if_not(last, row.last, is_blank) != row.last) {
+			throw_parse_error(begin, last, "',' or the end of the row");
+		}
+	}
+
+	auto parse_row_into(char const* begin, csv_row const& row, euclidean_vector_ref vector) -> void {
+		auto const count = count_csv_fields(row.first, row.last);
+		if (count != vector.dimensions()) {
+			comp6771::detail::throw_dimension_mismatch(vector.dimensions(), count);
+		}
+		parse_row(begin, row, count, [&vector](int i, double magnitude) { vector[i] = magnitude; });
+	}
+} // namespace
+
+namespace comp6771 {
+	auto parse_euclidean_vector(std::string_view text) -> euclidean_vector {
+		auto vector = euclidean_vector();
+		auto const consumed = parse_euclidean_vector(text, vector);
+		auto const rest = text.substr(consumed);
+		auto const* const trailing = std::find_if_not(rest.begin(), rest.end(), is_space);
+		if (trailing != rest.end()) {
+			throw_parse_error(text.data(), trailing, "the end of the text");
+		}
+		return vector;
+	}
+
+	auto parse_euclidean_vector(std::string_view text, euclidean_vector& vector) -> std::size_t {
+		auto const* const begin = text.data();
+		auto const* const end = begin + text.size();
+		auto const* const open = std::find_if_not(begin, end, is_space);
+		if (open == end or *open != '[') {
+			throw_parse_error(begin, open, "'['");
+		}
+		auto const* const close = std::find(open + 1, end, ']');
+		if (close == end) {
+			throw_parse_error(begin, end, "']'");
+		}
+		auto const* const first = std::find_if_not(open + 1, close, is_space);
+		auto const count = count_tokens(first, close);
+		auto* const magnitudes = storage_for(vector, count);
+		auto const* const last =
+		   parse_magnitudes(begin, first, close, count, false, [magnitudes](int i, double magnitude) {
+			   magnitudes[i] = magnitude;
+		   });
+		if (std::find_if_not(last, close, is_space) != close) {
+			throw_parse_error(begin, last, "']'");
+		}
+		return static_cast<std::size_t>(close + 1 - begin);
+	}
+
+	auto parse_csv_row(std::string_view text, euclidean_vector& vector) -> std::size_t {
+		auto const* const begin = text.data();
+		auto const row = next_row(begin, begin + text.size());
+		auto const count = count_csv_fields(row.first, row.last);
+		auto* const magnitudes = storage_for(vector, count);
+		parse_row(begin, row, count, [magnitudes](int i, double magnitude) {
+			magnitudes[i] = magnitude;
+		});
+		return static_cast<std::size_t>(row.next - begin);
+	}
+
+	auto parse_csv_row(std::string_view text, euclidean_vector_ref vector) -> std::size_t {
+		auto const* const begin = text.data();
+		auto const row = next_row(begin, begin + text.size());
+		parse_row_into(begin, row, vector);
+		return static_cast<std::size_t>(row.next - begin);
+	}
+
+	auto parse_csv(std::string_view text, batch_layout layout) -> euclidean_vector_batch {
+		auto const* const begin = text.data();
+		auto const* const end = begin + text.size();
+		auto size = 0;
+		auto dimensions = 0;
+		for (auto row = next_row(begin, end); row.first != end; row = next_row(row.next, end)) {
+			if (auto const count = count_csv_fields(row.first, row.last); count != 0) {
+				dimensions = size == 0 ? count : dimensions;
+				++size;
+			}
+		}
+
+		auto batch = euclidean_vector_batch(size, dimensions, layout);
+		auto i = 0;
+		for (auto row = next_row(begin, end); row.first != end; row = next_row(row.next, end)) {
+			if (std::find_if_not(row.first, row.last, is_blank) != row.last) {
+				parse_row_into(begin, row, batch[i]);
+				++i;
+			}
+		}
+		return batch;
+	}
+} // namespace comp6771
@@ -0,0 +1,434 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_index.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+	using comp6771::batch_layout;
+	using comp6771::euclidean_vector_batch;
+	using comp6771::euclidean_vector_view;
+	using comp6771::for_each_index;
+	using comp6771::neighbour;
+	using comp6771::thread_pool;
+
+	// brute_force_index compares blocks of about this many bytes of vectors against a tile of
+	// queries, so that the block is read from cache by every query but the first
+	constexpr auto scan_block_bytes = std::size_t{1} << 18;
+	constexpr auto queries_per_tile = 8;
+	// the lane count of the kernels' summation order
+	constexpr auto small_dimensions = std::size_t{16};
+	// k-means assigns vectors to centroids in chunks of this many vectors per task
+	constexpr auto assignment_chunk = 256;
+
+	auto cast(int i) -> std::size_t {
+		return static_cast<std::size_t>(i);
+	}
+
+	auto make_pool(std::size_t threads) -> std::shared_ptr<thread_pool> {
+		if (threads == 0) {
+			throw std::invalid_argument("An index needs at least one thread");
+		}
+		return threads == 1 ? nullptr : std::make_shared<thread_pool>(threads);
+	}
+
+	auto row_major(euclidean_vector_batch const& batch) -> euclidean_vector_batch {
+		return batch.layout() == batch_layout::row_major ? batch
+		                                                 : batch.to_layout(batch_layout::row_major);
+	}
+
+	// the magnitudes of a row of a row-major batch
+	auto row(euclidean_vector_batch const& batch, int i) -> double const* {
+		return batch.data() + cast(i) * batch.leading_dimension();
+	}
+
+	// the squared distance between row i of a row-major batch and `query`
+	auto row_distance(euclidean_vector_batch const& batch, int i, double const* query)
+	   -> double {
+		auto const* const x = row(batch, i);
+		auto const dimensions = cast(batch.dimensions());
+		// Below 16 dimensions the kernels add every term to a single lane, in order, so this loop
+		// gives the same result without the cost of dispatching a kernel per vector.
+		if (dimensions < small_dimensions) {
+			auto sum = 0.0;
+			for (auto d = std::size_t{0}; d < dimensions; ++d) {
+				auto const difference = x[d] - query[d];
+				sum += difference * difference;
+			}
+			return sum;
+		}
+		return comp6771::kernels::squared_distance(x, query, dimensions);
+	}
+
+	auto check_query(int index_dimensions, int query_dimensions, int k) -> void {
+		if (index_dimensions != query_dimensions) {
+			comp6771::detail::throw_dimension_mismatch(index_dimensions, query_dimensions);
+		}
+		if (k < 0) {
+			throw std::invalid_argument("A nearest-neighbour search needs a non-negative k");
+		}
+	}
+
+	// A strided query is gathered into `scratch` so that the SIMD kernels can read it.
+	auto contiguous(euclidean_vector_view query, std::vector<double>& scratch) -> double const* {
+		if (query.is_contiguous()) {
+			return query.data();
+		}
+		scratch = static_cast<std::vector<double>>(query);
+		return scratch.data();
+	}
+
+	// Candidates are ordered by squared distance and then by row. The k best so far are kept in a
+	// max-heap, so the worst of them is the one a closer candidate replaces.
+	auto closer(neighbour const& x, neighbour const& y) noexcept -> bool {
+		return x.distance < y.distance or (x.distance == y.distance and x.row < y.row);
+	}
+
+	auto offer(std::vector<neighbour>& heap, int k, neighbour const candidate) -> void {
+		if (heap.size() < cast(k)) {
+			heap.push_back(candidate);
+			std::push_heap(heap.begin(), heap.end(), closer);
+		}
+		else if (k > 0 and closer(candidate, heap.front())) {
+			std::pop_heap(heap.begin(), heap.end(), closer);
+			heap.back() = candidate;
+			std::push_heap(heap.begin(), heap.end(), closer);
+		}
+	}
+
+	// the squared distance a candidate must beat to be kept
+	auto worst(std::vector<neighbour> const& heap, int k) -> double {
+		return heap.size() < cast(k) ? std::numeric_limits<double>::infinity()
+		                             : heap.front().distance;
+	}
+
+	auto finish(std::vector<neighbour>& heap) -> std::vector<neighbour> {
+		std::sort_heap(heap.begin(), heap.end(), closer);
+		for (auto& candidate : heap) {
+			candidate.distance = std::sqrt(candidate.distance);
+		}
+		return std::move(heap);
+	}
+
+	// Calls search(query) with each row of `queries`, shared out across the pool in tiles of
+	// `tile` queries, and returns the results in row order.
+	template<typename Search>
+	auto search_each(thread_pool* pool,
+	                 euclidean_vector_batch const& queries,
+	                 int tile,
+	                 Search const& search) -> std::vector<std::vector<neighbour>> {
+		auto const rows = row_major(queries);
+		auto results = std::vector<std::vector<neighbour>>(cast(rows.size()));
+		auto const tiles = (rows.size() + tile - 1) / tile;
+		for_each_index(pool, cast(tiles), [&](std::size_t const t) {
+			auto const first = static_cast<int>(t) * tile;
+			auto const last = std::min(first + tile, rows.size());
+			for (auto i = first; i < last; ++i) {
+				results[cast(i)] = search(row(rows, i));
+			}
+		});
+		return results;
+	}
+
+	// the rows of `vectors` in the order `rows` lists them
+	auto gather(euclidean_vector_batch const& vectors, std::vector<int> const& rows)
+	   -> euclidean_vector_batch {
+		auto result = euclidean_vector_batch(static_cast<int>(rows.size()), vectors.dimensions());
+		for (auto i = std::size_t{0}; i < rows.size(); ++i) {
+			result.assign(static_cast<int>(i), vectors[rows[i]]);
+		}
+		return result;
+	}
+
+	// the centroid nearest each vector in [first, last), the lowest-numbered on a tie
+	auto assign_nearest(euclidean_vector_batch const& vectors,
+	                    euclidean_vector_batch const& centroids,
+	                    int first,
+	                    int last,
+	                    std::vector<int>& assignment) -> void {
+		for (auto i = first; i < last; ++i) {
+			auto best = 0;
+			auto best_distance = std::numeric_limits<double>::infinity();
+			for (auto c = 0; c < centroids.size(); ++c) {
+				auto const distance = row_distance(centroids, c, row(vectors, i));
+				if (distance < best_distance) {
+					best = c;
+					best_distance = distance;
+				}
+			}
+			assignment[cast(i)] = best;
+		}
+	}
+} // namespace
+
+namespace comp6771 {
+	brute_force_index::brute_force_index(euclidean_vector_batch const& vectors,
+	                                     std::size_t const threads)
+	: vectors_{row_major(vectors)}
+	, pool_{make_pool(threads)} {}
+
+	auto brute_force_index::search(euclidean_vector_view query, int k) const
+	   -> std::vector<neighbour> {
+		check_query(dimensions(), query.dimensions(), k);
+		auto scratch = std::vector<double>();
+		auto const* const magnitudes = contiguous(query, scratch);
+		auto heap = std::vector<neighbour>();
+		for (auto i = 0; i < size(); ++i) {
+			offer(heap, k, {i, row_distance(vectors_, i, magnitudes)});
+		}
+		return finish(heap);
+	}
+
+	auto brute_force_index::search(euclidean_vector_batch const& queries, int k) const
+	   -> std::vector<std::vector<neighbour>> {
+		check_query(dimensions(), queries.dimensions(), k);
+		auto const rows = row_major(queries);
+		auto const row_bytes = std::max(vectors_.leading_dimension(), std::size_t{1})
+		                       * sizeof(double);
+		auto const block = static_cast<int>(std::max(scan_block_bytes / row_bytes, std::size_t{1}));
+		auto results = std::vector<std::vector<neighbour>>(cast(rows.size()));
+		auto const tiles = (rows.size() + queries_per_tile - 1) / queries_per_tile;
+		for_each_index(pool_.get(), cast(tiles), [&](std::size_t const t) {
+			auto const first = static_cast<int>(t) * queries_per_tile;
+			auto const last = std::min(first + queries_per_tile, rows.size());
+			for (auto start = 0; start < size(); start += block) {
+				auto const end = std::min(start + block, size());
+				for (auto q = first; q < last; ++q) {
+					auto& heap = results[cast(q)];
+					for (auto i = start; i < end; ++i) {
+						offer(heap, k, {i, row_distance(vectors_, i, row(rows, q))});
+					}
+				}
+			}
+			for (auto q = first; q < last; ++q) {
+				auto nearest = finish(results[cast(q)]);
+				results[cast(q)] = std::move(nearest);
+			}
+		});
+		return results;
+	}
+
+	kd_tree_index::kd_tree_index(euclidean_vector_batch const& vectors, std::size_t const threads)
+	: vectors_{0, vectors.dimensions()}
+	, rows_(cast(vectors.size()))
+	, depth_{0}
+	, pool_{make_pool(threads)} {
+		auto const n = cast(vectors.size());
+		while ((n >> cast(depth_)) > cast(leaf_size)) {
+			++depth_;
+		}
+		auto const internal_nodes = (std::size_t{1} << cast(depth_)) - 1;
+		split_dimension_.resize(internal_nodes);
+		split_value_.resize(internal_nodes);
+		std::iota(rows_.begin(), rows_.end(), 0);
+
+		// Node j of level l covers rows_[j * n / 2^l, (j + 1) * n / 2^l), so the nodes of a level
+		// cover disjoint ranges and can be split in parallel.
+		for (auto level = 0; level < depth_; ++level) {
+			auto const nodes = std::size_t{1} << cast(level);
+			for_each_index(pool_.get(), nodes, [&](std::size_t const j) {
+				auto const at = [&](std::size_t const numerator, std::size_t const denominator) {
+					return rows_.begin() + static_cast<std::ptrdiff_t>(numerator * n / denominator);
+				};
+				auto const first = at(j, nodes);
+				auto const middle = at(2 * j + 1, 2 * nodes);
+				auto const last = at(j + 1, nodes);
+				auto widest = 0;
+				auto widest_spread = -1.0;
+				for (auto d = 0; d < vectors.dimensions(); ++d) {
+					auto const [low, high] = std::minmax_element(
+					   first, last, [&](int x, int y) { return vectors(x, d) < vectors(y, d); });
+					auto const spread = vectors(*high, d) - vectors(*low, d);
+					if (spread > widest_spread) {
+						widest = d;
+						widest_spread = spread;
+					}
+				}
+				std::nth_element(first, middle, last, [&](int x, int y) {
+					return vectors(x, widest) < vectors(y, widest)
+					       or (vectors(x, widest) == vectors(y, widest) and x < y);
+				});
+				split_dimension_[nodes - 1 + j] = widest;
+				split_value_[nodes - 1 + j] = vectors(*middle, widest);
+			});
+		}
+		vectors_ = gather(vectors, rows_);
+	}
+
+	auto kd_tree_index::search(double const* query, int k, std::vector<neighbour>& heap) const
+	   -> void {
+		auto const n = cast(size());
+		auto visit = [&](auto const& self, int level, std::size_t j) -> void {
+			auto const nodes = std::size_t{1} << cast(level);
+			if (level == depth_) {
+				auto const last = static_cast<int>((j + 1) * n / nodes);
+				for (auto i = static_cast<int>(j * n / nodes); i < last; ++i) {
+					offer(heap, k, {rows_[cast(i)], row_distance(vectors_, i, query)});
+				}
+				return;
+			}
+			auto const node = nodes - 1 + j;
+			auto const offset = query[split_dimension_[node]] - split_value_[node];
+			auto const near = offset < 0 ? 2 * j : 2 * j + 1;
+			self(self, level + 1, near);
+			// every vector on the far side is at least |offset| away
+			if (offset * offset <= worst(heap, k)) {
+				self(self, level + 1, near ^ 1U);
+			}
+		};
+		visit(visit, 0, 0);
+	}
+
+	auto kd_tree_index::search(euclidean_vector_view query, int k) const -> std::vector<neighbour> {
+		check_query(dimensions(), query.dimensions(), k);
+		auto scratch = std::vector<double>();
+		auto heap = std::vector<neighbour>();
+		if (k > 0) {
+			search(contiguous(query, scratch), k, heap);
+		}
+		return finish(heap);
+	}
+
+	auto kd_tree_index::search(euclidean_vector_batch const& queries, int k) const
+	   -> std::vector<std::vector<neighbour>> {
+		check_query(dimensions(), queries.dimensions(), k);
+		return search_each(pool_.get(), queries, queries_per_tile, [&](double const* query) {
+			auto heap = std::vector<neighbour>();
+			if (k > 0) {
+				search(query, k, heap);
+			}
+			return finish(heap);
+		});
+	}
+
+	ivf_index::ivf_index(euclidean_vector_batch const& vectors,
+	                     ivf_options const& options,
+	                     std::size_t const threads)
+	: centroids_{0, vectors.dimensions()}
+	, vectors_{0, vectors.dimensions()}
+	, pool_{make_pool(threads)} {
+		if (options.lists <= 0 or options.iterations < 0) {
+			throw std::invalid_argument("An ivf_index needs a positive number of lists and a "
+			                            "non-negative number of iterations");
+		}
+		auto const data = row_major(vectors);
+		auto const n = data.size();
+		auto const lists = std::min(options.lists, n);
+
+		// seed the centroids with distinct vectors picked at random
+		auto seeds = std::vector<int>(cast(n));
+		std::iota(seeds.begin(), seeds.end(), 0);
+		auto engine = std::mt19937_64(options.seed);
+		for (auto i = 0; i < lists; ++i) {
+			auto const pick = std::uniform_int_distribution<int>(i, n - 1)(engine);
+			std::swap(seeds[cast(i)], seeds[cast(pick)]);
+		}
+		seeds.resize(cast(lists));
+		centroids_ = gather(data, seeds);
+
+		auto assignment = std::vector<int>(cast(n));
+		auto const chunks = cast((n + assignment_chunk - 1) / assignment_chunk);
+		auto const assign = [&] {
+			for_each_index(pool_.get(), chunks, [&](std::size_t const c) {
+				auto const first = static_cast<int>(c) * assignment_chunk;
+				auto const last = std::min(first + assignment_chunk, n);
+				assign_nearest(data, centroids_, first, last, assignment);
+			});
+		};
+		assign();
+		auto const d = cast(data.dimensions());
+		for (auto iteration = 0; iteration < options.iterations; ++iteration) {
+			// summed in row order, so the centroids do not depend on the number of threads
+			auto sums = euclidean_vector_batch(lists, data.dimensions());
+			auto counts = std::vector<int>(cast(lists));
+			for (auto i = 0; i < n; ++i) {
+				auto const c = assignment[cast(i)];
+				auto* const sum = sums.data() + cast(c) * sums.leading_dimension();
+				kernels::add(sum, sum, row(data, i), d);
+				++counts[cast(c)];
+			}
+			for (auto c = 0; c < lists; ++c) {
+				// an empty cluster keeps its centroid
+				if (counts[cast(c)] > 0) {
+					kernels::divide(centroids_.data() + cast(c) * centroids_.leading_dimension(),
+					                row(sums, c),
+					                static_cast<double>(counts[cast(c)]),
+					                d);
+				}
+			}
+			auto const previous = assignment;
+			assign();
+			if (assignment == previous) {
+				break;
+			}
+		}
+
+		// group the vectors by cluster, keeping row order within each
+		offsets_.assign(cast(lists) + 1, 0);
+		for (auto const c : assignment) {
+			++offsets_[cast(c) + 1];
+		}
+		std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+		rows_.resize(cast(n));
+		auto next = offsets_;
+		for (auto i = 0; i < n; ++i) {
+			rows_[cast(next[cast(assignment[cast(i)])]++)] = i;
+		}
+		vectors_ = gather(data, rows_);
+	}
+
+	auto ivf_index::search(double const* query,
+	                       int k,
+	                       int probes,
+	                       std::vector<neighbour>& heap) const -> void {
+		auto nearest = std::vector<neighbour>();
+		nearest.reserve(cast(lists()));
+		for (auto c = 0; c < lists(); ++c) {
+			nearest.push_back({c, row_distance(centroids_, c, query)});
+		}
+		auto const probed = nearest.begin() + std::min(probes, lists());
+		std::partial_sort(nearest.begin(), probed, nearest.end(), closer);
+		for (auto list = nearest.begin(); list != probed; ++list) {
+			auto const last = offsets_[cast(list->row) + 1];
+			for (auto i = offsets_[cast(list->row)]; i < last; ++i) {
+				offer(heap, k, {rows_[cast(i)], row_distance(vectors_, i, query)});
+			}
+		}
+	}
+
+	auto ivf_index::search(euclidean_vector_view query, int k, int probes) const
+	   -> std::vector<neighbour> {
+		check_query(dimensions(), query.dimensions(), k);
+		if (probes <= 0) {
+			throw std::invalid_argument("An ivf_index search needs a positive number of probes");
+		}
+		auto scratch = std::vector<double>();
+		auto heap = std::vector<neighbour>();
+		search(contiguous(query, scratch), k, probes, heap);
+		return finish(heap);
+	}
+
+	auto ivf_index::search(euclidean_vector_batch const& queries, int k, int probes) const
+	   -> std::vector<std::vector<neighbour>> {
+		check_query(dimensions(), queries.dimensions(), k);
+		if (probes <= 0) {
+			throw std::invalid_argument("An ivf_index search needs a positive number of probes");
+		}
+		return search_each(pool_.get(), queries, queries_per_tile, [&](double const* query) {
+			auto heap = std::vector<neighbour>();
+			search(query, k, probes, heap);
+			return finish(heap);
+		});
+	}
+} // namespace comp6771
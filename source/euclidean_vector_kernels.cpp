@@ -0,0 +1,1771 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define COMP6771_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+	using comp6771::bfloat16;
+	using comp6771::kernels::dot_terms;
+	using comp6771::kernels::simd_level;
+	using comp6771::kernels::welford_accumulators;
+
+	// number of partial sums a reduction keeps; see the header for the summation order
+	constexpr auto lanes = std::size_t{16};
+
+	enum class operation {
+		add,
+		subtract,
+		multiply,
+		divide,
+		scale_add,
+		squared_difference,
+		lerp,
+		fused_scale_add,
+	};
+
+	// out[i] = apply<Op>(x[i], y[i], s)
+	template<operation Op>
+	auto apply(double x, double y, double s) noexcept -> double {
+		if constexpr (Op == operation::add) {
+			return x + y;
+		}
+		else if constexpr (Op == operation::subtract) {
+			return x - y;
+		}
+		else if constexpr (Op == operation::multiply) {
+			return x * s;
+		}
+		else if constexpr (Op == operation::divide) {
+			return x / s;
+		}
+		else if constexpr (Op == operation::scale_add) {
+			return x * s + y;
+		}
+		else if constexpr (Op == operation::squared_difference) {
+			auto const difference = x - s;
+			return y + difference * difference;
+		}
+		else if constexpr (Op == operation::lerp) {
+			return x + s * (y - x);
+		}
+		else {
+			return std::fma(s, x, y);
+		}
+	}
+
+	// Multiply and divide only use the scalar `s`; `y` is null for them.
+	template<operation Op>
+	constexpr auto reads_y = not(Op == operation::multiply or Op == operation::divide);
+
+	// A reduction sums term<R>(x[i], y[i]) in the order the header documents.
+	enum class reduction { dot, squared_distance };
+
+	template<reduction R>
+	auto term(double x, double y) noexcept -> double {
+		if constexpr (R == reduction::dot) {
+			return x * y;
+		}
+		else {
+			auto const difference = x - y;
+			return difference * difference;
+		}
+	}
+
+	template<reduction R>
+	auto add_tail(double sum, double const* x, double const* y, std::size_t first, std::size_t size)
+	   -> double {
+		for (auto i = first; i < size; ++i) {
+			sum += term<R>(x[i], y[i]);
+		}
+		return sum;
+	}
+
+	template<operation Op>
+	auto elementwise_tail(double* out,
+	                      double const* x,
+	                      double const* y,
+	                      double s,
+	                      std::size_t first,
+	                      std::size_t size) noexcept -> void {
+		for (auto i = first; i < size; ++i) {
+			out[i] = apply<Op>(x[i], reads_y<Op> ? y[i] : 0.0, s);
+		}
+	}
+
+	// Reduces the lanes to one in the order the header documents.
+	auto fold_scalar(std::array<double, lanes>& acc) noexcept -> double {
+		for (auto width = lanes / 2; width > 0; width /= 2) {
+			for (auto j = std::size_t{0}; j < width; ++j) {
+				acc[j] += acc[j + width];
+			}
+		}
+		return acc[0];
+	}
+
+	template<reduction R>
+	auto reduce_scalar(double const* x, double const* y, std::size_t size) noexcept -> double {
+		auto acc = std::array<double, lanes>{};
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			for (auto j = std::size_t{0}; j < lanes; ++j) {
+				acc[j] += term<R>(x[i + j], y[i + j]);
+			}
+		}
+		return add_tail<R>(fold_scalar(acc), x, y, blocked, size);
+	}
+
+	auto dot_terms_scalar(double const* x, double const* y, std::size_t size) noexcept
+	   -> dot_terms {
+		auto xy = std::array<double, lanes>{};
+		auto xx = std::array<double, lanes>{};
+		auto yy = std::array<double, lanes>{};
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			for (auto j = std::size_t{0}; j < lanes; ++j) {
+				xy[j] += x[i + j] * y[i + j];
+				xx[j] += x[i + j] * x[i + j];
+				yy[j] += y[i + j] * y[i + j];
+			}
+		}
+		return {add_tail<reduction::dot>(fold_scalar(xy), x, y, blocked, size),
+		        add_tail<reduction::dot>(fold_scalar(xx), x, x, blocked, size),
+		        add_tail<reduction::dot>(fold_scalar(yy), y, y, blocked, size)};
+	}
+
+	// a sum and the rounding errors it has accumulated
+	struct compensated_sum {
+		double sum;
+		double error;
+	};
+
+	// Once the sum overflows, its error is infinite or NaN and means nothing.
+	auto total(compensated_sum const& s) noexcept -> double {
+		return std::isfinite(s.sum) ? s.sum + s.error : s.sum;
+	}
+
+	// acc + x * y. The product's error comes from a fused multiply-add and the sum's from Knuth's
+	// TwoSum, which needs no branch, so the SIMD kernels compute exactly the same steps.
+	auto compensated_step(compensated_sum const acc, double const x, double const y) noexcept
+	   -> compensated_sum {
+		auto const product = x * y;
+		auto const product_error = std::fma(x, y, -product);
+		auto const sum = acc.sum + product;
+		auto const z = sum - acc.sum;
+		auto const sum_error = (acc.sum - (sum - z)) + (product - z);
+		return {sum, acc.error + (sum_error + product_error)};
+	}
+
+	auto combine(compensated_sum const a, compensated_sum const b) noexcept -> compensated_sum {
+		auto const sum = a.sum + b.sum;
+		auto const z = sum - a.sum;
+		auto const sum_error = (a.sum - (sum - z)) + (b.sum - z);
+		return {sum, (a.error + b.error) + sum_error};
+	}
+
+	// Folds the lanes in the order the header documents, then adds the remaining terms.
+	auto finish_compensated(std::array<compensated_sum, lanes>& acc,
+	                        double const* x,
+	                        double const* y,
+	                        std::size_t first,
+	                        std::size_t size) noexcept -> compensated_sum {
+		for (auto width = lanes / 2; width > 0; width /= 2) {
+			for (auto j = std::size_t{0}; j < width; ++j) {
+				acc[j] = combine(acc[j], acc[j + width]);
+			}
+		}
+		auto result = acc[0];
+		for (auto i = first; i < size; ++i) {
+			result = compensated_step(result, x[i], y[i]);
+		}
+		return result;
+	}
+
+	auto compensated_dot_scalar(double const* x, double const* y, std::size_t size) noexcept
+	   -> compensated_sum {
+		auto acc = std::array<compensated_sum, lanes>{};
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			for (auto j = std::size_t{0}; j < lanes; ++j) {
+				acc[j] = compensated_step(acc[j], x[i + j], y[i + j]);
+			}
+		}
+		return finish_compensated(acc, x, y, blocked, size);
+	}
+
+	// Widening float or bfloat16 to double is exact, and so is the product of two widened values.
+	auto widen(float const x) noexcept -> double {
+		return x;
+	}
+
+	auto widen(bfloat16 const x) noexcept -> double {
+		return static_cast<float>(x);
+	}
+
+	template<typename T>
+	auto widening_dot_scalar(T const* x, T const* y, std::size_t size) noexcept -> double {
+		auto acc = std::array<double, lanes>{};
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			for (auto j = std::size_t{0}; j < lanes; ++j) {
+				acc[j] += widen(x[i + j]) * widen(y[i + j]);
+			}
+		}
+		auto sum = fold_scalar(acc);
+		for (auto i = blocked; i < size; ++i) {
+			sum += widen(x[i]) * widen(y[i]);
+		}
+		return sum;
+	}
+
+	auto int8_dot_scalar(std::int8_t const* x, std::int8_t const* y, std::size_t size) noexcept
+	   -> std::int64_t {
+		auto sum = std::int64_t{0};
+		for (auto i = std::size_t{0}; i < size; ++i) {
+			sum += x[i] * y[i];
+		}
+		return sum;
+	}
+
+	enum class comparison { exact, approximate };
+
+	// Whether x and y are equal or, for approximate comparisons, close: their difference is finite
+	// and within the larger of the absolute tolerance and the relative tolerance times the larger
+	// magnitude.
+	template<comparison C>
+	auto close(double const x,
+	           double const y,
+	           double const absolute_tolerance,
+	           double const relative_tolerance) noexcept -> bool {
+		if constexpr (C == comparison::exact) {
+			return x == y;
+		}
+		else {
+			auto const difference = std::abs(x - y);
+			auto const tolerance =
+			   std::max(absolute_tolerance, relative_tolerance * std::max(std::abs(x), std::abs(y)));
+			auto const finite = difference < std::numeric_limits<double>::infinity();
+			return x == y or (finite and difference <= tolerance);
+		}
+	}
+
+	template<comparison C>
+	auto compare_tail(double const* x,
+	                  double const* y,
+	                  std::size_t first,
+	                  std::size_t size,
+	                  double absolute_tolerance,
+	                  double relative_tolerance) noexcept -> bool {
+		for (auto i = first; i < size; ++i) {
+			if (not close<C>(x[i], y[i], absolute_tolerance, relative_tolerance)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<comparison C>
+	auto compare_scalar(double const* x,
+	                    double const* y,
+	                    std::size_t size,
+	                    double absolute_tolerance,
+	                    double relative_tolerance) noexcept -> bool {
+		return compare_tail<C>(x, y, 0, size, absolute_tolerance, relative_tolerance);
+	}
+
+	// kernels::welford_step on [first, size); always inlined, so a wider kernel's tail does not pay
+	// for switching from AVX to SSE registers
+	[[gnu::always_inline]] inline auto welford_tail(welford_accumulators const& acc,
+	                                                double const* x,
+	                                                double const reciprocal_count,
+	                                                std::size_t const first,
+	                                                std::size_t const size) noexcept -> void {
+		for (auto i = first; i < size; ++i) {
+			auto const value = x[i];
+			acc.sum[i] += value;
+			auto const delta = value - acc.mean[i];
+			acc.mean[i] += delta * reciprocal_count;
+			acc.m2[i] += delta * (value - acc.mean[i]);
+			// the same operand order as the SIMD min and max instructions
+			acc.min[i] = value < acc.min[i] ? value : acc.min[i];
+			acc.max[i] = value > acc.max[i] ? value : acc.max[i];
+		}
+	}
+
+	auto welford_scalar(welford_accumulators const& acc,
+	                    double const* x,
+	                    double const reciprocal_count,
+	                    std::size_t const size) noexcept -> void {
+		welford_tail(acc, x, reciprocal_count, 0, size);
+	}
+
+	template<operation Op>
+	auto elementwise_scalar(double* out,
+	                        double const* x,
+	                        double const* y,
+	                        double s,
+	                        std::size_t size) noexcept -> void {
+		elementwise_tail<Op>(out, x, y, s, 0, size);
+	}
+
+#ifdef COMP6771_X86_KERNELS
+	template<operation Op>
+	auto apply_sse2(__m128d x, __m128d y, __m128d s) noexcept -> __m128d {
+		if constexpr (Op == operation::add) {
+			return _mm_add_pd(x, y);
+		}
+		else if constexpr (Op == operation::subtract) {
+			return _mm_sub_pd(x, y);
+		}
+		else if constexpr (Op == operation::multiply) {
+			return _mm_mul_pd(x, s);
+		}
+		else if constexpr (Op == operation::divide) {
+			return _mm_div_pd(x, s);
+		}
+		else if constexpr (Op == operation::scale_add) {
+			return _mm_add_pd(_mm_mul_pd(x, s), y);
+		}
+		else if constexpr (Op == operation::squared_difference) {
+			auto const difference = _mm_sub_pd(x, s);
+			return _mm_add_pd(y, _mm_mul_pd(difference, difference));
+		}
+		else {
+			static_assert(Op == operation::lerp, "SSE2 has no fused multiply-add");
+			return _mm_add_pd(x, _mm_mul_pd(s, _mm_sub_pd(y, x)));
+		}
+	}
+
+	// acc + term<R>(x[0..2), y[0..2))
+	template<reduction R>
+	auto accumulate_sse2(__m128d acc, double const* x, double const* y) noexcept -> __m128d {
+		if constexpr (R == reduction::dot) {
+			return _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(x), _mm_loadu_pd(y)));
+		}
+		else {
+			auto const difference = _mm_sub_pd(_mm_loadu_pd(x), _mm_loadu_pd(y));
+			return _mm_add_pd(acc, _mm_mul_pd(difference, difference));
+		}
+	}
+
+	template<reduction R>
+	auto reduce_sse2(double const* x, double const* y, std::size_t size) noexcept -> double {
+		constexpr auto width = std::size_t{2};
+		auto acc0 = _mm_setzero_pd();
+		auto acc1 = _mm_setzero_pd();
+		auto acc2 = _mm_setzero_pd();
+		auto acc3 = _mm_setzero_pd();
+		auto acc4 = _mm_setzero_pd();
+		auto acc5 = _mm_setzero_pd();
+		auto acc6 = _mm_setzero_pd();
+		auto acc7 = _mm_setzero_pd();
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			auto const* const xs = x + i;
+			auto const* const ys = y + i;
+			acc0 = accumulate_sse2<R>(acc0, xs, ys);
+			acc1 = accumulate_sse2<R>(acc1, xs + width, ys + width);
+			acc2 = accumulate_sse2<R>(acc2, xs + 2 * width, ys + 2 * width);
+			acc3 = accumulate_sse2<R>(acc3, xs + 3 * width, ys + 3 * width);
+			acc4 = accumulate_sse2<R>(acc4, xs + 4 * width, ys + 4 * width);
+			acc5 = accumulate_sse2<R>(acc5, xs + 5 * width, ys + 5 * width);
+			acc6 = accumulate_sse2<R>(acc6, xs + 6 * width, ys + 6 * width);
+			acc7 = accumulate_sse2<R>(acc7, xs + 7 * width, ys + 7 * width);
+		}
+		acc0 = _mm_add_pd(acc0, acc4);
+		acc1 = _mm_add_pd(acc1, acc5);
+		acc2 = _mm_add_pd(acc2, acc6);
+		acc3 = _mm_add_pd(acc3, acc7);
+		acc0 = _mm_add_pd(acc0, acc2);
+		acc1 = _mm_add_pd(acc1, acc3);
+		auto const pair = _mm_add_pd(acc0, acc1);
+		auto const sum = _mm_cvtsd_f64(pair) + _mm_cvtsd_f64(_mm_unpackhi_pd(pair, pair));
+		return add_tail<R>(sum, x, y, blocked, size);
+	}
+
+	template<operation Op>
+	auto elementwise_sse2(double* out,
+	                      double const* x,
+	                      double const* y,
+	                      double s,
+	                      std::size_t size) noexcept -> void {
+		constexpr auto width = std::size_t{2};
+		auto const broadcast = _mm_set1_pd(s);
+		auto const blocked = size - size % width;
+		for (auto i = std::size_t{0}; i < blocked; i += width) {
+			auto const ys = reads_y<Op> ? _mm_loadu_pd(y + i) : _mm_setzero_pd();
+			_mm_storeu_pd(out + i, apply_sse2<Op>(_mm_loadu_pd(x + i), ys, broadcast));
+		}
+		elementwise_tail<Op>(out, x, y, s, blocked, size);
+	}
+
+	auto welford_sse2(welford_accumulators const& accumulators,
+	                  double const* x,
+	                  double const reciprocal_count,
+	                  std::size_t const size) noexcept -> void {
+		// a local copy, so the compiler need not reload the pointers after every store
+		auto const acc = accumulators;
+		constexpr auto width = std::size_t{2};
+		auto const reciprocal = _mm_set1_pd(reciprocal_count);
+		auto const blocked = size - size % width;
+		for (auto i = std::size_t{0}; i < blocked; i += width) {
+			auto const value = _mm_loadu_pd(x + i);
+			_mm_storeu_pd(acc.sum + i, _mm_add_pd(_mm_loadu_pd(acc.sum + i), value));
+			auto const mean = _mm_loadu_pd(acc.mean + i);
+			auto const delta = _mm_sub_pd(value, mean);
+			auto const updated = _mm_add_pd(mean, _mm_mul_pd(delta, reciprocal));
+			_mm_storeu_pd(acc.mean + i, updated);
+			auto const m2 = _mm_loadu_pd(acc.m2 + i);
+			_mm_storeu_pd(acc.m2 + i, _mm_add_pd(m2, _mm_mul_pd(delta, _mm_sub_pd(value, updated))));
+			_mm_storeu_pd(acc.min + i, _mm_min_pd(value, _mm_loadu_pd(acc.min + i)));
+			_mm_storeu_pd(acc.max + i, _mm_max_pd(value, _mm_loadu_pd(acc.max + i)));
+		}
+		welford_tail(acc, x, reciprocal_count, blocked, size);
+	}
+
+	// all ones in the lanes where close<C>(x, y, ...) holds
+	template<comparison C>
+	auto close_sse2(__m128d x, __m128d y, __m128d absolute_tolerance, __m128d relative_tolerance)
+	   noexcept -> __m128d {
+		if constexpr (C == comparison::exact) {
+			return _mm_cmpeq_pd(x, y);
+		}
+		else {
+			auto const sign = _mm_set1_pd(-0.0);
+			auto const difference = _mm_andnot_pd(sign, _mm_sub_pd(x, y));
+			auto const larger = _mm_max_pd(_mm_andnot_pd(sign, x), _mm_andnot_pd(sign, y));
+			auto const tolerance =
+			   _mm_max_pd(absolute_tolerance, _mm_mul_pd(relative_tolerance, larger));
+			auto const infinity = _mm_set1_pd(std::numeric_limits<double>::infinity());
+			auto const within = _mm_and_pd(_mm_cmplt_pd(difference, infinity),
+			                               _mm_cmple_pd(difference, tolerance));
+			return _mm_or_pd(_mm_cmpeq_pd(x, y), within);
+		}
+	}
+
+	// Compares a block of lanes at a time and stops at the first block with a pair that is not
+	// close.
+	template<comparison C>
+	auto compare_sse2(double const* x,
+	                  double const* y,
+	                  std::size_t size,
+	                  double absolute_tolerance,
+	                  double relative_tolerance) noexcept -> bool {
+		constexpr auto width = std::size_t{2};
+		auto const absolute = _mm_set1_pd(absolute_tolerance);
+		auto const relative = _mm_set1_pd(relative_tolerance);
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			auto all = _mm_castsi128_pd(_mm_set1_epi32(-1));
+			for (auto j = i; j < i + lanes; j += width) {
+				auto const pair =
+				   close_sse2<C>(_mm_loadu_pd(x + j), _mm_loadu_pd(y + j), absolute, relative);
+				all = _mm_and_pd(all, pair);
+			}
+			if (_mm_movemask_pd(all) != 0b11) {
+				return false;
+			}
+		}
+		return compare_tail<C>(x, y, blocked, size, absolute_tolerance, relative_tolerance);
+	}
+
+	template<reduction R>
+	[[gnu::target("avx2,fma")]] auto
+	accumulate_avx2(__m256d acc, double const* x, double const* y) noexcept -> __m256d {
+		if constexpr (R == reduction::dot) {
+			return _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(x), _mm256_loadu_pd(y)));
+		}
+		else {
+			auto const difference = _mm256_sub_pd(_mm256_loadu_pd(x), _mm256_loadu_pd(y));
+			return _mm256_add_pd(acc, _mm256_mul_pd(difference, difference));
+		}
+	}
+
+	// Reduces four lanes to one in the order the header documents.
+	[[gnu::target("avx2,fma")]] auto fold_avx2(__m256d acc) noexcept -> double {
+		auto const pair = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+		return _mm_cvtsd_f64(pair) + _mm_cvtsd_f64(_mm_unpackhi_pd(pair, pair));
+	}
+
+	template<operation Op>
+	[[gnu::target("avx2,fma")]] auto
+	apply_avx2(__m256d x, __m256d y, __m256d s) noexcept -> __m256d {
+		if constexpr (Op == operation::add) {
+			return _mm256_add_pd(x, y);
+		}
+		else if constexpr (Op == operation::subtract) {
+			return _mm256_sub_pd(x, y);
+		}
+		else if constexpr (Op == operation::multiply) {
+			return _mm256_mul_pd(x, s);
+		}
+		else if constexpr (Op == operation::divide) {
+			return _mm256_div_pd(x, s);
+		}
+		else if constexpr (Op == operation::scale_add) {
+			return _mm256_add_pd(_mm256_mul_pd(x, s), y);
+		}
+		else if constexpr (Op == operation::squared_difference) {
+			auto const difference = _mm256_sub_pd(x, s);
+			return _mm256_add_pd(y, _mm256_mul_pd(difference, difference));
+		}
+		else if constexpr (Op == operation::lerp) {
+			return _mm256_add_pd(x, _mm256_mul_pd(s, _mm256_sub_pd(y, x)));
+		}
+		else {
+			return _mm256_fmadd_pd(s, x, y);
+		}
+	}
+
+	template<reduction R>
+	[[gnu::target("avx2,fma")]] auto
+	reduce_avx2(double const* x, double const* y, std::size_t size) noexcept -> double {
+		constexpr auto width = std::size_t{4};
+		auto acc0 = _mm256_setzero_pd();
+		auto acc1 = _mm256_setzero_pd();
+		auto acc2 = _mm256_setzero_pd();
+		auto acc3 = _mm256_setzero_pd();
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			auto const* const xs = x + i;
+			auto const* const ys = y + i;
+			acc0 = accumulate_avx2<R>(acc0, xs, ys);
+			acc1 = accumulate_avx2<R>(acc1, xs + width, ys + width);
+			acc2 = accumulate_avx2<R>(acc2, xs + 2 * width, ys + 2 * width);
+			acc3 = accumulate_avx2<R>(acc3, xs + 3 * width, ys + 3 * width);
+		}
+		acc0 = _mm256_add_pd(acc0, acc2);
+		acc1 = _mm256_add_pd(acc1, acc3);
+		return add_tail<R>(fold_avx2(_mm256_add_pd(acc0, acc1)), x, y, blocked, size);
+	}
+
+	// partial sums of x * y, x * x and y * y
+	struct terms_avx2 {
+		__m256d xy;
+		__m256d xx;
+		__m256d yy;
+	};
+
+	[[gnu::target("avx2,fma")]] auto
+	accumulate_terms_avx2(terms_avx2 acc, double const* x, double const* y) noexcept -> terms_avx2 {
+		auto const xs = _mm256_loadu_pd(x);
+		auto const ys = _mm256_loadu_pd(y);
+		return {_mm256_add_pd(acc.xy, _mm256_mul_pd(xs, ys)),
+		        _mm256_add_pd(acc.xx, _mm256_mul_pd(xs, xs)),
+		        _mm256_add_pd(acc.yy, _mm256_mul_pd(ys, ys))};
+	}
+
+	[[gnu::target("avx2,fma")]] auto add_terms_avx2(terms_avx2 a, terms_avx2 b) noexcept
+	   -> terms_avx2 {
+		return {_mm256_add_pd(a.xy, b.xy), _mm256_add_pd(a.xx, b.xx), _mm256_add_pd(a.yy, b.yy)};
+	}
+
+	// the same lanes and fold as reduce_avx2
+	[[gnu::target("avx2,fma")]] auto
+	dot_terms_avx2(double const* x, double const* y, std::size_t size) noexcept -> dot_terms {
+		constexpr auto width = std::size_t{4};
+		auto const zero = _mm256_setzero_pd();
+		auto acc0 = terms_avx2{zero, zero, zero};
+		auto acc1 = acc0;
+		auto acc2 = acc0;
+		auto acc3 = acc0;
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			auto const* const xs = x + i;
+			auto const* const ys = y + i;
+			acc0 = accumulate_terms_avx2(acc0, xs, ys);
+			acc1 = accumulate_terms_avx2(acc1, xs + width, ys + width);
+			acc2 = accumulate_terms_avx2(acc2, xs + 2 * width, ys + 2 * width);
+			acc3 = accumulate_terms_avx2(acc3, xs + 3 * width, ys + 3 * width);
+		}
+		auto const sum = add_terms_avx2(add_terms_avx2(acc0, acc2), add_terms_avx2(acc1, acc3));
+		return {add_tail<reduction::dot>(fold_avx2(sum.xy), x, y, blocked, size),
+		        add_tail<reduction::dot>(fold_avx2(sum.xx), x, x, blocked, size),
+		        add_tail<reduction::dot>(fold_avx2(sum.yy), y, y, blocked, size)};
+	}
+
+	struct compensated_avx2 {
+		__m256d sum;
+		__m256d error;
+	};
+
+	// compensated_step on four lanes
+	[[gnu::target("avx2,fma")]] auto
+	compensated_step_avx2(compensated_avx2 acc, double const* x, double const* y) noexcept
+	   -> compensated_avx2 {
+		auto const xs = _mm256_loadu_pd(x);
+		auto const ys = _mm256_loadu_pd(y);
+		auto const product = _mm256_mul_pd(xs, ys);
+		auto const product_error = _mm256_fmsub_pd(xs, ys, product);
+		auto const sum = _mm256_add_pd(acc.sum, product);
+		auto const z = _mm256_sub_pd(sum, acc.sum);
+		auto const sum_error = _mm256_add_pd(_mm256_sub_pd(acc.sum, _mm256_sub_pd(sum, z)),
+		                                     _mm256_sub_pd(product, z));
+		return {sum, _mm256_add_pd(acc.error, _mm256_add_pd(sum_error, product_error))};
+	}
+
+	// stores the four lanes of `acc` as lanes first to first + 3
+	[[gnu::target("avx2,fma")]] auto store_lanes_avx2(std::array<compensated_sum, lanes>& lane,
+	                                                  std::size_t first,
+	                                                  compensated_avx2 acc) noexcept -> void {
+		auto sums = std::array<double, 4>{};
+		auto errors = std::array<double, 4>{};
+		_mm256_storeu_pd(sums.data(), acc.sum);
+		_mm256_storeu_pd(errors.data(), acc.error);
+		for (auto j = std::size_t{0}; j < sums.size(); ++j) {
+			lane[first + j] = {sums[j], errors[j]};
+		}
+	}
+
+	[[gnu::target("avx2,fma")]] auto
+	compensated_dot_avx2(double const* x, double const* y, std::size_t size) noexcept
+	   -> compensated_sum {
+		constexpr auto width = std::size_t{4};
+		auto const zero = _mm256_setzero_pd();
+		auto acc0 = compensated_avx2{zero, zero};
+		auto acc1 = acc0;
+		auto acc2 = acc0;
+		auto acc3 = acc0;
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			auto const* const xs = x + i;
+			auto const* const ys = y + i;
+			acc0 = compensated_step_avx2(acc0, xs, ys);
+			acc1 = compensated_step_avx2(acc1, xs + width, ys + width);
+			acc2 = compensated_step_avx2(acc2, xs + 2 * width, ys + 2 * width);
+			acc3 = compensated_step_avx2(acc3, xs + 3 * width, ys + 3 * width);
+		}
+		auto lane = std::array<compensated_sum, lanes>{};
+		store_lanes_avx2(lane, 0, acc0);
+		store_lanes_avx2(lane, width, acc1);
+		store_lanes_avx2(lane, 2 * width, acc2);
+		store_lanes_avx2(lane, 3 * width, acc3);
+		return finish_compensated(lane, x, y, blocked, size);
+	}
+
+	[[gnu::target("avx2,fma")]] auto widen_avx2(float const* x) noexcept -> __m256d {
+		return _mm256_cvtps_pd(_mm_loadu_ps(x));
+	}
+
+	// a bfloat16 is the upper half of a float
+	[[gnu::target("avx2,fma")]] auto widen_avx2(bfloat16 const* x) noexcept -> __m256d {
+		auto const halves = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(x));
+		auto const floats = _mm_slli_epi32(_mm_cvtepu16_epi32(halves), 16);
+		return _mm256_cvtps_pd(_mm_castsi128_ps(floats));
+	}
+
+	template<typename T>
+	[[gnu::target("avx2,fma")]] auto
+	accumulate_widened_avx2(__m256d acc, T const* x, T const* y) noexcept -> __m256d {
+		return _mm256_add_pd(acc, _mm256_mul_pd(widen_avx2(x), widen_avx2(y)));
+	}
+
+	// the same lanes and fold as reduce_avx2
+	template<typename T>
+	[[gnu::target("avx2,fma")]] auto
+	widening_dot_avx2(T const* x, T const* y, std::size_t size) noexcept -> double {
+		constexpr auto width = std::size_t{4};
+		auto acc0 = _mm256_setzero_pd();
+		auto acc1 = _mm256_setzero_pd();
+		auto acc2 = _mm256_setzero_pd();
+		auto acc3 = _mm256_setzero_pd();
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			auto const* const xs = x + i;
+			auto const* const ys = y + i;
+			acc0 = accumulate_widened_avx2(acc0, xs, ys);
+			acc1 = accumulate_widened_avx2(acc1, xs + width, ys + width);
+			acc2 = accumulate_widened_avx2(acc2, xs + 2 * width, ys + 2 * width);
+			acc3 = accumulate_widened_avx2(acc3, xs + 3 * width, ys + 3 * width);
+		}
+		acc0 = _mm256_add_pd(acc0, acc2);
+		acc1 = _mm256_add_pd(acc1, acc3);
+		auto sum = fold_avx2(_mm256_add_pd(acc0, acc1));
+		for (auto i = blocked; i < size; ++i) {
+			sum += widen(x[i]) * widen(y[i]);
+		}
+		return sum;
+	}
+
+	// sixteen int8s, sign-extended to 16 bits
+	[[gnu::target("avx2,fma")]] auto widen_avx2(std::int8_t const* x) noexcept -> __m256i {
+		return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const*>(x)));
+	}
+
+	// Sign-extended to 16 bits, pairs of int8 products are summed into 32-bit lanes, each of which
+	// grows by at most 2 * 128 * 128 per step. The lanes are moved into the 64-bit total often
+	// enough that they cannot overflow.
+	[[gnu::target("avx2,fma")]] auto
+	int8_dot_avx2(std::int8_t const* x, std::int8_t const* y, std::size_t size) noexcept
+	   -> std::int64_t {
+		constexpr auto width = std::size_t{16};
+		constexpr auto steps_per_flush = std::size_t{1} << 15;
+		auto const blocked = size - size % width;
+		auto total = std::int64_t{0};
+		for (auto first = std::size_t{0}; first < blocked; first += width * steps_per_flush) {
+			auto const last = std::min(blocked, first + width * steps_per_flush);
+			auto acc = _mm256_setzero_si256();
+			for (auto i = first; i < last; i += width) {
+				acc = _mm256_add_epi32(acc, _mm256_madd_epi16(widen_avx2(x + i), widen_avx2(y + i)));
+			}
+			auto lane = std::array<std::int32_t, 8>{};
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane.data()), acc);
+			for (auto const partial : lane) {
+				total += partial;
+			}
+		}
+		return total + int8_dot_scalar(x + blocked, y + blocked, size - blocked);
+	}
+
+	template<comparison C>
+	[[gnu::target("avx2,fma")]] auto close_avx2(__m256d x,
+	                                            __m256d y,
+	                                            __m256d absolute_tolerance,
+	                                            __m256d relative_tolerance) noexcept -> __m256d {
+		if constexpr (C == comparison::exact) {
+			return _mm256_cmp_pd(x, y, _CMP_EQ_OQ);
+		}
+		else {
+			auto const sign = _mm256_set1_pd(-0.0);
+			auto const difference = _mm256_andnot_pd(sign, _mm256_sub_pd(x, y));
+			auto const larger = _mm256_max_pd(_mm256_andnot_pd(sign, x), _mm256_andnot_pd(sign, y));
+			auto const tolerance =
+			   _mm256_max_pd(absolute_tolerance, _mm256_mul_pd(relative_tolerance, larger));
+			auto const infinity = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+			auto const within = _mm256_and_pd(_mm256_cmp_pd(difference, infinity, _CMP_LT_OQ),
+			                                  _mm256_cmp_pd(difference, tolerance, _CMP_LE_OQ));
+			return _mm256_or_pd(_mm256_cmp_pd(x, y, _CMP_EQ_OQ), within);
+		}
+	}
+
+	template<comparison C>
+	[[gnu::target("avx2,fma")]] auto compare_avx2(double const* x,
+	                                              double const* y,
+	                                              std::size_t size,
+	                                              double absolute_tolerance,
+	                                              double relative_tolerance) noexcept -> bool {
+		constexpr auto width = std::size_t{4};
+		auto const absolute = _mm256_set1_pd(absolute_tolerance);
+		auto const relative = _mm256_set1_pd(relative_tolerance);
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			auto all = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+			for (auto j = i; j < i + lanes; j += width) {
+				auto const quad =
+				   close_avx2<C>(_mm256_loadu_pd(x + j), _mm256_loadu_pd(y + j), absolute, relative);
+				all = _mm256_and_pd(all, quad);
+			}
+			if (_mm256_movemask_pd(all) != 0b1111) {
+				return false;
+			}
+		}
+		return compare_tail<C>(x, y, blocked, size, absolute_tolerance, relative_tolerance);
+	}
+
+	template<operation Op>
+	[[gnu::target("avx2,fma")]] auto elementwise_avx2(double* out,
+	                                                  double const* x,
+	                                                  double const* y,
+	                                                  double s,
+	                                                  std::size_t size) noexcept -> void {
+		constexpr auto width = std::size_t{4};
+		auto const broadcast = _mm256_set1_pd(s);
+		auto const blocked = size - size % width;
+		for (auto i = std::size_t{0}; i < blocked; i += width) {
+			auto const ys = reads_y<Op> ? _mm256_loadu_pd(y + i) : _mm256_setzero_pd();
+			_mm256_storeu_pd(out + i, apply_avx2<Op>(_mm256_loadu_pd(x + i), ys, broadcast));
+		}
+		elementwise_tail<Op>(out, x, y, s, blocked, size);
+	}
+
+	[[gnu::target("avx2,fma")]] auto welford_avx2(welford_accumulators const& accumulators,
+	                                              double const* x,
+	                                              double const reciprocal_count,
+	                                              std::size_t const size) noexcept -> void {
+		auto const acc = accumulators;
+		constexpr auto width = std::size_t{4};
+		auto const reciprocal = _mm256_set1_pd(reciprocal_count);
+		auto const blocked = size - size % width;
+		for (auto i = std::size_t{0}; i < blocked; i += width) {
+			auto const value = _mm256_loadu_pd(x + i);
+			_mm256_storeu_pd(acc.sum + i, _mm256_add_pd(_mm256_loadu_pd(acc.sum + i), value));
+			auto const mean = _mm256_loadu_pd(acc.mean + i);
+			auto const delta = _mm256_sub_pd(value, mean);
+			auto const updated = _mm256_add_pd(mean, _mm256_mul_pd(delta, reciprocal));
+			_mm256_storeu_pd(acc.mean + i, updated);
+			auto const m2 = _mm256_loadu_pd(acc.m2 + i);
+			auto const squares = _mm256_mul_pd(delta, _mm256_sub_pd(value, updated));
+			_mm256_storeu_pd(acc.m2 + i, _mm256_add_pd(m2, squares));
+			_mm256_storeu_pd(acc.min + i, _mm256_min_pd(value, _mm256_loadu_pd(acc.min + i)));
+			_mm256_storeu_pd(acc.max + i, _mm256_max_pd(value, _mm256_loadu_pd(acc.max + i)));
+		}
+		welford_tail(acc, x, reciprocal_count, blocked, size);
+	}
+
+	template<operation Op>
+	[[gnu::target("avx512f")]] auto
+	apply_avx512(__m512d x, __m512d y, __m512d s) noexcept -> __m512d {
+		if constexpr (Op == operation::add) {
+			return _mm512_add_pd(x, y);
+		}
+		else if constexpr (Op == operation::subtract) {
+			return _mm512_sub_pd(x, y);
+		}
+		else if constexpr (Op == operation::multiply) {
+			return _mm512_mul_pd(x, s);
+		}
+		else if constexpr (Op == operation::divide) {
+			return _mm512_div_pd(x, s);
+		}
+		else if constexpr (Op == operation::scale_add) {
+			return _mm512_add_pd(_mm512_mul_pd(x, s), y);
+		}
+		else if constexpr (Op == operation::squared_difference) {
+			auto const difference = _mm512_sub_pd(x, s);
+			return _mm512_add_pd(y, _mm512_mul_pd(difference, difference));
+		}
+		else if constexpr (Op == operation::lerp) {
+			return _mm512_add_pd(x, _mm512_mul_pd(s, _mm512_sub_pd(y, x)));
+		}
+		else {
+			return _mm512_fmadd_pd(s, x, y);
+		}
+	}
+
+	template<reduction R>
+	[[gnu::target("avx512f")]] auto
+	accumulate_avx512(__m512d acc, double const* x, double const* y) noexcept -> __m512d {
+		if constexpr (R == reduction::dot) {
+			return _mm512_add_pd(acc, _mm512_mul_pd(_mm512_loadu_pd(x), _mm512_loadu_pd(y)));
+		}
+		else {
+			auto const difference = _mm512_sub_pd(_mm512_loadu_pd(x), _mm512_loadu_pd(y));
+			return _mm512_add_pd(acc, _mm512_mul_pd(difference, difference));
+		}
+	}
+
+	// Reduces eight lanes to one in the order the header documents.
+	[[gnu::target("avx512f")]] auto fold_avx512(__m512d acc) noexcept -> double {
+		auto lane = std::array<double, lanes / 2>{};
+		_mm512_storeu_pd(lane.data(), acc);
+		return ((lane[0] + lane[4]) + (lane[2] + lane[6]))
+		       + ((lane[1] + lane[5]) + (lane[3] + lane[7]));
+	}
+
+	template<reduction R>
+	[[gnu::target("avx512f")]] auto
+	reduce_avx512(double const* x, double const* y, std::size_t size) noexcept -> double {
+		constexpr auto width = std::size_t{8};
+		auto acc0 = _mm512_setzero_pd();
+		auto acc1 = _mm512_setzero_pd();
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			acc0 = accumulate_avx512<R>(acc0, x + i, y + i);
+			acc1 = accumulate_avx512<R>(acc1, x + i + width, y + i + width);
+		}
+		return add_tail<R>(fold_avx512(_mm512_add_pd(acc0, acc1)), x, y, blocked, size);
+	}
+
+	struct terms_avx512 {
+		__m512d xy;
+		__m512d xx;
+		__m512d yy;
+	};
+
+	[[gnu::target("avx512f")]] auto
+	accumulate_terms_avx512(terms_avx512 acc, double const* x, double const* y) noexcept
+	   -> terms_avx512 {
+		auto const xs = _mm512_loadu_pd(x);
+		auto const ys = _mm512_loadu_pd(y);
+		return {_mm512_add_pd(acc.xy, _mm512_mul_pd(xs, ys)),
+		        _mm512_add_pd(acc.xx, _mm512_mul_pd(xs, xs)),
+		        _mm512_add_pd(acc.yy, _mm512_mul_pd(ys, ys))};
+	}
+
+	// the same lanes and fold as reduce_avx512
+	[[gnu::target("avx512f")]] auto
+	dot_terms_avx512(double const* x, double const* y, std::size_t size) noexcept -> dot_terms {
+		constexpr auto width = std::size_t{8};
+		auto const zero = _mm512_setzero_pd();
+		auto acc0 = terms_avx512{zero, zero, zero};
+		auto acc1 = acc0;
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			acc0 = accumulate_terms_avx512(acc0, x + i, y + i);
+			acc1 = accumulate_terms_avx512(acc1, x + i + width, y + i + width);
+		}
+		return {add_tail<reduction::dot>(fold_avx512(_mm512_add_pd(acc0.xy, acc1.xy)),
+		                                 x,
+		                                 y,
+		                                 blocked,
+		                                 size),
+		        add_tail<reduction::dot>(fold_avx512(_mm512_add_pd(acc0.xx, acc1.xx)),
+		                                 x,
+		                                 x,
+		                                 blocked,
+		                                 size),
+		        add_tail<reduction::dot>(fold_avx512(_mm512_add_pd(acc0.yy, acc1.yy)),
+		                                 y,
+		                                 y,
+		                                 blocked,
+		                                 size)};
+	}
+
+	struct compensated_avx512 {
+		__m512d sum;
+		__m512d error;
+	};
+
+	// compensated_step on eight lanes
+	[[gnu::target("avx512f")]] auto
+	compensated_step_avx512(compensated_avx512 acc, double const* x, double const* y) noexcept
+	   -> compensated_avx512 {
+		auto const xs = _mm512_loadu_pd(x);
+		auto const ys = _mm512_loadu_pd(y);
+		auto const product = _mm512_mul_pd(xs, ys);
+		auto const product_error = _mm512_fmsub_pd(xs, ys, product);
+		auto const sum = _mm512_add_pd(acc.sum, product);
+		auto const z = _mm512_sub_pd(sum, acc.sum);
+		auto const sum_error = _mm512_add_pd(_mm512_sub_pd(acc.sum, _mm512_sub_pd(sum, z)),
+		                                     _mm512_sub_pd(product, z));
+		return {sum, _mm512_add_pd(acc.error, _mm512_add_pd(sum_error, product_error))};
+	}
+
+	// stores the eight lanes of `acc` as lanes first to first + 7
+	[[gnu::target("avx512f")]] auto store_lanes_avx512(std::array<compensated_sum, lanes>& lane,
+	                                                   std::size_t first,
+	                                                   compensated_avx512 acc) noexcept -> void {
+		auto sums = std::array<double, lanes / 2>{};
+		auto errors = std::array<double, lanes / 2>{};
+		_mm512_storeu_pd(sums.data(), acc.sum);
+		_mm512_storeu_pd(errors.data(), acc.error);
+		for (auto j = std::size_t{0}; j < sums.size(); ++j) {
+			lane[first + j] = {sums[j], errors[j]};
+		}
+	}
+
+	[[gnu::target("avx512f")]] auto
+	compensated_dot_avx512(double const* x, double const* y, std::size_t size) noexcept
+	   -> compensated_sum {
+		constexpr auto width = std::size_t{8};
+		auto const zero = _mm512_setzero_pd();
+		auto acc0 = compensated_avx512{zero, zero};
+		auto acc1 = acc0;
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			acc0 = compensated_step_avx512(acc0, x + i, y + i);
+			acc1 = compensated_step_avx512(acc1, x + i + width, y + i + width);
+		}
+		auto lane = std::array<compensated_sum, lanes>{};
+		store_lanes_avx512(lane, 0, acc0);
+		store_lanes_avx512(lane, width, acc1);
+		return finish_compensated(lane, x, y, blocked, size);
+	}
+
+	// _mm512_cvtps_pd, without GCC's spurious -Wmaybe-uninitialized on its undefined source
+	[[gnu::target("avx512f")]] auto widen_avx512(__m256 x) noexcept -> __m512d {
+		constexpr auto all_lanes = __mmask8{0xff};
+		return _mm512_maskz_cvtps_pd(all_lanes, x);
+	}
+
+	[[gnu::target("avx512f")]] auto widen_avx512(float const* x) noexcept -> __m512d {
+		return widen_avx512(_mm256_loadu_ps(x));
+	}
+
+	[[gnu::target("avx512f")]] auto widen_avx512(bfloat16 const* x) noexcept -> __m512d {
+		auto const halves = _mm_loadu_si128(reinterpret_cast<__m128i const*>(x));
+		auto const floats = _mm256_slli_epi32(_mm256_cvtepu16_epi32(halves), 16);
+		return widen_avx512(_mm256_castsi256_ps(floats));
+	}
+
+	// the same lanes and fold as reduce_avx512
+	template<typename T>
+	[[gnu::target("avx512f")]] auto
+	widening_dot_avx512(T const* x, T const* y, std::size_t size) noexcept -> double {
+		constexpr auto width = std::size_t{8};
+		auto acc0 = _mm512_setzero_pd();
+		auto acc1 = _mm512_setzero_pd();
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(widen_avx512(x + i), widen_avx512(y + i)));
+			auto const* const xs = x + i + width;
+			auto const* const ys = y + i + width;
+			acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(widen_avx512(xs), widen_avx512(ys)));
+		}
+		auto sum = fold_avx512(_mm512_add_pd(acc0, acc1));
+		for (auto i = blocked; i < size; ++i) {
+			sum += widen(x[i]) * widen(y[i]);
+		}
+		return sum;
+	}
+
+	// _mm512_max_pd, without GCC's spurious -Wmaybe-uninitialized on its undefined source
+	[[gnu::target("avx512f")]] auto max_avx512(__m512d x, __m512d y) noexcept -> __m512d {
+		constexpr auto all_lanes = __mmask8{0xff};
+		return _mm512_maskz_max_pd(all_lanes, x, y);
+	}
+
+	// _mm512_min_pd, likewise
+	[[gnu::target("avx512f")]] auto min_avx512(__m512d x, __m512d y) noexcept -> __m512d {
+		constexpr auto all_lanes = __mmask8{0xff};
+		return _mm512_maskz_min_pd(all_lanes, x, y);
+	}
+
+	template<comparison C>
+	[[gnu::target("avx512f")]] auto close_avx512(__m512d x,
+	                                             __m512d y,
+	                                             __m512d absolute_tolerance,
+	                                             __m512d relative_tolerance) noexcept -> __mmask8 {
+		auto const equal = _mm512_cmp_pd_mask(x, y, _CMP_EQ_OQ);
+		if constexpr (C == comparison::exact) {
+			return equal;
+		}
+		else {
+			auto const difference = _mm512_abs_pd(_mm512_sub_pd(x, y));
+			auto const larger = max_avx512(_mm512_abs_pd(x), _mm512_abs_pd(y));
+			auto const tolerance =
+			   max_avx512(absolute_tolerance, _mm512_mul_pd(relative_tolerance, larger));
+			auto const infinity = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+			auto const finite = _mm512_cmp_pd_mask(difference, infinity, _CMP_LT_OQ);
+			return equal | _mm512_mask_cmp_pd_mask(finite, difference, tolerance, _CMP_LE_OQ);
+		}
+	}
+
+	template<comparison C>
+	[[gnu::target("avx512f")]] auto compare_avx512(double const* x,
+	                                               double const* y,
+	                                               std::size_t size,
+	                                               double absolute_tolerance,
+	                                               double relative_tolerance) noexcept -> bool {
+		constexpr auto width = std::size_t{8};
+		auto const absolute = _mm512_set1_pd(absolute_tolerance);
+		auto const relative = _mm512_set1_pd(relative_tolerance);
+		auto const blocked = size - size % lanes;
+		for (auto i = std::size_t{0}; i < blocked; i += lanes) {
+			auto const low =
+			   close_avx512<C>(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), absolute, relative);
+			auto const high = close_avx512<C>(_mm512_loadu_pd(x + i + width),
+			                                  _mm512_loadu_pd(y + i + width),
+			                                  absolute,
+			                                  relative);
+			if ((low & high) != 0xff) {
+				return false;
+			}
+		}
+		return compare_tail<C>(x, y, blocked, size, absolute_tolerance, relative_tolerance);
+	}
+
+	template<operation Op>
+	[[gnu::target("avx512f")]] auto elementwise_avx512(double* out,
+	                                                   double const* x,
+	                                                   double const* y,
+	                                                   double s,
+	                                                   std::size_t size) noexcept -> void {
+		constexpr auto width = std::size_t{8};
+		auto const broadcast = _mm512_set1_pd(s);
+		auto const blocked = size - size % width;
+		for (auto i = std::size_t{0}; i < blocked; i += width) {
+			auto const ys = reads_y<Op> ? _mm512_loadu_pd(y + i) : _mm512_setzero_pd();
+			_mm512_storeu_pd(out + i, apply_avx512<Op>(_mm512_loadu_pd(x + i), ys, broadcast));
+		}
+		elementwise_tail<Op>(out, x, y, s, blocked, size);
+	}
+
+	[[gnu::target("avx512f")]] auto welford_avx512(welford_accumulators const& accumulators,
+	                                               double const* x,
+	                                               double const reciprocal_count,
+	                                               std::size_t const size) noexcept -> void {
+		auto const acc = accumulators;
+		constexpr auto width = std::size_t{8};
+		auto const reciprocal = _mm512_set1_pd(reciprocal_count);
+		auto const blocked = size - size % width;
+		for (auto i = std::size_t{0}; i < blocked; i += width) {
+			auto const value = _mm512_loadu_pd(x + i);
+			_mm512_storeu_pd(acc.sum + i, _mm512_add_pd(_mm512_loadu_pd(acc.sum + i), value));
+			auto const mean = _mm512_loadu_pd(acc.mean + i);
+			auto const delta = _mm512_sub_pd(value, mean);
+			auto const updated = _mm512_add_pd(mean, _mm512_mul_pd(delta, reciprocal));
+			_mm512_storeu_pd(acc.mean + i, updated);
+			auto const m2 = _mm512_loadu_pd(acc.m2 + i);
+			auto const squares = _mm512_mul_pd(delta, _mm512_sub_pd(value, updated));
+			_mm512_storeu_pd(acc.m2 + i, _mm512_add_pd(m2, squares));
+			_mm512_storeu_pd(acc.min + i, min_avx512(value, _mm512_loadu_pd(acc.min + i)));
+			_mm512_storeu_pd(acc.max + i, max_avx512(value, _mm512_loadu_pd(acc.max + i)));
+		}
+		welford_tail(acc, x, reciprocal_count, blocked, size);
+	}
+#endif // COMP6771_X86_KERNELS
+
+	template<typename Result>
+	using reduction_kernel_of =
+	   auto (*)(double const*, double const*, std::size_t) noexcept -> Result;
+	using reduction_kernel = reduction_kernel_of<double>;
+	using terms_kernel = reduction_kernel_of<dot_terms>;
+	using compensated_kernel = reduction_kernel_of<compensated_sum>;
+	template<typename T>
+	using widening_kernel_of = auto (*)(T const*, T const*, std::size_t) noexcept -> double;
+	using int8_kernel = auto (*)(std::int8_t const*, std::int8_t const*, std::size_t) noexcept
+	   -> std::int64_t;
+	using elementwise_kernel =
+	   auto (*)(double*, double const*, double const*, double, std::size_t) noexcept -> void;
+	using comparison_kernel =
+	   auto (*)(double const*, double const*, std::size_t, double, double) noexcept -> bool;
+	using welford_kernel =
+	   auto (*)(welford_accumulators const&, double const*, double, std::size_t) noexcept -> void;
+
+	struct kernel_table {
+		simd_level level;
+		reduction_kernel dot;
+		reduction_kernel squared_distance;
+		terms_kernel dot_terms;
+		compensated_kernel compensated_dot;
+		widening_kernel_of<float> float_dot;
+		widening_kernel_of<bfloat16> bfloat16_dot;
+		int8_kernel int8_dot;
+		elementwise_kernel add;
+		elementwise_kernel subtract;
+		elementwise_kernel multiply;
+		elementwise_kernel divide;
+		elementwise_kernel scale_add;
+		elementwise_kernel add_squared_difference;
+		elementwise_kernel lerp;
+		elementwise_kernel fused_scale_add;
+		comparison_kernel equal;
+		comparison_kernel approx_equal;
+		welford_kernel welford_step;
+	};
+
+	constexpr auto scalar_kernels = kernel_table{simd_level::scalar,
+	                                             reduce_scalar<reduction::dot>,
+	                                             reduce_scalar<reduction::squared_distance>,
+	                                             dot_terms_scalar,
+	                                             compensated_dot_scalar,
+	                                             widening_dot_scalar<float>,
+	                                             widening_dot_scalar<bfloat16>,
+	                                             int8_dot_scalar,
+	                                             elementwise_scalar<operation::add>,
+	                                             elementwise_scalar<operation::subtract>,
+	                                             elementwise_scalar<operation::multiply>,
+	                                             elementwise_scalar<operation::divide>,
+	                                             elementwise_scalar<operation::scale_add>,
+	                                             elementwise_scalar<operation::squared_difference>,
+	                                             elementwise_scalar<operation::lerp>,
+	                                             elementwise_scalar<operation::fused_scale_add>,
+	                                             compare_scalar<comparison::exact>,
+	                                             compare_scalar<comparison::approximate>,
+	                                             welford_scalar};
+
+#ifdef COMP6771_X86_KERNELS
+	// SSE2 has no fused multiply-add, three sets of eight accumulators would not fit in its sixteen
+	// registers, and widening bfloat16 or int8 needs SSE4.1, so the kernels that need any of those
+	// use the scalar implementation.
+	constexpr auto sse2_kernels = kernel_table{simd_level::sse2,
+	                                           reduce_sse2<reduction::dot>,
+	                                           reduce_sse2<reduction::squared_distance>,
+	                                           dot_terms_scalar,
+	                                           compensated_dot_scalar,
+	                                           widening_dot_scalar<float>,
+	                                           widening_dot_scalar<bfloat16>,
+	                                           int8_dot_scalar,
+	                                           elementwise_sse2<operation::add>,
+	                                           elementwise_sse2<operation::subtract>,
+	                                           elementwise_sse2<operation::multiply>,
+	                                           elementwise_sse2<operation::divide>,
+	                                           elementwise_sse2<operation::scale_add>,
+	                                           elementwise_sse2<operation::squared_difference>,
+	                                           elementwise_sse2<operation::lerp>,
+	                                           elementwise_scalar<operation::fused_scale_add>,
+	                                           compare_sse2<comparison::exact>,
+	                                           compare_sse2<comparison::approximate>,
+	                                           welford_sse2};
+
+	constexpr auto avx2_kernels = kernel_table{simd_level::avx2,
+	                                           reduce_avx2<reduction::dot>,
+	                                           reduce_avx2<reduction::squared_distance>,
+	                                           dot_terms_avx2,
+	                                           compensated_dot_avx2,
+	                                           widening_dot_avx2<float>,
+	                                           widening_dot_avx2<bfloat16>,
+	                                           int8_dot_avx2,
+	                                           elementwise_avx2<operation::add>,
+	                                           elementwise_avx2<operation::subtract>,
+	                                           elementwise_avx2<operation::multiply>,
+	                                           elementwise_avx2<operation::divide>,
+	                                           elementwise_avx2<operation::scale_add>,
+	                                           elementwise_avx2<operation::squared_difference>,
+	                                           elementwise_avx2<operation::lerp>,
+	                                           elementwise_avx2<operation::fused_scale_add>,
+	                                           compare_avx2<comparison::exact>,
+	                                           compare_avx2<comparison::approximate>,
+	                                           welford_avx2};
+
+	constexpr auto avx512_kernels = kernel_table{simd_level::avx512,
+	                                             reduce_avx512<reduction::dot>,
+	                                             reduce_avx512<reduction::squared_distance>,
+	                                             dot_terms_avx512,
+	                                             compensated_dot_avx512,
+	                                             widening_dot_avx512<float>,
+	                                             widening_dot_avx512<bfloat16>,
+	                                             int8_dot_avx2,
+	                                             elementwise_avx512<operation::add>,
+	                                             elementwise_avx512<operation::subtract>,
+	                                             elementwise_avx512<operation::multiply>,
+	                                             elementwise_avx512<operation::divide>,
+	                                             elementwise_avx512<operation::scale_add>,
+	                                             elementwise_avx512<operation::squared_difference>,
+	                                             elementwise_avx512<operation::lerp>,
+	                                             elementwise_avx512<operation::fused_scale_add>,
+	                                             compare_avx512<comparison::exact>,
+	                                             compare_avx512<comparison::approximate>,
+	                                             welford_avx512};
+#endif // COMP6771_X86_KERNELS
+
+	auto kernels_for(simd_level level) noexcept -> kernel_table const* {
+		switch (level) {
+#ifdef COMP6771_X86_KERNELS
+		case simd_level::avx512: return &avx512_kernels;
+		case simd_level::avx2: return &avx2_kernels;
+		case simd_level::sse2: return &sse2_kernels;
+#endif // COMP6771_X86_KERNELS
+		default: return &scalar_kernels;
+		}
+	}
+
+	auto detect_simd_level() noexcept -> simd_level {
+#ifdef COMP6771_X86_KERNELS
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f")) {
+			return simd_level::avx512;
+		}
+		// the AVX2 kernels also use FMA, which every AVX2 CPU has in practice
+		if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma")) {
+			return simd_level::avx2;
+		}
+		if (__builtin_cpu_supports("sse2")) {
+			return simd_level::sse2;
+		}
+#endif // COMP6771_X86_KERNELS
+		return simd_level::scalar;
+	}
+
+	auto active_kernels() noexcept -> std::atomic<kernel_table const*>& {
+		static auto active = std::atomic<kernel_table const*>(kernels_for(detect_simd_level()));
+		return active;
+	}
+
+	auto current() noexcept -> kernel_table const& {
+		return *active_kernels().load(std::memory_order_relaxed);
+	}
+
+	struct parallel_state {
+		std::mutex mutex;
+		std::shared_ptr<comp6771::thread_pool> pool;
+		// the maximum while parallel execution is disabled
+		std::atomic<std::size_t> threshold = std::numeric_limits<std::size_t>::max();
+	};
+
+	auto parallel() noexcept -> parallel_state& {
+		static auto state = parallel_state();
+		return state;
+	}
+
+	// the pool to split a kernel over `size` elements across, or null to run it serially
+	auto pool_for(std::size_t size) -> std::shared_ptr<comp6771::thread_pool> {
+		auto& state = parallel();
+		if (size < state.threshold.load(std::memory_order_relaxed)) {
+			return nullptr;
+		}
+		auto const lock = std::scoped_lock(state.mutex);
+		return state.pool;
+	}
+
+	auto chunks_of(std::size_t size) noexcept -> std::size_t {
+		constexpr auto chunk = comp6771::kernels::parallel_chunk_size;
+		return (size + chunk - 1) / chunk;
+	}
+
+	auto add_partial(double& sum, double const partial) noexcept -> void {
+		sum += partial;
+	}
+
+	auto add_partial(dot_terms& sum, dot_terms const& partial) noexcept -> void {
+		sum.xy += partial.xy;
+		sum.xx += partial.xx;
+		sum.yy += partial.yy;
+	}
+
+	auto add_partial(compensated_sum& sum, compensated_sum const& partial) noexcept -> void {
+		sum = combine(sum, partial);
+	}
+
+	// Chunk boundaries depend only on `size`, and the chunk sums are added in order, so the result
+	// does not depend on how many threads the pool has.
+	template<typename Result>
+	auto parallel_reduce(comp6771::thread_pool& pool,
+	                     reduction_kernel_of<Result> kernel,
+	                     double const* x,
+	                     double const* y,
+	                     std::size_t size) -> Result {
+		constexpr auto chunk = comp6771::kernels::parallel_chunk_size;
+		auto partial = std::vector<Result>(chunks_of(size));
+		pool.run(partial.size(), [&](std::size_t c) {
+			auto const first = c * chunk;
+			partial[c] = kernel(x + first, y + first, std::min(chunk, size - first));
+		});
+		auto sum = partial.front();
+		for (auto c = std::size_t{1}; c < partial.size(); ++c) {
+			add_partial(sum, partial[c]);
+		}
+		return sum;
+	}
+
+	// parallel_reduce's chunked sum on the calling thread, without allocating
+	template<typename Result>
+	auto chunked_reduce(reduction_kernel_of<Result> kernel,
+	                    double const* x,
+	                    double const* y,
+	                    std::size_t size) noexcept -> Result {
+		constexpr auto chunk = comp6771::kernels::parallel_chunk_size;
+		auto sum = kernel(x, y, std::min(chunk, size));
+		for (auto first = chunk; first < size; first += chunk) {
+			add_partial(sum, kernel(x + first, y + first, std::min(chunk, size - first)));
+		}
+		return sum;
+	}
+
+	// Returns false, without having written to `out`, if the pool could not be set to work.
+	auto parallel_elementwise(comp6771::thread_pool& pool,
+	                          elementwise_kernel kernel,
+	                          double* out,
+	                          double const* x,
+	                          double const* y,
+	                          double s,
+	                          std::size_t size) -> bool {
+		constexpr auto chunk = comp6771::kernels::parallel_chunk_size;
+		auto started = std::atomic<bool>(false);
+		try {
+			auto const task = std::function<void(std::size_t)>([&](std::size_t c) {
+				started.store(true, std::memory_order_relaxed);
+				auto const first = c * chunk;
+				kernel(out + first,
+				       x + first,
+				       y == nullptr ? nullptr : y + first,
+				       s,
+				       std::min(chunk, size - first));
+			});
+			pool.run(chunks_of(size), task);
+		} catch (...) {
+			// once a chunk has been written, `out` may alias an input that no longer holds it
+			if (started.load(std::memory_order_relaxed)) {
+				throw;
+			}
+			return false;
+		}
+		return true;
+	}
+
+	// The parallel kernels allocate and lock, so the public kernels, which are noexcept, fall back
+	// to running on the calling thread if that fails.
+	auto try_pool_for(std::size_t const size) noexcept -> std::shared_ptr<comp6771::thread_pool> {
+		try {
+			return pool_for(size);
+		} catch (...) {
+			return nullptr;
+		}
+	}
+
+	template<typename Result>
+	auto reduce(reduction_kernel_of<Result> kernel,
+	            double const* x,
+	            double const* y,
+	            std::size_t size) noexcept -> Result {
+		if (auto const pool = try_pool_for(size)) {
+			try {
+				return parallel_reduce(*pool, kernel, x, y, size);
+			} catch (...) {
+				return chunked_reduce(kernel, x, y, size);
+			}
+		}
+		return kernel(x, y, size);
+	}
+
+	auto elementwise(elementwise_kernel kernel,
+	                 double* out,
+	                 double const* x,
+	                 double const* y,
+	                 double s,
+	                 std::size_t size) noexcept -> void {
+		if (auto const pool = try_pool_for(size)) {
+			if (parallel_elementwise(*pool, kernel, out, x, y, s, size)) {
+				return;
+			}
+		}
+		kernel(out, x, y, s, size);
+	}
+
+	auto copy_chunk(double* out, double const* x, double const*, double, std::size_t size) noexcept
+	   -> void {
+		std::copy_n(x, size, out);
+	}
+
+	// Splits at multiples of `lanes`, so every block but the last is summed without a tail.
+	auto pairwise_dot(double const* x, double const* y, std::size_t size) noexcept -> double {
+		if (size <= comp6771::kernels::pairwise_block_size) {
+			return current().dot(x, y, size);
+		}
+		auto const half = (size / 2 + lanes - 1) / lanes * lanes;
+		return pairwise_dot(x, y, half) + pairwise_dot(x + half, y + half, size - half);
+	}
+
+	// Below this, products may have been lost to underflow; the scaled policy rescales.
+	constexpr auto smallest_unscaled = 0x1p-900;
+
+	// Whether the magnitudes are worth looking at: a sum that is not finite may have overflowed, and
+	// a NaN may come from products that overflowed with opposite signs.
+	auto may_need_scaling(double const sum) noexcept -> bool {
+		return not std::isfinite(sum) or std::abs(sum) < smallest_unscaled;
+	}
+
+	// Whether products of magnitudes up to x_max and y_max may have overflowed or underflowed.
+	// Infinities, NaNs and zero vectors have nothing to scale, and a finite, tiny sum of larger
+	// products cancelled, which scaling cannot make more accurate.
+	auto needs_scaling(double const sum, double const x_max, double const y_max) noexcept -> bool {
+		if (not std::isfinite(x_max) or not std::isfinite(y_max) or x_max == 0 or y_max == 0) {
+			return false;
+		}
+		return not std::isfinite(sum) or x_max * y_max < smallest_unscaled;
+	}
+
+	// Stops at the first NaN and returns it, since the scaled sum would be NaN anyway.
+	auto max_magnitude(double const* x, std::size_t size) noexcept -> double {
+		auto result = 0.0;
+		for (auto i = std::size_t{0}; i < size; ++i) {
+			if (std::isnan(x[i])) {
+				return x[i];
+			}
+			result = std::max(result, std::abs(x[i]));
+		}
+		return result;
+	}
+
+	// The exponent e for which magnitude * 2^-e is in [0.5, 1). It is clamped so that 2^-e is
+	// representable, which still brings subnormal magnitudes well above the underflow threshold.
+	auto scale_exponent(double const magnitude) noexcept -> int {
+		auto exponent = 0;
+		static_cast<void>(std::frexp(magnitude, &exponent));
+		return std::clamp(exponent, -1023, 1024);
+	}
+
+	// The compensated sum of (x[i] * 2^-x_exponent) * (y[i] * 2^-y_exponent). Scaling by a power of
+	// two is exact unless the result is subnormal, and those terms are too small to change the sum.
+	auto scaled_dot(double const* x,
+	                double const* y,
+	                std::size_t size,
+	                int x_exponent,
+	                int y_exponent) noexcept -> double {
+		constexpr auto block = std::size_t{1024};
+		auto x_scaled = std::array<double, block>{};
+		auto y_scaled = std::array<double, block>{};
+		auto const x_scale = std::ldexp(1.0, -x_exponent);
+		auto const y_scale = std::ldexp(1.0, -y_exponent);
+		auto const& table = current();
+		auto sum = compensated_sum{0.0, 0.0};
+		for (auto first = std::size_t{0}; first < size; first += block) {
+			auto const n = std::min(block, size - first);
+			table.multiply(x_scaled.data(), x + first, nullptr, x_scale, n);
+			auto const* ys = x_scaled.data();
+			if (x != y) {
+				table.multiply(y_scaled.data(), y + first, nullptr, y_scale, n);
+				ys = y_scaled.data();
+			}
+			add_partial(sum, table.compensated_dot(x_scaled.data(), ys, n));
+		}
+		return total(sum);
+	}
+
+	// An integer that orders like x, so that adjacent doubles differ by one; -0 and +0 are both 0.
+	auto ordered_bits(double const x) noexcept -> std::int64_t {
+		auto const bits = std::bit_cast<std::int64_t>(x);
+		return bits < 0 ? std::numeric_limits<std::int64_t>::min() - bits : bits;
+	}
+
+	// XXH64's primes and steps
+	constexpr auto prime1 = std::uint64_t{0x9e37'79b1'85eb'ca87};
+	constexpr auto prime2 = std::uint64_t{0xc2b2'ae3d'27d4'eb4f};
+	constexpr auto prime3 = std::uint64_t{0x1656'67b1'9e37'79f9};
+	constexpr auto prime4 = std::uint64_t{0x85eb'ca77'c2b2'ae63};
+	constexpr auto prime5 = std::uint64_t{0x27d4'eb2f'1656'67c5};
+
+	auto hash_round(std::uint64_t const acc, std::uint64_t const word) noexcept -> std::uint64_t {
+		return std::rotl(acc + word * prime2, 31) * prime1;
+	}
+
+	auto hash_merge(std::uint64_t const acc, std::uint64_t const lane) noexcept -> std::uint64_t {
+		return (acc ^ hash_round(0, lane)) * prime1 + prime4;
+	}
+
+	// Adding +0 turns -0 into +0 and leaves every other value alone, so magnitudes that compare
+	// equal have the same bits, apart from NaNs, which are never equal.
+	auto hash_word(double const x) noexcept -> std::uint64_t {
+		return std::bit_cast<std::uint64_t>(x + 0.0);
+	}
+} // namespace
+
+namespace comp6771::kernels {
+	auto detected_simd_level() noexcept -> simd_level {
+		static auto const level = detect_simd_level();
+		return level;
+	}
+
+	auto active_simd_level() noexcept -> simd_level {
+		return current().level;
+	}
+
+	auto set_simd_level(simd_level const level) -> void {
+		if (level > detected_simd_level()) {
+			throw std::invalid_argument("SIMD level is not supported by this CPU");
+		}
+		active_kernels().store(kernels_for(level), std::memory_order_relaxed);
+	}
+
+	auto enable_parallel_execution(std::size_t const threads, std::size_t const threshold) -> void {
+		if (threads == 0) {
+			throw std::invalid_argument("Parallel execution needs at least one thread");
+		}
+		auto pool = std::make_shared<thread_pool>(threads);
+		auto& state = parallel();
+		auto const lock = std::scoped_lock(state.mutex);
+		state.pool = std::move(pool);
+		state.threshold.store(threshold, std::memory_order_relaxed);
+	}
+
+	auto disable_parallel_execution() -> void {
+		auto& state = parallel();
+		auto const lock = std::scoped_lock(state.mutex);
+		state.threshold.store(std::numeric_limits<std::size_t>::max(), std::memory_order_relaxed);
+		// a kernel still running on the old pool keeps it alive until it finishes
+		state.pool.reset();
+	}
+
+	auto parallel_threads() noexcept -> std::size_t {
+		auto& state = parallel();
+		auto const lock = std::scoped_lock(state.mutex);
+		return state.pool == nullptr ? 0 : state.pool->size();
+	}
+
+	auto dot(double const* x, double const* y, std::size_t const size) noexcept -> double {
+		return reduce(current().dot, x, y, size);
+	}
+
+	auto sum_of_squares(double const* x, std::size_t const size) noexcept -> double {
+		return reduce(current().dot, x, x, size);
+	}
+
+	auto squared_distance(double const* x, double const* y, std::size_t const size) noexcept
+	   -> double {
+		return reduce(current().squared_distance, x, y, size);
+	}
+
+	auto dot_terms_of(double const* x, double const* y, std::size_t const size) noexcept
+	   -> dot_terms {
+		return reduce(current().dot_terms, x, y, size);
+	}
+
+	auto dot(double const* x,
+	         double const* y,
+	         std::size_t const size,
+	         accumulation const policy) noexcept -> double {
+		switch (policy) {
+		case accumulation::naive: return dot(x, y, size);
+		case accumulation::compensated: return total(reduce(current().compensated_dot, x, y, size));
+		case accumulation::pairwise: return pairwise_dot(x, y, size);
+		case accumulation::scaled: break;
+		}
+		auto const unscaled = total(reduce(current().compensated_dot, x, y, size));
+		if (not may_need_scaling(unscaled)) {
+			return unscaled;
+		}
+		auto const x_max = max_magnitude(x, size);
+		auto const y_max = x == y ? x_max : max_magnitude(y, size);
+		if (not needs_scaling(unscaled, x_max, y_max)) {
+			return unscaled;
+		}
+		auto const x_exponent = scale_exponent(x_max);
+		auto const y_exponent = scale_exponent(y_max);
+		return std::ldexp(scaled_dot(x, y, size, x_exponent, y_exponent), x_exponent + y_exponent);
+	}
+
+	auto norm(double const* x, std::size_t const size, accumulation const policy) noexcept
+	   -> double {
+		if (policy != accumulation::scaled) {
+			return std::sqrt(dot(x, x, size, policy));
+		}
+		auto const unscaled = total(reduce(current().compensated_dot, x, x, size));
+		if (not may_need_scaling(unscaled)) {
+			return std::sqrt(unscaled);
+		}
+		auto const max = max_magnitude(x, size);
+		if (not needs_scaling(unscaled, max, max)) {
+			return std::sqrt(unscaled);
+		}
+		auto const exponent = scale_exponent(max);
+		return std::ldexp(std::sqrt(scaled_dot(x, x, size, exponent, exponent)), exponent);
+	}
+
+	auto dot(float const* x, float const* y, std::size_t const size) noexcept -> double {
+		return current().float_dot(x, y, size);
+	}
+
+	auto dot(bfloat16 const* x, bfloat16 const* y, std::size_t const size) noexcept -> double {
+		return current().bfloat16_dot(x, y, size);
+	}
+
+	auto dot(std::int8_t const* x, std::int8_t const* y, std::size_t const size) noexcept
+	   -> std::int64_t {
+		return current().int8_dot(x, y, size);
+	}
+
+	auto equal(double const* x, double const* y, std::size_t const size) noexcept -> bool {
+		return current().equal(x, y, size, 0.0, 0.0);
+	}
+
+	auto approx_equal(double const* x,
+	                  double const* y,
+	                  std::size_t const size,
+	                  double const absolute_tolerance,
+	                  double const relative_tolerance) noexcept -> bool {
+		return current().approx_equal(x, y, size, absolute_tolerance, relative_tolerance);
+	}
+
+	auto ulp_distance(double const* x, double const* y, std::size_t const size) noexcept
+	   -> std::uint64_t {
+		auto result = std::uint64_t{0};
+		for (auto i = std::size_t{0}; i < size; ++i) {
+			if (std::isnan(x[i]) or std::isnan(y[i])) {
+				return std::numeric_limits<std::uint64_t>::max();
+			}
+			auto const a = ordered_bits(x[i]);
+			auto const b = ordered_bits(y[i]);
+			// the difference always fits in 64 unsigned bits
+			auto const low = static_cast<std::uint64_t>(std::min(a, b));
+			auto const high = static_cast<std::uint64_t>(std::max(a, b));
+			auto const distance = high - low;
+			result = std::max(result, distance);
+		}
+		return result;
+	}
+
+	auto hash(double const* x, std::size_t const size, std::uint64_t const seed) noexcept
+	   -> std::uint64_t {
+		constexpr auto stripe = std::size_t{4};
+		auto const striped = size - size % stripe;
+		auto h = seed + prime5;
+		if (striped != 0) {
+			auto acc = std::array<std::uint64_t, stripe>{seed + prime1 + prime2,
+			                                             seed + prime2,
+			                                             seed,
+			                                             seed - prime1};
+			for (auto i = std::size_t{0}; i < striped; i += stripe) {
+				for (auto j = std::size_t{0}; j < stripe; ++j) {
+					acc[j] = hash_round(acc[j], hash_word(x[i + j]));
+				}
+			}
+			h = std::rotl(acc[0], 1) + std::rotl(acc[1], 7) + std::rotl(acc[2], 12)
+			    + std::rotl(acc[3], 18);
+			for (auto const lane : acc) {
+				h = hash_merge(h, lane);
+			}
+		}
+		h += size * sizeof(double);
+		for (auto i = striped; i < size; ++i) {
+			h = std::rotl(h ^ hash_round(0, hash_word(x[i])), 27) * prime1 + prime4;
+		}
+		h = (h ^ (h >> 33)) * prime2;
+		h = (h ^ (h >> 29)) * prime3;
+		return h ^ (h >> 32);
+	}
+
+	auto welford_step(welford_accumulators const& accumulators,
+	                  double const* x,
+	                  double const reciprocal_count,
+	                  std::size_t const size) noexcept -> void {
+		current().welford_step(accumulators, x, reciprocal_count, size);
+	}
+
+	auto add(double* out, double const* x, double const* y, std::size_t const size) noexcept
+	   -> void {
+		elementwise(current().add, out, x, y, 0.0, size);
+	}
+
+	auto subtract(double* out, double const* x, double const* y, std::size_t const size) noexcept
+	   -> void {
+		elementwise(current().subtract, out, x, y, 0.0, size);
+	}
+
+	auto multiply(double* out,
+	              double const* x,
+	              double const multiplier,
+	              std::size_t const size) noexcept -> void {
+		elementwise(current().multiply, out, x, nullptr, multiplier, size);
+	}
+
+	auto divide(double* out, double const* x, double const divisor, std::size_t const size) noexcept
+	   -> void {
+		elementwise(current().divide, out, x, nullptr, divisor, size);
+	}
+
+	auto axpy(double* y, double const alpha, double const* x, std::size_t const size) noexcept
+	   -> void {
+		elementwise(current().scale_add, y, x, y, alpha, size);
+	}
+
+	auto copy(double* out, double const* x, std::size_t const size) noexcept -> void {
+		elementwise(copy_chunk, out, x, nullptr, 0.0, size);
+	}
+
+	auto add_squared_difference(double* sums,
+	                            double const* x,
+	                            double const s,
+	                            std::size_t const size) noexcept -> void {
+		elementwise(current().add_squared_difference, sums, x, sums, s, size);
+	}
+
+	auto lerp(double* out,
+	          double const* x,
+	          double const* y,
+	          double const t,
+	          std::size_t const size) noexcept -> void {
+		if (t == 1) {
+			copy(out, y, size);
+			return;
+		}
+		elementwise(current().lerp, out, x, y, t, size);
+	}
+
+	auto fused_scale_add(double* out,
+	                     double const alpha,
+	                     double const* x,
+	                     double const* y,
+	                     std::size_t const size) noexcept -> void {
+		elementwise(current().fused_scale_add, out, x, y, alpha, size);
+	}
+} // namespace comp6771::kernels
@@ -0,0 +1,274 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_pipeline.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+	using comp6771::euclidean_vector_batch;
+	using comp6771::pipeline_batch;
+	using batch_queue = comp6771::bounded_queue<pipeline_batch*>;
+
+	auto cast(int i) -> std::size_t {
+		return static_cast<std::size_t>(i);
+	}
+
+	auto check_options(comp6771::pipeline_options const& options,
+	                   std::span<comp6771::pipeline_stage const> stages) -> void {
+		if (options.batch_size <= 0) {
+			throw std::invalid_argument("a pipeline's batches need at least one row");
+		}
+		if (options.batches == 0) {
+			throw std::invalid_argument("a pipeline needs at least one batch");
+		}
+		auto const idle = [](comp6771::pipeline_stage const& stage) { return stage.workers == 0; };
+		if (std::any_of(stages.begin(), stages.end(), idle)) {
+			throw std::invalid_argument("a pipeline stage needs at least one worker");
+		}
+	}
+
+	// The queues between the threads of one run_pipeline: queues[0] holds the batches that are
+	// free to fill, queues[k + 1] those waiting for stage k, and the last those waiting for the
+	// sink. A thread that throws closes every queue, so the others stop at their next push or pop.
+	class pipeline_state {
+	public:
+		pipeline_state(std::size_t batches, std::size_t stages) {
+			queues_.reserve(stages + 2);
+			for (auto i = std::size_t{0}; i < stages + 2; ++i) {
+				queues_.push_back(std::make_unique<batch_queue>(batches));
+			}
+		}
+
+		[[nodiscard]] auto queue(std::size_t i) noexcept -> batch_queue& {
+			return *queues_[i];
+		}
+
+		[[nodiscard]] auto failed() const noexcept -> bool {
+			return failed_.load(std::memory_order_acquire);
+		}
+
+		// keeps the exception being handled, unless another thread failed first
+		auto fail() -> void {
+			{
+				auto const lock = std::scoped_lock(mutex_);
+				if (exception_ == nullptr) {
+					exception_ = std::current_exception();
+				}
+			}
+			failed_.store(true, std::memory_order_release);
+			for (auto const& queue : queues_) {
+				queue->close();
+			}
+		}
+
+		auto rethrow() const -> void {
+			if (exception_ != nullptr) {
+				std::rethrow_exception(exception_);
+			}
+		}
+
+	private:
+		std::vector<std::unique_ptr<batch_queue>> queues_;
+		std::mutex mutex_;
+		std::exception_ptr exception_;
+		std::atomic<bool> failed_ = false;
+	};
+
+	auto read(pipeline_state& state, comp6771::pipeline_source const& source) -> void {
+		auto& free = state.queue(0);
+		auto& next = state.queue(1);
+		try {
+			for (auto sequence = std::uint64_t{0};; ++sequence) {
+				auto const batch = free.pop();
+				if (not batch or state.failed()) {
+					return;
+				}
+				auto& filling = **batch;
+				filling.started = std::chrono::steady_clock::now();
+				filling.sequence = sequence;
+				filling.size = source(filling.vectors);
+				if (filling.size < 0 or filling.size > filling.vectors.size()) {
+					throw std::logic_error("a pipeline source filled more rows than its batch has");
+				}
+				if (filling.size != 0 and not next.push(*batch)) {
+					return;
+				}
+				if (filling.size < filling.vectors.size()) {
+					next.close();
+					return;
+				}
+			}
+		} catch (...) {
+			state.fail();
+		}
+	}
+
+	// The last of a stage's workers to finish closes the next queue, which ends the stream there.
+	auto work(pipeline_state& state,
+	          comp6771::pipeline_stage const& stage,
+	          std::size_t const index,
+	          std::atomic<std::size_t>& running) -> void {
+		auto& in = state.queue(index + 1);
+		auto& out = state.queue(index + 2);
+		try {
+			while (auto const batch = in.pop()) {
+				if (state.failed()) {
+					break;
+				}
+				stage.run(**batch);
+				if (not out.push(*batch)) {
+					break;
+				}
+			}
+		} catch (...) {
+			state.fail();
+		}
+		if (running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			out.close();
+		}
+	}
+
+	auto record(comp6771::pipeline_report& report, pipeline_batch const& batch) -> void {
+		auto const elapsed = std::chrono::steady_clock::now() - batch.started;
+		auto const nanoseconds = static_cast<std::uint64_t>(
+		   std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+		auto& statistics = report.batches;
+		++statistics.calls;
+		statistics.bytes += cast(batch.size) * cast(batch.vectors.dimensions()) * sizeof(double);
+		statistics.nanoseconds += nanoseconds;
+		// the power-of-two buckets instrumentation.hpp describes
+		auto const bucket = std::min(static_cast<std::size_t>(std::bit_width(nanoseconds)),
+		                             comp6771::instrumentation::latency_buckets - 1);
+		++statistics.latency[bucket];
+		report.vectors += cast(batch.size);
+	}
+
+	// Sinks batches in sequence. At most one batch per slot of `pending` is in flight, and a
+	// batch's slot is not reused until it is sunk, so sequence % size picks a slot no other
+	// batch in flight is using.
+	auto drain(pipeline_state& state,
+	           std::size_t const stages,
+	           comp6771::pipeline_sink const& sink,
+	           std::vector<pipeline_batch*>& pending,
+	           comp6771::pipeline_report& report) -> void {
+		auto& free = state.queue(0);
+		auto& in = state.queue(stages + 1);
+		auto next = std::uint64_t{0};
+		while (auto const batch = in.pop()) {
+			if (state.failed()) {
+				return;
+			}
+			pending[(*batch)->sequence % pending.size()] = *batch;
+			while (pending[next % pending.size()] != nullptr) {
+				auto* const ready = std::exchange(pending[next % pending.size()], nullptr);
+				sink(*ready);
+				record(report, *ready);
+				free.push(ready);
+				++next;
+			}
+		}
+	}
+} // namespace
+
+namespace comp6771 {
+	auto run_pipeline(int dimensions,
+	                  int result_dimensions,
+	                  pipeline_source const& source,
+	                  std::span<pipeline_stage const> stages,
+	                  pipeline_sink const& sink,
+	                  pipeline_options const& options) -> pipeline_report {
+		check_options(options, stages);
+		auto batches = std::vector<pipeline_batch>();
+		batches.reserve(options.batches);
+		for (auto i = std::size_t{0}; i < options.batches; ++i) {
+			batches.push_back(pipeline_batch{euclidean_vector_batch(options.batch_size, dimensions),
+			                                 euclidean_vector_batch(options.batch_size,
+			                                                        result_dimensions),
+			                                 0,
+			                                 0,
+			                                 {}});
+		}
+		auto state = pipeline_state(options.batches, stages.size());
+		for (auto& batch : batches) {
+			state.queue(0).push(&batch);
+		}
+		auto running = std::vector<std::atomic<std::size_t>>(stages.size());
+		auto pending = std::vector<pipeline_batch*>(options.batches, nullptr);
+		auto report = pipeline_report();
+		{
+			auto threads = std::vector<std::jthread>();
+			try {
+				threads.emplace_back([&] { read(state, source); });
+				for (auto k = std::size_t{0}; k < stages.size(); ++k) {
+					running[k].store(stages[k].workers, std::memory_order_relaxed);
+					for (auto w = std::size_t{0}; w < stages[k].workers; ++w) {
+						threads.emplace_back([&, k] { work(state, stages[k], k, running[k]); });
+					}
+				}
+				drain(state, stages.size(), sink, pending, report);
+			} catch (...) {
+				state.fail();
+			}
+		}
+		state.rethrow();
+		return report;
+	}
+
+	auto score_stream(vector_file_reader& in,
+	                  euclidean_matrix const& references,
+	                  vector_file_writer& out,
+	                  scoring_workers const& workers,
+	                  pipeline_options const& options) -> pipeline_report {
+		if (references.columns() != in.dimensions()) {
+			detail::throw_dimension_mismatch(references.columns(), in.dimensions());
+		}
+		if (out.dimensions() != references.rows()) {
+			detail::throw_dimension_mismatch(references.rows(), out.dimensions());
+		}
+		auto const read_rows = [&in](euclidean_vector_batch& batch) {
+			auto rows = 0;
+			while (rows < batch.size() and in.read(batch[rows])) {
+				++rows;
+			}
+			return rows;
+		};
+		auto const normalize = [](pipeline_batch& batch) {
+			comp6771::normalize(batch.vectors, batch.size);
+		};
+		// the rows past the end of a stream's last batch are scored too, and not written
+		auto const score = [&references](pipeline_batch& batch) {
+			transform(references, batch.vectors, batch.results);
+		};
+		auto const write_rows = [&out](pipeline_batch const& batch) {
+			if (batch.size == batch.results.size()) {
+				out.write(batch.results);
+				return;
+			}
+			for (auto i = 0; i < batch.size; ++i) {
+				out.write(batch.results[i]);
+			}
+		};
+		auto const stages = std::array{pipeline_stage{normalize, workers.unit},
+		                               pipeline_stage{score, workers.dot}};
+		return run_pipeline(in.dimensions(),
+		                    references.rows(),
+		                    read_rows,
+		                    stages,
+		                    write_rows,
+		                    options);
+	}
+} // namespace comp6771
@@ -0,0 +1,250 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_statistics.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	using comp6771::euclidean_vector;
+	using comp6771::euclidean_vector_batch;
+	using comp6771::for_each_index;
+	using comp6771::norm_histogram_options;
+	using comp6771::thread_pool;
+	using comp6771::vector_statistics;
+
+	constexpr auto infinity = std::numeric_limits<double>::infinity();
+
+	auto cast(int i) -> std::size_t {
+		return static_cast<std::size_t>(i);
+	}
+
+	// writing through operator[] also discards the cached norm
+	auto magnitudes(euclidean_vector& vector) -> double* {
+		return vector.dimensions() == 0 ? nullptr : &vector[0];
+	}
+
+	auto check_histogram(norm_histogram_options const& histogram) -> void {
+		if (histogram.bins < 0) {
+			throw std::invalid_argument("a norm histogram cannot have a negative number of bins");
+		}
+		if (histogram.bins > 0 and not(histogram.low < histogram.high)) {
+			throw std::invalid_argument("a norm histogram's low edge must be below its high edge");
+		}
+	}
+
+	// Gathers the statistics of rows [0, rows) of `vectors` one chunk per task, and merges them
+	// into `result` in order.
+	auto describe_rows(vector_statistics& result,
+	                   euclidean_vector_batch const& vectors,
+	                   std::size_t const rows,
+	                   norm_histogram_options const& histogram,
+	                   thread_pool* pool) -> void {
+		constexpr auto chunk = comp6771::statistics_chunk_size;
+		auto const chunks = (rows + chunk - 1) / chunk;
+		auto const empty = vector_statistics(vectors.dimensions(), histogram);
+		auto partials = std::vector<vector_statistics>(chunks, empty);
+		for_each_index(pool, chunks, [&](std::size_t const c) {
+			auto const last = std::min(rows, (c + 1) * chunk);
+			for (auto r = c * chunk; r < last; ++r) {
+				partials[c].add(vectors[static_cast<int>(r)]);
+			}
+		});
+		for (auto const& partial : partials) {
+			result.merge(partial);
+		}
+	}
+
+	auto describe_batch(euclidean_vector_batch const& vectors,
+	                    norm_histogram_options const& histogram,
+	                    thread_pool* pool) -> vector_statistics {
+		auto result = vector_statistics(vectors.dimensions(), histogram);
+		describe_rows(result, vectors, cast(vectors.size()), histogram, pool);
+		return result;
+	}
+
+	auto describe_file(comp6771::vector_file_reader& reader,
+	                   norm_histogram_options const& histogram,
+	                   thread_pool* pool) -> vector_statistics {
+		auto result = vector_statistics(reader.dimensions(), histogram);
+		// a chunk for each thread at a time
+		auto const block = comp6771::statistics_chunk_size * (pool == nullptr ? 1 : pool->size());
+		auto buffer = euclidean_vector_batch(static_cast<int>(block), reader.dimensions());
+		for (;;) {
+			auto rows = std::size_t{0};
+			while (rows < block and reader.read(buffer[static_cast<int>(rows)])) {
+				++rows;
+			}
+			describe_rows(result, buffer, rows, histogram, pool);
+			if (rows < block) {
+				return result;
+			}
+		}
+	}
+} // namespace
+
+namespace comp6771 {
+	vector_statistics::vector_statistics(int dimensions, norm_histogram_options const& histogram)
+	: sum_(dimensions)
+	, mean_(dimensions)
+	, m2_(dimensions)
+	, min_(dimensions, infinity)
+	, max_(dimensions, -infinity)
+	, histogram_{histogram.low, histogram.high, {}, 0, 0} {
+		check_histogram(histogram);
+		histogram_.counts.resize(cast(histogram.bins));
+	}
+
+	auto vector_statistics::add(euclidean_vector_view vector) -> void {
+		if (vector.dimensions() != dimensions()) {
+			detail::throw_dimension_mismatch(dimensions(), vector.dimensions());
+		}
+		if (vector.is_contiguous()) {
+			add_contiguous(vector.data());
+			return;
+		}
+		scratch_.resize(cast(vector.dimensions()));
+		for (auto i = 0; i < vector.dimensions(); ++i) {
+			scratch_[cast(i)] = vector[i];
+		}
+		add_contiguous(scratch_.data());
+	}
+
+	auto vector_statistics::add(euclidean_vector_batch const& vectors) -> void {
+		for (auto i = 0; i < vectors.size(); ++i) {
+			add(vectors[i]);
+		}
+	}
+
+	auto vector_statistics::add_contiguous(double const* x) -> void {
+		++count_;
+		auto const size = cast(dimensions());
+		if (size != 0) {
+			auto const accumulators = kernels::welford_accumulators{magnitudes(sum_),
+			                                                        magnitudes(mean_),
+			                                                        magnitudes(m2_),
+			                                                        magnitudes(min_),
+			                                                        magnitudes(max_)};
+			kernels::welford_step(accumulators, x, 1.0 / static_cast<double>(count_), size);
+		}
+		if (histogram_.counts.empty()) {
+			return;
+		}
+		auto const norm = std::sqrt(kernels::sum_of_squares(x, size));
+		if (norm < histogram_.low) {
+			++histogram_.below;
+			return;
+		}
+		if (not(norm < histogram_.high)) {
+			++histogram_.above;
+			return;
+		}
+		auto const bins = histogram_.counts.size();
+		auto const position = (norm - histogram_.low) / (histogram_.high - histogram_.low);
+		// rounding can put a norm just below high into the bin past the last
+		auto const bin = std::min(static_cast<std::size_t>(position * static_cast<double>(bins)),
+		                          bins - 1);
+		++histogram_.counts[bin];
+	}
+
+	auto vector_statistics::merge(vector_statistics const& other) -> void {
+		if (other.dimensions() != dimensions()) {
+			detail::throw_dimension_mismatch(dimensions(), other.dimensions());
+		}
+		if (other.histogram_.counts.size() != histogram_.counts.size()
+		    or (not histogram_.counts.empty()
+		        and (other.histogram_.low != histogram_.low
+		             or other.histogram_.high != histogram_.high))) {
+			throw std::logic_error("statistics with different norm histogram bins cannot be merged");
+		}
+		if (other.count_ == 0) {
+			return;
+		}
+		if (count_ == 0) {
+			*this = other;
+			return;
+		}
+		auto const n_a = static_cast<double>(count_);
+		auto const n_b = static_cast<double>(other.count_);
+		auto const n = n_a + n_b;
+		auto* const mean = magnitudes(mean_);
+		auto* const m2 = magnitudes(m2_);
+		auto* const min = magnitudes(min_);
+		auto* const max = magnitudes(max_);
+		for (auto i = 0; i < dimensions(); ++i) {
+			auto const delta = other.mean_[i] - mean[i];
+			mean[i] += delta * (n_b / n);
+			m2[i] += other.m2_[i] + delta * delta * (n_a * n_b / n);
+			min[i] = std::min(min[i], other.min_[i]);
+			max[i] = std::max(max[i], other.max_[i]);
+		}
+		sum_ += other.sum_;
+		count_ += other.count_;
+		for (auto b = std::size_t{0}; b < histogram_.counts.size(); ++b) {
+			histogram_.counts[b] += other.histogram_.counts[b];
+		}
+		histogram_.below += other.histogram_.below;
+		histogram_.above += other.histogram_.above;
+	}
+
+	auto vector_statistics::check_count(std::uint64_t const minimum) const -> void {
+		if (count_ < minimum) {
+			throw std::logic_error(minimum == 1 ? "statistics of no vectors are undefined"
+			                                    : "a sample variance needs at least two vectors");
+		}
+	}
+
+	auto vector_statistics::mean() const -> euclidean_vector const& {
+		check_count(1);
+		return mean_;
+	}
+
+	auto vector_statistics::min() const -> euclidean_vector const& {
+		check_count(1);
+		return min_;
+	}
+
+	auto vector_statistics::max() const -> euclidean_vector const& {
+		check_count(1);
+		return max_;
+	}
+
+	auto vector_statistics::variance() const -> euclidean_vector {
+		check_count(1);
+		return euclidean_vector(m2_ / static_cast<double>(count_));
+	}
+
+	auto vector_statistics::sample_variance() const -> euclidean_vector {
+		check_count(2);
+		return euclidean_vector(m2_ / static_cast<double>(count_ - 1));
+	}
+
+	auto describe(euclidean_vector_batch const& vectors, norm_histogram_options const& histogram)
+	   -> vector_statistics {
+		return describe_batch(vectors, histogram, nullptr);
+	}
+
+	auto describe(euclidean_vector_batch const& vectors,
+	              norm_histogram_options const& histogram,
+	              thread_pool& pool) -> vector_statistics {
+		return describe_batch(vectors, histogram, &pool);
+	}
+
+	auto describe(vector_file_reader& reader, norm_histogram_options const& histogram)
+	   -> vector_statistics {
+		return describe_file(reader, histogram, nullptr);
+	}
+
+	auto describe(vector_file_reader& reader,
+	              norm_histogram_options const& histogram,
+	              thread_pool& pool) -> vector_statistics {
+		return describe_file(reader, histogram, &pool);
+	}
+} // namespace comp6771
@@ -0,0 +1,177 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	using comp6771::euclidean_vector_view;
+
+	auto cast(int i) -> std::size_t {
+		return static_cast<std::size_t>(i);
+	}
+
+	// A strided view is gathered into `scratch` so that the SIMD kernels can read it.
+	auto contiguous(euclidean_vector_view v, std::vector<double>& scratch) -> double const* {
+		if (v.is_contiguous()) {
+			return v.data();
+		}
+		scratch = static_cast<std::vector<double>>(v);
+		return scratch.data();
+	}
+
+	auto check_dimensions(euclidean_vector_view x, euclidean_vector_view y) -> void {
+		if (x.dimensions() != y.dimensions()) {
+			comp6771::detail::throw_dimension_mismatch(x.dimensions(), y.dimensions());
+		}
+	}
+} // namespace
+
+namespace comp6771 {
+	auto euclidean_vector_ref::operator+=(euclidean_vector_view vector) -> euclidean_vector_ref& {
+		return *this = *this + vector;
+	}
+
+	auto euclidean_vector_ref::operator-=(euclidean_vector_view vector) -> euclidean_vector_ref& {
+		return *this = *this - vector;
+	}
+
+	auto euclidean_vector_ref::operator*=(double multiplier) noexcept -> euclidean_vector_ref& {
+		if (is_contiguous()) {
+			kernels::multiply(magnitudes_, magnitudes_, multiplier, cast(dimension_));
+			return *this;
+		}
+		for (auto i = 0; i < dimension_; ++i) {
+			(*this)[i] *= multiplier;
+		}
+		return *this;
+	}
+
+	auto euclidean_vector_ref::operator/=(double divisor) -> euclidean_vector_ref& {
+		if (divisor == 0) {
+			throw std::logic_error("Invalid vector division by 0");
+		}
+		if (is_contiguous()) {
+			kernels::divide(magnitudes_, magnitudes_, divisor, cast(dimension_));
+			return *this;
+		}
+		for (auto i = 0; i < dimension_; ++i) {
+			(*this)[i] /= divisor;
+		}
+		return *this;
+	}
+
+	auto operator==(euclidean_vector_view x, euclidean_vector_view y) noexcept -> bool {
+		if (x.dimensions() != y.dimensions()) {
+			return false;
+		}
+		if (x.is_contiguous() and y.is_contiguous()) {
+			return kernels::equal(x.data(), y.data(), cast(x.dimensions()));
+		}
+		for (auto i = 0; i < x.dimensions(); ++i) {
+			if (x[i] != y[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	auto operator!=(euclidean_vector_view x, euclidean_vector_view y) noexcept -> bool {
+		return not(x == y);
+	}
+
+	auto euclidean_norm(euclidean_vector_view v) -> double {
+		if (v.dimensions() == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		auto scratch = std::vector<double>();
+		return std::sqrt(kernels::sum_of_squares(contiguous(v, scratch), cast(v.dimensions())));
+	}
+
+	auto euclidean_norm(euclidean_vector_view v, accumulation const policy) -> double {
+		if (v.dimensions() == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		auto scratch = std::vector<double>();
+		return kernels::norm(contiguous(v, scratch), cast(v.dimensions()), policy);
+	}
+
+	auto unit(euclidean_vector_view v) -> euclidean_vector {
+		if (v.dimensions() == 0) {
+			detail::throw_no_unit_vector(0);
+		}
+		auto const norm = euclidean_norm(v);
+		if (norm == 0) {
+			detail::throw_no_unit_vector(v.dimensions());
+		}
+		return euclidean_vector(v * (1.0 / norm));
+	}
+
+	auto dot(euclidean_vector_view x, euclidean_vector_view y) -> double {
+		check_dimensions(x, y);
+		auto x_scratch = std::vector<double>();
+		auto y_scratch = std::vector<double>();
+		return kernels::dot(contiguous(x, x_scratch),
+		                    contiguous(y, y_scratch),
+		                    cast(x.dimensions()));
+	}
+
+	auto dot(euclidean_vector_view x, euclidean_vector_view y, accumulation const policy) -> double {
+		check_dimensions(x, y);
+		auto x_scratch = std::vector<double>();
+		auto y_scratch = std::vector<double>();
+		return kernels::dot(contiguous(x, x_scratch),
+		                    contiguous(y, y_scratch),
+		                    cast(x.dimensions()),
+		                    policy);
+	}
+
+	auto squared_distance(euclidean_vector_view x, euclidean_vector_view y) -> double {
+		check_dimensions(x, y);
+		auto x_scratch = std::vector<double>();
+		auto y_scratch = std::vector<double>();
+		return kernels::squared_distance(contiguous(x, x_scratch),
+		                                 contiguous(y, y_scratch),
+		                                 cast(x.dimensions()));
+	}
+
+	auto distance(euclidean_vector_view x, euclidean_vector_view y) -> double {
+		return std::sqrt(squared_distance(x, y));
+	}
+
+	auto cosine_similarity(euclidean_vector_view x, euclidean_vector_view y) -> double {
+		check_dimensions(x, y);
+		if (x.dimensions() == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a cosine "
+			                       "similarity");
+		}
+		auto x_scratch = std::vector<double>();
+		auto y_scratch = std::vector<double>();
+		auto const terms = kernels::dot_terms_of(contiguous(x, x_scratch),
+		                                         contiguous(y, y_scratch),
+		                                         cast(x.dimensions()));
+		auto const x_norm = std::sqrt(terms.xx);
+		auto const y_norm = std::sqrt(terms.yy);
+		if (x_norm == 0 or y_norm == 0) {
+			throw std::logic_error("euclidean_vector with zero euclidean normal does not have a "
+			                       "cosine similarity");
+		}
+		return terms.xy / (x_norm * y_norm);
+	}
+
+	auto axpy(double alpha, euclidean_vector_view x, euclidean_vector_ref y) -> void {
+		check_dimensions(x, y);
+		if (x.is_contiguous() and y.is_contiguous()) {
+			kernels::axpy(y.data(), alpha, x.data(), cast(y.dimensions()));
+			return;
+		}
+		for (auto i = 0; i < y.dimensions(); ++i) {
+			y[i] += alpha * x[i];
+		}
+	}
+} // namespace comp6771
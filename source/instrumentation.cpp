@@ -0,0 +1,211 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/instrumentation.hpp"
+#include "comp6771/thread_registry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace {
+	namespace instrumentation = comp6771::instrumentation;
+
+	using counter = std::atomic<std::uint64_t>;
+
+	struct operation_counters {
+		counter calls = 0;
+		counter bytes = 0;
+		counter nanoseconds = 0;
+		std::array<counter, instrumentation::latency_buckets> latency = {};
+	};
+
+	// one thread's counters, which comp6771::detail::thread_registry totals
+	struct thread_counters {
+		std::array<operation_counters, instrumentation::operation_count> operations = {};
+		std::array<counter, instrumentation::event_count> events = {};
+
+		auto add_to(instrumentation::snapshot& total) const noexcept -> void;
+		auto reset() noexcept -> void;
+	};
+
+	using registry = comp6771::detail::thread_registry<thread_counters, instrumentation::snapshot>;
+	using comp6771::detail::add;
+
+	auto thread_counters::add_to(instrumentation::snapshot& total) const noexcept -> void {
+		for (auto i = std::size_t{0}; i < operations.size(); ++i) {
+			auto const& from = operations[i];
+			auto& to = total.operations[i];
+			to.calls += from.calls.load(std::memory_order_relaxed);
+			to.bytes += from.bytes.load(std::memory_order_relaxed);
+			to.nanoseconds += from.nanoseconds.load(std::memory_order_relaxed);
+			for (auto b = std::size_t{0}; b < from.latency.size(); ++b) {
+				to.latency[b] += from.latency[b].load(std::memory_order_relaxed);
+			}
+		}
+		for (auto i = std::size_t{0}; i < events.size(); ++i) {
+			total.events[i] += events[i].load(std::memory_order_relaxed);
+		}
+	}
+
+	auto thread_counters::reset() noexcept -> void {
+		for (auto& op : operations) {
+			op.calls.store(0, std::memory_order_relaxed);
+			op.bytes.store(0, std::memory_order_relaxed);
+			op.nanoseconds.store(0, std::memory_order_relaxed);
+			for (auto& bucket : op.latency) {
+				bucket.store(0, std::memory_order_relaxed);
+			}
+		}
+		for (auto& e : events) {
+			e.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	auto latency_bucket(std::uint64_t const nanoseconds) noexcept -> std::size_t {
+		return std::min(static_cast<std::size_t>(std::bit_width(nanoseconds)),
+		                instrumentation::latency_buckets - 1);
+	}
+
+	constexpr auto operation_names = std::array<std::string_view, instrumentation::operation_count>{
+	   "construct",
+	   "copy",
+	   "move",
+	   "copy_assign",
+	   "move_assign",
+	   "evaluate",
+	   "add",
+	   "subtract",
+	   "multiply",
+	   "divide",
+	   "negate",
+	   "dot",
+	   "euclidean_norm",
+	   "unit",
+	   "normalize",
+	};
+
+	constexpr auto event_names = std::array<std::string_view, instrumentation::event_count>{
+	   "allocation",
+	   "allocated_bytes",
+	   "dimension_mismatch",
+	};
+} // namespace
+
+namespace comp6771::instrumentation {
+	auto operation_statistics::latency_quantile(double const quantile) const noexcept
+	   -> std::uint64_t {
+		if (calls == 0) {
+			return 0;
+		}
+		auto const exact_rank = std::ceil(quantile * static_cast<double>(calls));
+		auto const rank = std::max(static_cast<std::uint64_t>(exact_rank), std::uint64_t{1});
+		auto seen = std::uint64_t{0};
+		for (auto b = std::size_t{0}; b < latency.size(); ++b) {
+			seen += latency[b];
+			if (seen >= rank) {
+				return std::uint64_t{1} << b;
+			}
+		}
+		return std::uint64_t{1} << (latency.size() - 1);
+	}
+
+	auto name(operation const op) noexcept -> std::string_view {
+		return operation_names[static_cast<std::size_t>(op)];
+	}
+
+	auto name(event const e) noexcept -> std::string_view {
+		return event_names[static_cast<std::size_t>(e)];
+	}
+
+	auto collect() -> snapshot {
+		return registry::total();
+	}
+
+	auto reset() noexcept -> void {
+		registry::reset();
+	}
+
+	auto to_json(snapshot const& statistics) -> std::string {
+		auto json = std::string(R"({"operations":{)");
+		auto out = std::back_inserter(json);
+		auto first = true;
+		for (auto i = std::size_t{0}; i < operation_count; ++i) {
+			auto const& op = statistics.operations[i];
+			if (op.calls == 0) {
+				continue;
+			}
+			fmt::format_to(out,
+			               R"({}"{}":{{"calls":{},"bytes":{},"nanoseconds":{},"latency":[{}]}})",
+			               first ? "" : ",",
+			               operation_names[i],
+			               op.calls,
+			               op.bytes,
+			               op.nanoseconds,
+			               fmt::join(op.latency, ","));
+			first = false;
+		}
+		json += R"(},"events":{)";
+		for (auto i = std::size_t{0}; i < event_count; ++i) {
+			fmt::format_to(out,
+			               R"({}"{}":{})",
+			               i == 0 ? "" : ",",
+			               event_names[i],
+			               statistics.events[i]);
+		}
+		json += "}}";
+		return json;
+	}
+
+	auto to_table(snapshot const& statistics) -> std::string {
+		auto table = fmt::format("{:<18} {:>12} {:>16} {:>12} {:>10} {:>10}\n",
+		                         "operation",
+		                         "calls",
+		                         "bytes",
+		                         "mean ns",
+		                         "p50 ns <",
+		                         "p99 ns <");
+		auto out = std::back_inserter(table);
+		for (auto i = std::size_t{0}; i < operation_count; ++i) {
+			auto const& op = statistics.operations[i];
+			if (op.calls == 0) {
+				continue;
+			}
+			fmt::format_to(out,
+			               "{:<18} {:>12} {:>16} {:>12.1f} {:>10} {:>10}\n",
+			               operation_names[i],
+			               op.calls,
+			               op.bytes,
+			               static_cast<double>(op.nanoseconds) / static_cast<double>(op.calls),
+			               op.latency_quantile(0.5),
+			               op.latency_quantile(0.99));
+		}
+		fmt::format_to(out, "\n{:<18} {:>12}\n", "event", "count");
+		for (auto i = std::size_t{0}; i < event_count; ++i) {
+			fmt::format_to(out, "{:<18} {:>12}\n", event_names[i], statistics.events[i]);
+		}
+		return table;
+	}
+
+	auto detail::record(operation const op,
+	                    std::uint64_t const bytes,
+	                    std::uint64_t const nanoseconds) noexcept -> void {
+		auto& counters = registry::local().operations[static_cast<std::size_t>(op)];
+		add(counters.calls, 1);
+		add(counters.bytes, bytes);
+		add(counters.nanoseconds, nanoseconds);
+		add(counters.latency[latency_bucket(nanoseconds)], 1);
+	}
+
+	auto detail::record(event const e, std::uint64_t const amount) noexcept -> void {
+		add(registry::local().events[static_cast<std::size_t>(e)], amount);
+	}
+} // namespace comp6771::instrumentation
@@ -0,0 +1,294 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/sparse_euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fmt/format.h>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	using comp6771::sparse_euclidean_vector;
+
+	auto cast(int i) -> std::size_t {
+		return static_cast<std::size_t>(i);
+	}
+
+	auto check_dimensions(int x, int y) -> void {
+		if (x != y) {
+			comp6771::detail::throw_dimension_mismatch(x, y);
+		}
+	}
+
+	[[noreturn]] auto throw_invalid_index(int dimension) -> void {
+		throw std::out_of_range(
+		   fmt::format("Index {} is not Valid for this sparse_euclidean_vector object", dimension));
+	}
+
+	// Walks both index lists in step: O(x + y).
+	auto merge_dot(sparse_euclidean_vector const& x, sparse_euclidean_vector const& y) -> double {
+		auto const x_indices = x.indices();
+		auto const y_indices = y.indices();
+		auto sum = 0.0;
+		auto i = std::size_t{0};
+		auto j = std::size_t{0};
+		while (i < x_indices.size() and j < y_indices.size()) {
+			if (x_indices[i] < y_indices[j]) {
+				++i;
+			}
+			else if (y_indices[j] < x_indices[i]) {
+				++j;
+			}
+			else {
+				sum += x.values()[i++] * y.values()[j++];
+			}
+		}
+		return sum;
+	}
+
+	// Finds each index of `small` in `large` by doubling a step from the last match and then
+	// searching the bracketed range: O(small log(large / small)). Products are added in the same
+	// order as merge_dot adds them.
+	auto galloping_dot(sparse_euclidean_vector const& small, sparse_euclidean_vector const& large)
+	   -> double {
+		auto const indices = large.indices();
+		auto const size = indices.size();
+		auto sum = 0.0;
+		auto position = std::size_t{0};
+		for (auto k = std::size_t{0}; k < small.indices().size() and position < size; ++k) {
+			auto const target = small.indices()[k];
+			auto low = position;
+			auto high = position;
+			for (auto step = std::size_t{1}; high < size and indices[high] < target; step *= 2) {
+				low = high + 1;
+				high += step;
+			}
+			auto const last = indices.begin() + static_cast<std::ptrdiff_t>(std::min(high + 1, size));
+			auto const found = std::lower_bound(indices.begin() + static_cast<std::ptrdiff_t>(low),
+			                                    last,
+			                                    target);
+			position = static_cast<std::size_t>(found - indices.begin());
+			if (position < size and indices[position] == target) {
+				sum += small.values()[k] * large.values()[position];
+			}
+		}
+		return sum;
+	}
+} // namespace
+
+namespace comp6771 {
+	sparse_euclidean_vector::sparse_euclidean_vector() noexcept
+	: sparse_euclidean_vector(1) {}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(int dimensions) noexcept
+	: dimension_{dimensions} {}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(int dimensions,
+	                                                 std::span<int const> indices,
+	                                                 std::span<double const> values)
+	: dimension_{dimensions} {
+		if (indices.size() != values.size()) {
+			throw std::logic_error(fmt::format("sparse_euclidean_vector needs one value per index, "
+			                                   "but has {} indices and {} values",
+			                                   indices.size(),
+			                                   values.size()));
+		}
+		for (auto const index : indices) {
+			if (index < 0 or index >= dimensions) {
+				throw_invalid_index(index);
+			}
+		}
+		// a stable sort sums repeated indices in the order they were given
+		auto order = std::vector<std::size_t>(indices.size());
+		std::iota(order.begin(), order.end(), std::size_t{0});
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t const a, std::size_t const b) {
+			return indices[a] < indices[b];
+		});
+		indices_.reserve(order.size());
+		values_.reserve(order.size());
+		for (auto const k : order) {
+			if (not indices_.empty() and indices_.back() == indices[k]) {
+				values_.back() += values[k];
+			}
+			else {
+				indices_.push_back(indices[k]);
+				values_.push_back(values[k]);
+			}
+		}
+		drop_zeros();
+	}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(euclidean_vector_view vector)
+	: dimension_{vector.dimensions()} {
+		for (auto i = 0; i < dimension_; ++i) {
+			if (vector[i] != 0) {
+				indices_.push_back(i);
+				values_.push_back(vector[i]);
+			}
+		}
+	}
+
+	auto sparse_euclidean_vector::operator[](int dimension) const noexcept -> double {
+		auto const found = std::lower_bound(indices_.begin(), indices_.end(), dimension);
+		if (found == indices_.end() or *found != dimension) {
+			return 0.0;
+		}
+		return values_[static_cast<std::size_t>(found - indices_.begin())];
+	}
+
+	auto sparse_euclidean_vector::at(int dimension) const -> double {
+		if (dimension < 0 or dimension >= dimension_) {
+			throw_invalid_index(dimension);
+		}
+		return (*this)[dimension];
+	}
+
+	auto sparse_euclidean_vector::operator-() const -> sparse_euclidean_vector {
+		auto result = *this;
+		for (auto& value : result.values_) {
+			value = -value;
+		}
+		return result;
+	}
+
+	auto sparse_euclidean_vector::operator+=(sparse_euclidean_vector const& vector)
+	   -> sparse_euclidean_vector& {
+		return *this = combine(*this, vector, 1.0);
+	}
+
+	auto sparse_euclidean_vector::operator-=(sparse_euclidean_vector const& vector)
+	   -> sparse_euclidean_vector& {
+		return *this = combine(*this, vector, -1.0);
+	}
+
+	auto sparse_euclidean_vector::operator*=(double multiplier) -> sparse_euclidean_vector& {
+		kernels::multiply(values_.data(), values_.data(), multiplier, values_.size());
+		drop_zeros();
+		return *this;
+	}
+
+	auto sparse_euclidean_vector::operator/=(double divisor) -> sparse_euclidean_vector& {
+		if (divisor == 0) {
+			throw std::logic_error("Invalid vector division by 0");
+		}
+		kernels::divide(values_.data(), values_.data(), divisor, values_.size());
+		drop_zeros();
+		return *this;
+	}
+
+	sparse_euclidean_vector::operator euclidean_vector() const {
+		auto result = euclidean_vector(dimension_);
+		for (auto k = std::size_t{0}; k < indices_.size(); ++k) {
+			result[indices_[k]] = values_[k];
+		}
+		return result;
+	}
+
+	sparse_euclidean_vector::operator std::vector<double>() const {
+		auto result = std::vector<double>(cast(dimension_));
+		for (auto k = std::size_t{0}; k < indices_.size(); ++k) {
+			result[cast(indices_[k])] = values_[k];
+		}
+		return result;
+	}
+
+	auto sparse_euclidean_vector::drop_zeros() -> void {
+		auto kept = std::size_t{0};
+		for (auto k = std::size_t{0}; k < values_.size(); ++k) {
+			if (values_[k] != 0) {
+				indices_[kept] = indices_[k];
+				values_[kept] = values_[k];
+				++kept;
+			}
+		}
+		indices_.resize(kept);
+		values_.resize(kept);
+	}
+
+	auto sparse_euclidean_vector::combine(sparse_euclidean_vector const& x,
+	                                      sparse_euclidean_vector const& y,
+	                                      double const sign) -> sparse_euclidean_vector {
+		check_dimensions(x.dimension_, y.dimension_);
+		auto result = sparse_euclidean_vector(x.dimension_);
+		result.indices_.reserve(x.indices_.size() + y.indices_.size());
+		result.values_.reserve(x.indices_.size() + y.indices_.size());
+		auto i = std::size_t{0};
+		auto j = std::size_t{0};
+		while (i < x.indices_.size() or j < y.indices_.size()) {
+			if (j == y.indices_.size() or (i < x.indices_.size() and x.indices_[i] < y.indices_[j])) {
+				result.indices_.push_back(x.indices_[i]);
+				result.values_.push_back(x.values_[i++]);
+			}
+			else if (i == x.indices_.size() or y.indices_[j] < x.indices_[i]) {
+				result.indices_.push_back(y.indices_[j]);
+				result.values_.push_back(sign * y.values_[j++]);
+			}
+			else {
+				result.indices_.push_back(x.indices_[i]);
+				result.values_.push_back(sign > 0 ? x.values_[i++] + y.values_[j++]
+				                                  : x.values_[i++] - y.values_[j++]);
+			}
+		}
+		result.drop_zeros();
+		return result;
+	}
+
+	auto operator+(sparse_euclidean_vector const& lhs, sparse_euclidean_vector const& rhs)
+	   -> sparse_euclidean_vector {
+		return sparse_euclidean_vector::combine(lhs, rhs, 1.0);
+	}
+
+	auto operator-(sparse_euclidean_vector const& lhs, sparse_euclidean_vector const& rhs)
+	   -> sparse_euclidean_vector {
+		return sparse_euclidean_vector::combine(lhs, rhs, -1.0);
+	}
+
+	auto operator<<(std::ostream& os, sparse_euclidean_vector const& vector) -> std::ostream& {
+		return os << static_cast<euclidean_vector>(vector);
+	}
+
+	auto dot(sparse_euclidean_vector const& x, sparse_euclidean_vector const& y) -> double {
+		check_dimensions(x.dimensions(), y.dimensions());
+		auto const x_size = x.indices().size();
+		auto const y_size = y.indices().size();
+		if (x_size * galloping_ratio <= y_size) {
+			return galloping_dot(x, y);
+		}
+		if (y_size * galloping_ratio <= x_size) {
+			return galloping_dot(y, x);
+		}
+		return merge_dot(x, y);
+	}
+
+	auto dot(sparse_euclidean_vector const& x, euclidean_vector_view y) -> double {
+		check_dimensions(x.dimensions(), y.dimensions());
+		auto sum = 0.0;
+		for (auto k = std::size_t{0}; k < x.indices().size(); ++k) {
+			sum += x.values()[k] * y[x.indices()[k]];
+		}
+		return sum;
+	}
+
+	auto dot(euclidean_vector_view x, sparse_euclidean_vector const& y) -> double {
+		return dot(y, x);
+	}
+
+	auto axpy(double alpha, sparse_euclidean_vector const& x, euclidean_vector_ref y) -> void {
+		check_dimensions(x.dimensions(), y.dimensions());
+		for (auto k = std::size_t{0}; k < x.indices().size(); ++k) {
+			y[x.indices()[k]] += alpha * x.values()[k];
+		}
+	}
+
+	auto euclidean_norm(sparse_euclidean_vector const& v) -> double {
+		if (v.dimensions() == 0) {
+			throw std::logic_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		return std::sqrt(kernels::sum_of_squares(v.values().data(), v.values().size()));
+	}
+} // namespace comp6771
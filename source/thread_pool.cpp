@@ -0,0 +1,86 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/thread_pool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace comp6771 {
+	thread_pool::thread_pool(std::size_t threads) {
+		workers_.reserve(threads > 0 ? threads - 1 : 0);
+		for (auto i = std::size_t{1}; i < threads; ++i) {
+			workers_.emplace_back([this] { work(); });
+		}
+	}
+
+	thread_pool::~thread_pool() {
+		{
+			auto const lock = std::scoped_lock(mutex_);
+			stopping_ = true;
+		}
+		wake_.notify_all();
+		workers_.clear();
+	}
+
+	auto thread_pool::run(std::size_t count, std::function<void(std::size_t)> const& task) -> void {
+		auto const serialise = std::scoped_lock(run_mutex_);
+		{
+			auto const lock = std::scoped_lock(mutex_);
+			task_ = &task;
+			count_ = count;
+			next_.store(0, std::memory_order_relaxed);
+			busy_ = workers_.size();
+			++generation_;
+		}
+		wake_.notify_all();
+		drain(task, count);
+
+		auto lock = std::unique_lock(mutex_);
+		done_.wait(lock, [this] { return busy_ == 0; });
+	}
+
+	auto thread_pool::work() -> void {
+		// Start from the generation the pool was constructed with, not the current one: a loop may
+		// already have been started before this thread got to run.
+		auto seen = std::size_t{0};
+		auto lock = std::unique_lock(mutex_);
+		while (true) {
+			wake_.wait(lock, [this, &seen] { return stopping_ or generation_ != seen; });
+			if (stopping_) {
+				return;
+			}
+			seen = generation_;
+			auto const* const task = task_;
+			auto const count = count_;
+			lock.unlock();
+			drain(*task, count);
+			lock.lock();
+			if (--busy_ == 0) {
+				done_.notify_one();
+			}
+		}
+	}
+
+	auto thread_pool::drain(std::function<void(std::size_t)> const& task, std::size_t count)
+	   -> void {
+		for (auto i = next_.fetch_add(1, std::memory_order_relaxed); i < count;
+		     i = next_.fetch_add(1, std::memory_order_relaxed)) {
+			task(i);
+		}
+	}
+
+	auto for_each_index(thread_pool* const pool,
+	                    std::size_t const count,
+	                    std::function<void(std::size_t)> const& task) -> void {
+		if (pool == nullptr) {
+			for (auto i = std::size_t{0}; i < count; ++i) {
+				task(i);
+			}
+			return;
+		}
+		pool->run(count, task);
+	}
+} // namespace comp6771
@@ -0,0 +1,45 @@
+#ifndef COMP6771_TEST_COUNTING_DEFAULT_RESOURCE_HPP
+#define COMP6771_TEST_COUNTING_DEFAULT_RESOURCE_HPP
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace testing {
+	// Counts the allocations made through the default resource while it is alive.
+	class counting_default_resource : public std::pmr::memory_resource {
+	public:
+		counting_default_resource() noexcept
+		: upstream_{std::pmr::set_default_resource(this)} {}
+
+		counting_default_resource(counting_default_resource const&) = delete;
+		auto operator=(counting_default_resource const&) -> counting_default_resource& = delete;
+
+		~counting_default_resource() override {
+			std::pmr::set_default_resource(upstream_);
+		}
+
+		[[nodiscard]] auto allocations() const noexcept -> int {
+			return allocations_;
+		}
+
+	private:
+		std::pmr::memory_resource* upstream_;
+		int allocations_ = 0;
+
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			++allocations_;
+			return upstream_->allocate(bytes, alignment);
+		}
+
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			upstream_->deallocate(p, bytes, alignment);
+		}
+
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override {
+			return this == &other;
+		}
+	};
+} // namespace testing
+
+#endif // COMP6771_TEST_COUNTING_DEFAULT_RESOURCE_HPP
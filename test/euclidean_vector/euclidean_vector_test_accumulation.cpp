@@ -0,0 +1,192 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "kernel_guard.hpp"
+
+#include <bit>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	namespace kernels = comp6771::kernels;
+	using kernels::accumulation;
+	using kernels::simd_level;
+
+	constexpr auto policies = {accumulation::naive,
+	                           accumulation::compensated,
+	                           accumulation::pairwise,
+	                           accumulation::scaled};
+
+	auto random_magnitudes(std::size_t size, std::uint32_t seed, double low, double high)
+	   -> std::vector<double> {
+		auto engine = std::mt19937_64(seed);
+		auto distribution = std::uniform_real_distribution<double>(low, high);
+		auto magnitudes = std::vector<double>(size);
+		for (auto& magnitude : magnitudes) {
+			magnitude = distribution(engine);
+		}
+		return magnitudes;
+	}
+
+	auto bits(double x) -> std::uint64_t {
+		return std::bit_cast<std::uint64_t>(x);
+	}
+
+	auto ulp_distance(double a, double b) -> std::int64_t {
+		return std::abs(std::bit_cast<std::int64_t>(a) - std::bit_cast<std::int64_t>(b));
+	}
+
+	// Products that cancel exactly, interleaved so that partners land in different lanes, and one
+	// small term that the cancellation hides: the exact dot product is `hidden`.
+	struct ill_conditioned {
+		std::vector<double> x;
+		std::vector<double> y;
+		double hidden;
+	};
+
+	auto make_ill_conditioned(std::size_t pairs) -> ill_conditioned {
+		auto const a = random_magnitudes(pairs, 1, 1.0, 1e3);
+		auto const b = random_magnitudes(pairs, 2, 1.0, 1e3);
+		auto result = ill_conditioned{{}, {}, 1e-3};
+		for (auto i = std::size_t{0}; i < pairs; ++i) {
+			result.x.push_back(a[i]);
+			result.y.push_back(b[i]);
+		}
+		result.x.push_back(result.hidden);
+		result.y.push_back(1.0);
+		for (auto i = std::size_t{0}; i < pairs; ++i) {
+			result.x.push_back(-a[i]);
+			result.y.push_back(b[i]);
+		}
+		return result;
+	}
+} // namespace
+
+TEST_CASE("Accurate accumulation policies") {
+	auto const guard = testing::kernel_guard();
+
+	SECTION("Compensated sums recover what cancellation hides") {
+		auto const data = make_ill_conditioned(1001);
+		auto const n = data.x.size();
+		auto const naive = kernels::dot(data.x.data(), data.y.data(), n, accumulation::naive);
+		for (auto const policy : {accumulation::compensated, accumulation::scaled}) {
+			auto const accurate = kernels::dot(data.x.data(), data.y.data(), n, policy);
+			CHECK(accurate == Approx(data.hidden).epsilon(1e-12));
+			CHECK(std::abs(accurate - data.hidden) < std::abs(naive - data.hidden));
+		}
+		auto const x = std::vector<double>{1e16, 1.0, -1e16};
+		auto const ones = std::vector<double>{1.0, 1.0, 1.0};
+		CHECK(kernels::dot(x.data(), ones.data(), 3, accumulation::naive) == 0.0);
+		CHECK(kernels::dot(x.data(), ones.data(), 3, accumulation::compensated) == 1.0);
+	}
+
+	SECTION("Pairwise sums grow their error with the logarithm of the size") {
+		// 0.1 * 2^20 is exact, so the error is the summation's alone
+		constexpr auto size = std::size_t{1} << 20;
+		auto const tenths = std::vector<double>(size, 0.1);
+		auto const ones = std::vector<double>(size, 1.0);
+		auto const exact = 0.1 * static_cast<double>(size);
+		auto const error = [&](accumulation const policy) {
+			return ulp_distance(kernels::dot(tenths.data(), ones.data(), size, policy), exact);
+		};
+		CHECK(error(accumulation::pairwise) < error(accumulation::naive));
+		CHECK(error(accumulation::pairwise) <= 16);
+		CHECK(error(accumulation::compensated) == 0);
+	}
+
+	SECTION("Scaled norms neither overflow nor underflow") {
+		auto const huge = std::vector<double>{3e200, 4e200};
+		CHECK(std::isinf(kernels::norm(huge.data(), 2, accumulation::compensated)));
+		CHECK(kernels::norm(huge.data(), 2, accumulation::scaled) == Approx(5e200));
+		auto const tiny = std::vector<double>{3e-200, 4e-200};
+		CHECK(kernels::norm(tiny.data(), 2, accumulation::naive) == 0.0);
+		CHECK(kernels::norm(tiny.data(), 2, accumulation::scaled) == Approx(5e-200));
+		auto const mixed = std::vector<double>{1e300, 1.0, 1e-300};
+		CHECK(kernels::norm(mixed.data(), 3, accumulation::scaled) == 1e300);
+
+		auto const infinity = std::numeric_limits<double>::infinity();
+		auto const with_infinity = std::vector<double>{infinity, 1.0};
+		CHECK(kernels::norm(with_infinity.data(), 2, accumulation::scaled) == infinity);
+		auto const with_nan = std::vector<double>{std::numeric_limits<double>::quiet_NaN(), 1e300};
+		CHECK(std::isnan(kernels::norm(with_nan.data(), 2, accumulation::scaled)));
+	}
+
+	SECTION("Scaled dot products survive products that overflow") {
+		auto const x = std::vector<double>{1e300, -1e300, 1.0};
+		auto const y = std::vector<double>{1e10, 1e10, 1.0};
+		CHECK(std::isnan(kernels::dot(x.data(), y.data(), 3, accumulation::compensated)));
+		CHECK(kernels::dot(x.data(), y.data(), 3, accumulation::scaled) == 1.0);
+		auto const zero = std::vector<double>(3);
+		CHECK(kernels::dot(x.data(), zero.data(), 3, accumulation::scaled) == 0.0);
+		// products that cancel exactly are not scaled
+		auto const orthogonal = std::vector<double>{1e10, -1e10, 0.0};
+		CHECK(kernels::dot(y.data(), orthogonal.data(), 3, accumulation::scaled) == 0.0);
+	}
+
+	SECTION("Every policy is identical at every SIMD level") {
+		for (auto const size : {1, 15, 16, 17, 100, 1000, 4099}) {
+			auto const n = static_cast<std::size_t>(size);
+			auto const x = random_magnitudes(n, 3, -1.0, 1.0);
+			auto const y = random_magnitudes(n, 4, -1.0, 1.0);
+			for (auto const policy : policies) {
+				kernels::set_simd_level(simd_level::scalar);
+				auto const dot = kernels::dot(x.data(), y.data(), n, policy);
+				auto const norm = kernels::norm(x.data(), n, policy);
+				for (auto const level : testing::simd_levels()) {
+					kernels::set_simd_level(level);
+					CHECK(bits(kernels::dot(x.data(), y.data(), n, policy)) == bits(dot));
+					CHECK(bits(kernels::norm(x.data(), n, policy)) == bits(norm));
+				}
+			}
+		}
+	}
+
+	SECTION("Compensated sums barely depend on chunking") {
+		constexpr auto size = 10 * kernels::parallel_chunk_size + 123;
+		auto const x = random_magnitudes(size, 5, -1.0, 1.0);
+		auto const y = random_magnitudes(size, 6, -1.0, 1.0);
+		auto const serial = kernels::dot(x.data(), y.data(), size, accumulation::compensated);
+		auto const pairwise = kernels::dot(x.data(), y.data(), size, accumulation::pairwise);
+		kernels::enable_parallel_execution(4, 1);
+		CHECK(ulp_distance(kernels::dot(x.data(), y.data(), size, accumulation::compensated), serial)
+		      <= 1);
+		CHECK(bits(kernels::dot(x.data(), y.data(), size, accumulation::pairwise)) == bits(pairwise));
+	}
+}
+
+TEST_CASE("Accumulation policies on vectors and views") {
+	auto const magnitudes = random_magnitudes(100, 7, -1.0, 1.0);
+	auto const others = random_magnitudes(100, 8, -1.0, 1.0);
+	auto const v = comp6771::euclidean_vector(magnitudes.cbegin(), magnitudes.cend());
+	auto const w = comp6771::euclidean_vector(others.cbegin(), others.cend());
+
+	CHECK(bits(comp6771::euclidean_norm(v, accumulation::naive))
+	      == bits(comp6771::euclidean_norm(v)));
+	CHECK(bits(comp6771::dot(v, w, accumulation::naive)) == bits(comp6771::dot(v, w)));
+
+	auto interleaved = std::vector<double>();
+	for (auto const magnitude : magnitudes) {
+		interleaved.push_back(magnitude);
+		interleaved.push_back(0.0);
+	}
+	auto const strided = comp6771::euclidean_vector_view(interleaved.data(), 100, 2);
+	for (auto const policy : policies) {
+		auto const norm = comp6771::euclidean_norm(v, policy);
+		CHECK(norm == Approx(comp6771::euclidean_norm(v)));
+		CHECK(bits(comp6771::euclidean_norm(strided, policy)) == bits(norm));
+		CHECK(bits(comp6771::dot(strided, comp6771::euclidean_vector_view(w), policy))
+		      == bits(comp6771::dot(v, w, policy)));
+	}
+
+	CHECK_THROWS_AS(comp6771::euclidean_norm(comp6771::euclidean_vector(0), accumulation::scaled),
+	                std::logic_error);
+	CHECK_THROWS_AS(comp6771::dot(v, comp6771::euclidean_vector(3), accumulation::compensated),
+	                std::logic_error);
+}
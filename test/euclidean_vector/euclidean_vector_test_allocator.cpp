@@ -0,0 +1,132 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+
+namespace {
+	// Forwards to the default resource and records what passes through it.
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		[[nodiscard]] auto allocations() const noexcept -> int {
+			return allocations_;
+		}
+
+		[[nodiscard]] auto live_allocations() const noexcept -> int {
+			return allocations_ - deallocations_;
+		}
+
+	private:
+		std::pmr::memory_resource* upstream_ = std::pmr::new_delete_resource();
+		int allocations_ = 0;
+		int deallocations_ = 0;
+
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			++allocations_;
+			return upstream_->allocate(bytes, alignment);
+		}
+
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			++deallocations_;
+			upstream_->deallocate(p, bytes, alignment);
+		}
+
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override {
+			return this == &other;
+		}
+	};
+
+	auto is_aligned(double const* p, std::size_t alignment) -> bool {
+		return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+	}
+} // namespace
+
+TEST_CASE("Memory resources") {
+	constexpr auto large = comp6771::euclidean_vector::inline_capacity + 4;
+	auto resource = counting_resource();
+	auto const allocator = comp6771::euclidean_vector::allocator_type(&resource);
+
+	SECTION("Magnitudes come from the given resource, aligned to 64 bytes") {
+		{
+			auto const v = comp6771::euclidean_vector(large, 1.5, allocator);
+			CHECK(resource.allocations() == 1);
+			CHECK(v.get_allocator() == allocator);
+			CHECK(is_aligned(v.data(), 64));
+			CHECK(v == comp6771::euclidean_vector(large, 1.5));
+		}
+		CHECK(resource.live_allocations() == 0);
+	}
+
+	SECTION("Inline vectors do not touch the resource") {
+		auto const v = comp6771::euclidean_vector(2, allocator);
+		CHECK(resource.allocations() == 0);
+		CHECK(v.get_allocator() == allocator);
+	}
+
+	SECTION("Copies use the default resource unless one is given") {
+		auto const v = comp6771::euclidean_vector(large, 2.0, allocator);
+		auto const copy = v;
+		CHECK(copy.get_allocator() == comp6771::euclidean_vector::allocator_type());
+		auto const arena_copy = comp6771::euclidean_vector(copy, allocator);
+		CHECK(arena_copy.get_allocator() == allocator);
+		CHECK(arena_copy == v);
+		CHECK(resource.allocations() == 2);
+	}
+
+	SECTION("Assignment keeps the destination's resource") {
+		auto v = comp6771::euclidean_vector(large, allocator);
+		auto const heap = comp6771::euclidean_vector(large, 3.0);
+		v = heap;
+		CHECK(v.get_allocator() == allocator);
+		CHECK(v == heap);
+		CHECK(resource.allocations() == 1);
+
+		v = comp6771::euclidean_vector(large + 1, 4.0);
+		CHECK(v.get_allocator() == allocator);
+		CHECK(v == comp6771::euclidean_vector(large + 1, 4.0));
+		CHECK(resource.allocations() == 2);
+
+		auto w = comp6771::euclidean_vector(large, 5.0);
+		w = comp6771::euclidean_vector(large, 6.0, allocator);
+		CHECK(w.get_allocator() == comp6771::euclidean_vector::allocator_type());
+		CHECK(w == comp6771::euclidean_vector(large, 6.0));
+	}
+
+	SECTION("Moves between vectors sharing a resource steal the storage") {
+		auto v = comp6771::euclidean_vector(large, 1.0, allocator);
+		auto const* const magnitudes = v.data();
+		auto moved = std::move(v);
+		CHECK(moved.data() == magnitudes);
+		CHECK(moved.get_allocator() == allocator);
+
+		auto target = comp6771::euclidean_vector(large, allocator);
+		target = std::move(moved);
+		CHECK(target.data() == magnitudes);
+		CHECK(resource.allocations() == 2);
+	}
+
+	SECTION("Expressions evaluate into the destination's storage") {
+		auto v = comp6771::euclidean_vector(large, allocator);
+		auto const a = comp6771::euclidean_vector(large, 1.0);
+		v = a + a;
+		v = a * 3.0;
+		CHECK(v == comp6771::euclidean_vector(large, 3.0));
+		CHECK(resource.allocations() == 1);
+	}
+
+	SECTION("A monotonic arena is released in one go") {
+		auto buffer = std::array<std::byte, 4096>{};
+		auto arena = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size(), &resource);
+		auto const arena_allocator = comp6771::euclidean_vector::allocator_type(&arena);
+		for (auto i = 0; i < 8; ++i) {
+			auto const v = comp6771::euclidean_vector(large, 1.0, arena_allocator);
+			CHECK(comp6771::dot(v, v) == large);
+		}
+		arena.release();
+		CHECK(resource.allocations() == 0);
+	}
+}
@@ -0,0 +1,128 @@
+#include "comp6771/euclidean_vector_batch.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	using comp6771::batch_layout;
+
+	// seven vectors with 19 dimensions: enough for both layouts to need padding and SIMD tails
+	auto make_vectors() -> std::vector<comp6771::euclidean_vector> {
+		auto vectors = std::vector<comp6771::euclidean_vector>();
+		for (auto i = 0; i < 7; ++i) {
+			auto v = comp6771::euclidean_vector(19);
+			for (auto j = 0; j < v.dimensions(); ++j) {
+				v[j] = (i + 1) * 0.25 - j * 0.125;
+			}
+			vectors.push_back(v);
+		}
+		return vectors;
+	}
+
+	auto is_aligned(double const* p) -> bool {
+		return reinterpret_cast<std::uintptr_t>(p) % 64 == 0;
+	}
+} // namespace
+
+TEST_CASE("euclidean_vector_batch") {
+	auto const vectors = make_vectors();
+	auto const query = comp6771::euclidean_vector(vectors[2] * 0.5);
+	auto const n = vectors.size();
+
+	for (auto const layout : {batch_layout::row_major, batch_layout::column_major}) {
+		auto const batch = comp6771::euclidean_vector_batch(vectors, layout);
+		INFO("column major: " << (layout == batch_layout::column_major));
+
+		SECTION("Rows are views of the stored vectors") {
+			REQUIRE(batch.size() == 7);
+			REQUIRE(batch.dimensions() == 19);
+			CHECK(batch.layout() == layout);
+			CHECK(is_aligned(batch.data()));
+			CHECK(batch.leading_dimension() % 8 == 0);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				auto const row = static_cast<comp6771::euclidean_vector>(batch[static_cast<int>(i)]);
+				CHECK(row == vectors[i]);
+			}
+			CHECK(batch(3, 4) == vectors[3][4]);
+			CHECK_THROWS_AS(batch.at(7), std::out_of_range);
+			CHECK(batch.to_layout(batch_layout::row_major)(5, 18) == vectors[5][18]);
+		}
+
+		SECTION("Batch operations agree with the single-vector functions") {
+			auto const products = comp6771::dot(batch, query);
+			auto const norms = comp6771::euclidean_norm(batch);
+			auto const distances = comp6771::distance(batch, query);
+			auto const units = comp6771::unit(batch);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				auto const row = static_cast<int>(i);
+				CHECK(products[i] == Approx(comp6771::dot(vectors[i], query)));
+				CHECK(norms[i] == Approx(comp6771::euclidean_norm(vectors[i])));
+				CHECK(distances[i] == Approx(comp6771::euclidean_norm(vectors[i] - query)));
+				auto const expected = comp6771::unit(vectors[i]);
+				for (auto j = 0; j < 19; ++j) {
+					CHECK(units(row, j) == Approx(expected[j]));
+				}
+			}
+		}
+
+		SECTION("Pairwise distances cover every combination of layouts") {
+			for (auto const other : {batch_layout::row_major, batch_layout::column_major}) {
+				auto const queries = comp6771::euclidean_vector_batch(vectors, other);
+				auto const distances = comp6771::pairwise_distance(batch, queries);
+				REQUIRE(distances.size() == n * n);
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					for (auto j = std::size_t{0}; j < n; ++j) {
+						CHECK(distances[i * n + j]
+						      == Approx(comp6771::euclidean_norm(vectors[i] - vectors[j])).margin(1e-12));
+					}
+				}
+			}
+		}
+
+		SECTION("axpy updates every row") {
+			auto y = comp6771::euclidean_vector_batch(vectors, batch_layout::row_major);
+			comp6771::axpy(2.0, batch, y);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				auto const expected = comp6771::euclidean_vector(vectors[i] * 3.0);
+				CHECK(static_cast<comp6771::euclidean_vector>(y[static_cast<int>(i)]) == expected);
+			}
+		}
+	}
+
+	SECTION("Row-major results are identical to the single-vector functions") {
+		auto const batch = comp6771::euclidean_vector_batch(vectors);
+		auto const products = comp6771::dot(batch, query);
+		auto const norms = comp6771::euclidean_norm(batch);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			CHECK(products[i] == comp6771::dot(vectors[i], query));
+			CHECK(norms[i] == comp6771::euclidean_norm(vectors[i]));
+		}
+	}
+
+	SECTION("Mismatched operands are rejected") {
+		auto batch = comp6771::euclidean_vector_batch(2, 3);
+		CHECK_THROWS_AS(comp6771::dot(batch, comp6771::euclidean_vector(4)), std::logic_error);
+		CHECK_THROWS_AS(batch.assign(0, comp6771::euclidean_vector(2)), std::logic_error);
+		CHECK_THROWS_AS(comp6771::unit(batch), std::logic_error);
+		auto y = comp6771::euclidean_vector_batch(3, 3);
+		CHECK_THROWS_AS(comp6771::axpy(1.0, batch, y), std::logic_error);
+	}
+
+	SECTION("Copies and moves") {
+		auto const batch = comp6771::euclidean_vector_batch(vectors, batch_layout::column_major);
+		auto copy = batch;
+		CHECK(copy(6, 18) == batch(6, 18));
+		auto const* const magnitudes = copy.data();
+		auto moved = std::move(copy);
+		CHECK(moved.data() == magnitudes);
+		CHECK(copy.size() == 0); // NOLINT(bugprone-use-after-move)
+		auto assigned = comp6771::euclidean_vector_batch(1, 1);
+		assigned = batch;
+		CHECK(assigned.size() == 7);
+		CHECK(assigned.layout() == batch_layout::column_major);
+		CHECK(assigned(2, 9) == batch(2, 9));
+	}
+}
@@ -0,0 +1,115 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+	auto statistics() -> comp6771::norm_cache_statistics {
+		return comp6771::euclidean_vector::cache_statistics();
+	}
+
+	// the norm computed from scratch, ignoring any cache
+	auto fresh_norm(comp6771::euclidean_vector const& v) -> double {
+		return comp6771::euclidean_norm(comp6771::euclidean_vector_view(v));
+	}
+} // namespace
+
+TEST_CASE("Norm cache") {
+	comp6771::euclidean_vector::reset_cache_statistics();
+	auto v = comp6771::euclidean_vector(37, 0.5);
+	v[3] = 3.0;
+
+	SECTION("Repeated norms are computed once") {
+		auto const norm = comp6771::euclidean_norm(v);
+		CHECK(comp6771::euclidean_norm(v) == norm);
+		CHECK(comp6771::euclidean_norm(v) == norm);
+		CHECK(statistics().misses == 1);
+		CHECK(statistics().hits == 2);
+	}
+
+	SECTION("Scaling by a power of two rescales the cached norm") {
+		auto const norm = comp6771::euclidean_norm(v);
+		v *= 4.0;
+		CHECK(comp6771::euclidean_norm(v) == 4.0 * norm);
+		v /= -8.0;
+		CHECK(comp6771::euclidean_norm(v) == fresh_norm(v));
+		CHECK(statistics().updates == 2);
+		CHECK(statistics().misses == 1);
+	}
+
+	SECTION("Other scaling discards the cached norm") {
+		static_cast<void>(comp6771::euclidean_norm(v));
+		v *= 3.0;
+		CHECK(comp6771::euclidean_norm(v) == fresh_norm(v));
+		v /= 0.1;
+		CHECK(comp6771::euclidean_norm(v) == fresh_norm(v));
+		CHECK(statistics().updates == 0);
+	}
+
+	SECTION("Rescaling a tiny norm discards it") {
+		auto w = comp6771::euclidean_vector{1.0, 0x1p-500};
+		static_cast<void>(comp6771::euclidean_norm(w));
+		w /= 0x1p400;
+		CHECK(comp6771::euclidean_norm(w) == fresh_norm(w));
+		CHECK(statistics().updates == 1);
+		w /= 0x1p100;
+		CHECK(comp6771::euclidean_norm(w) == fresh_norm(w));
+		CHECK(statistics().updates == 1);
+	}
+
+	SECTION("Scaling by zero leaves a zero norm") {
+		static_cast<void>(comp6771::euclidean_norm(v));
+		v *= 0.0;
+		CHECK(comp6771::euclidean_norm(v) == 0.0);
+	}
+
+	SECTION("A norm does not depend on how the magnitudes were reached") {
+		static_cast<void>(comp6771::euclidean_norm(v));
+		v *= 0.1;
+		static_cast<void>(comp6771::euclidean_norm(v));
+		v /= 0.25;
+		v *= -2.0;
+		auto const view = comp6771::euclidean_vector_view(v);
+		CHECK(comp6771::euclidean_norm(v) == comp6771::euclidean_norm(view));
+		CHECK(comp6771::unit(v) == comp6771::unit(view));
+	}
+
+	SECTION("Writes discard the cached norm") {
+		static_cast<void>(comp6771::euclidean_norm(v));
+		v[0] = 10.0;
+		CHECK(comp6771::euclidean_norm(v) == fresh_norm(v));
+		v += comp6771::euclidean_vector(37, 1.0);
+		CHECK(comp6771::euclidean_norm(v) == fresh_norm(v));
+		CHECK(statistics().updates == 0);
+	}
+
+	SECTION("Copies keep the cached norm") {
+		auto const norm = comp6771::euclidean_norm(v);
+		auto const copy = v;
+		CHECK(comp6771::euclidean_norm(copy) == norm);
+		CHECK(statistics().misses == 1);
+	}
+
+	SECTION("Several threads may read the norm of a shared vector") {
+		auto const shared = v;
+		auto const expected = fresh_norm(shared);
+		auto norms = std::vector<double>(4);
+		auto threads = std::vector<std::jthread>();
+		for (auto& norm : norms) {
+			threads.emplace_back([&shared, &norm] {
+				for (auto i = 0; i < 1000; ++i) {
+					norm = comp6771::euclidean_norm(shared);
+				}
+			});
+		}
+		threads.clear();
+		for (auto const norm : norms) {
+			CHECK(norm == expected);
+		}
+		// exited threads' counts are kept
+		CHECK(statistics().hits + statistics().misses >= 4000);
+	}
+}
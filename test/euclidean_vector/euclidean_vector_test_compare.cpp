@@ -0,0 +1,168 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "kernel_guard.hpp"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+	namespace kernels = comp6771::kernels;
+
+	auto iota_vector(int dimensions) -> comp6771::euclidean_vector {
+		return comp6771::euclidean_vector(dimensions, [](int i) { return 1.0 + i; });
+	}
+
+	constexpr auto not_a_number = std::numeric_limits<double>::quiet_NaN();
+	constexpr auto infinity = std::numeric_limits<double>::infinity();
+} // namespace
+
+TEST_CASE("Exact comparison finds a difference anywhere, at every SIMD level") {
+	auto const guard = testing::kernel_guard();
+	for (auto const level : testing::simd_levels()) {
+		kernels::set_simd_level(level);
+		for (auto const size : {0, 1, 15, 16, 17, 33, 100}) {
+			auto const v = iota_vector(size);
+			CHECK(v == iota_vector(size));
+			CHECK_FALSE(v != iota_vector(size));
+			for (auto i = 0; i < size; ++i) {
+				auto w = iota_vector(size);
+				w[i] = -w[i];
+				CHECK(v != w);
+				CHECK_FALSE(v == w);
+			}
+		}
+	}
+}
+
+TEST_CASE("Exact comparison follows IEEE equality") {
+	auto const zero = comp6771::euclidean_vector{0.0, 1.0};
+	auto const negative_zero = comp6771::euclidean_vector{-0.0, 1.0};
+	CHECK(zero == negative_zero);
+	auto const with_nan = comp6771::euclidean_vector{not_a_number, 1.0};
+	CHECK(with_nan != with_nan);
+	CHECK(comp6771::euclidean_vector{infinity} == comp6771::euclidean_vector{infinity});
+	CHECK(comp6771::euclidean_vector(3) != comp6771::euclidean_vector(4));
+
+	auto const magnitudes = std::vector<double>{1.0, 2.0, 3.0, 4.0};
+	auto const view = comp6771::euclidean_vector_view(magnitudes);
+	CHECK(view == comp6771::euclidean_vector_view(comp6771::euclidean_vector(view)));
+	CHECK(comp6771::euclidean_vector_view(magnitudes.data(), 2, 2)
+	      == comp6771::euclidean_vector_view(std::vector<double>{1.0, 3.0}));
+}
+
+TEST_CASE("approx_equal") {
+	auto const guard = testing::kernel_guard();
+	auto const v = iota_vector(40);
+	for (auto const level : testing::simd_levels()) {
+		kernels::set_simd_level(level);
+		auto w = iota_vector(40);
+		CHECK(comp6771::approx_equal(v, w));
+		w[37] *= 1 + 1e-10;
+		CHECK(comp6771::approx_equal(v, w));
+		CHECK_FALSE(comp6771::approx_equal(v, w, 0.0, 0.0));
+		w[37] *= 1 + 1e-6;
+		CHECK_FALSE(comp6771::approx_equal(v, w));
+		CHECK(comp6771::approx_equal(v, w, 0.0, 1e-5));
+		CHECK(comp6771::approx_equal(v, w, 1e-3));
+
+		// the relative tolerance scales with the larger magnitude, so it is symmetric
+		auto const x = comp6771::euclidean_vector{100.0};
+		auto const y = comp6771::euclidean_vector{90.0};
+		CHECK(comp6771::approx_equal(x, y, 0.0, 0.1));
+		CHECK(comp6771::approx_equal(y, x, 0.0, 0.1));
+
+		// only 0 is close to 0 without an absolute tolerance
+		CHECK_FALSE(comp6771::approx_equal(comp6771::euclidean_vector{1e-300},
+		                                   comp6771::euclidean_vector{0.0}));
+		CHECK(comp6771::approx_equal(comp6771::euclidean_vector{1e-300},
+		                             comp6771::euclidean_vector{0.0},
+		                             1e-12));
+
+		auto u = iota_vector(20);
+		u[18] = infinity;
+		CHECK(comp6771::approx_equal(u, u, 0.0, 0.5));
+		auto t = u;
+		t[18] = 1e300;
+		CHECK_FALSE(comp6771::approx_equal(u, t, 0.0, 0.5));
+		t[18] = -infinity;
+		CHECK_FALSE(comp6771::approx_equal(u, t, infinity, 0.5));
+		t[18] = not_a_number;
+		CHECK_FALSE(comp6771::approx_equal(t, t, 1.0, 1.0));
+	}
+	CHECK_FALSE(
+	   comp6771::approx_equal(comp6771::euclidean_vector(3), comp6771::euclidean_vector(4)));
+}
+
+TEST_CASE("ULP distance") {
+	auto const one = comp6771::euclidean_vector{1.0, 5.0};
+	auto next = one;
+	next[0] = std::nextafter(std::nextafter(1.0, 2.0), 2.0);
+	CHECK(comp6771::ulp_distance(one, one) == 0);
+	CHECK(comp6771::ulp_distance(one, next) == 2);
+	CHECK(comp6771::ulp_distance(next, one) == 2);
+	CHECK(comp6771::ulp_equal(one, next, 2));
+	CHECK_FALSE(comp6771::ulp_equal(one, next, 1));
+
+	auto const smallest = std::numeric_limits<double>::denorm_min();
+	CHECK(comp6771::ulp_distance(comp6771::euclidean_vector{0.0}, comp6771::euclidean_vector{-0.0})
+	      == 0);
+	CHECK(comp6771::ulp_distance(comp6771::euclidean_vector{smallest},
+	                             comp6771::euclidean_vector{-smallest})
+	      == 2);
+	CHECK(comp6771::ulp_distance(comp6771::euclidean_vector{-infinity},
+	                             comp6771::euclidean_vector{infinity})
+	      == 2 * std::uint64_t{0x7ff0'0000'0000'0000});
+	auto const nan_vector = comp6771::euclidean_vector{not_a_number};
+	CHECK(comp6771::ulp_distance(nan_vector, nan_vector)
+	      == std::numeric_limits<std::uint64_t>::max());
+
+	CHECK_THROWS_AS(comp6771::ulp_distance(one, comp6771::euclidean_vector(3)), std::logic_error);
+	CHECK_FALSE(comp6771::ulp_equal(one, comp6771::euclidean_vector(3), 100));
+}
+
+TEST_CASE("Hashing") {
+	SECTION("The hash is XXH64") {
+		CHECK(kernels::hash(nullptr, 0, 0) == 0xef46'db37'51d8'e999);
+	}
+
+	SECTION("Equal vectors hash equally") {
+		auto const v = iota_vector(37);
+		auto buffer = std::array<std::byte, 4096>();
+		auto arena = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size());
+		auto const in_arena = comp6771::euclidean_vector(v, &arena);
+		CHECK(comp6771::hash_value(v) == comp6771::hash_value(in_arena));
+		CHECK(std::hash<comp6771::euclidean_vector>()(v) == comp6771::hash_value(v));
+		auto const zeroes = comp6771::euclidean_vector{0.0, -0.0};
+		auto const negative_zeroes = comp6771::euclidean_vector{-0.0, 0.0};
+		CHECK(comp6771::hash_value(zeroes) == comp6771::hash_value(negative_zeroes));
+	}
+
+	SECTION("Different vectors almost always hash differently") {
+		auto const v = iota_vector(37);
+		CHECK(comp6771::hash_value(v) != comp6771::hash_value(v, 1));
+		CHECK(comp6771::hash_value(comp6771::euclidean_vector(3))
+		      != comp6771::hash_value(comp6771::euclidean_vector(4)));
+		for (auto i = 0; i < v.dimensions(); ++i) {
+			auto w = v;
+			w[i] = std::nextafter(w[i], 0.0);
+			CHECK(comp6771::hash_value(v) != comp6771::hash_value(w));
+		}
+	}
+
+	SECTION("Deduplicating in a hash table") {
+		auto unique = std::unordered_set<comp6771::euclidean_vector>();
+		for (auto i = 0; i < 1000; ++i) {
+			unique.insert(comp6771::euclidean_vector(i % 5 + 1, static_cast<double>(i % 7)));
+		}
+		CHECK(unique.size() == 35);
+	}
+}
@@ -1,11 +1,20 @@
 #include "comp6771/euclidean_vector.hpp"
 
+#include <array>
 #include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <list>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <vector>
 
 TEST_CASE("Testing constructors") {
 	SECTION("Testing default constructor and << operator overload") {
@@ -58,3 +67,55 @@ TEST_CASE("Testing constructors") {
 		REQUIRE(fmt::format("{}", t3) == "[4.2 4.2 4.2 4.2]");
 	}
 }
+
+TEST_CASE("Constructors that write each magnitude once") {
+	SECTION("Uninitialised vectors") {
+		auto v = comp6771::euclidean_vector(comp6771::uninitialized, 100);
+		CHECK(v.dimensions() == 100);
+		for (auto i = 0; i < v.dimensions(); ++i) {
+			v[i] = i;
+		}
+		CHECK(v.at(99) == 99.0);
+		CHECK(comp6771::euclidean_vector(comp6771::uninitialized, 3).dimensions() == 3);
+		CHECK(comp6771::euclidean_vector(comp6771::uninitialized, 0).dimensions() == 0);
+
+		auto buffer = std::array<std::byte, 4096>();
+		auto arena = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size());
+		auto const in_arena = comp6771::euclidean_vector(comp6771::uninitialized, 100, &arena);
+		CHECK(in_arena.get_allocator().resource() == &arena);
+	}
+
+	SECTION("Generators") {
+		auto const squares = comp6771::euclidean_vector(5, [](int i) { return i * i; });
+		CHECK(fmt::format("{}", squares) == "[0 1 4 9 16]");
+
+		auto next = 0.5;
+		auto const doubling = comp6771::euclidean_vector(4, [&next] { return next *= 2; });
+		CHECK(fmt::format("{}", doubling) == "[1 2 4 8]");
+
+		auto const empty = comp6771::euclidean_vector(0, [](int) -> double { throw 0; });
+		CHECK(empty.dimensions() == 0);
+	}
+
+	SECTION("Ranges") {
+		auto const magnitudes = std::vector<double>{4.2, 6.9, 1.3, 0.5, 7.0};
+		CHECK(comp6771::euclidean_vector(magnitudes)
+		      == comp6771::euclidean_vector(magnitudes.cbegin(), magnitudes.cend()));
+		auto const from_span = comp6771::euclidean_vector(std::span(magnitudes).first(2));
+		CHECK(fmt::format("{}", from_span) == "[4.2 6.9]");
+
+		auto const floats = std::list<float>{1.5F, 2.5F, 3.5F};
+		CHECK(fmt::format("{}", comp6771::euclidean_vector(floats)) == "[1.5 2.5 3.5]");
+
+		auto const halves = comp6771::euclidean_vector(
+		   std::views::iota(0, 6) | std::views::transform([](int i) { return i / 2.0; }));
+		CHECK(fmt::format("{}", halves) == "[0 0.5 1 1.5 2 2.5]");
+
+		// an input range, whose size is only known once it has been read
+		auto stream = std::istringstream("1 2 3 4 5 6 7");
+		auto const streamed = comp6771::euclidean_vector(std::views::istream<int>(stream));
+		CHECK(fmt::format("{}", streamed) == "[1 2 3 4 5 6 7]");
+
+		CHECK(comp6771::euclidean_vector(std::vector<std::int8_t>()).dimensions() == 0);
+	}
+}
@@ -0,0 +1,70 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <stdexcept>
+#include <type_traits>
+
+TEST_CASE("Lazy arithmetic expressions") {
+	SECTION("Chained expressions evaluate element-wise") {
+		auto const a = comp6771::euclidean_vector{1, 2, 3};
+		auto const b = comp6771::euclidean_vector{4, 5, 6};
+		auto const c = comp6771::euclidean_vector{0.5, 1, 1.5};
+		auto const result = comp6771::euclidean_vector(a + b - c * 2.0);
+		CHECK(result == comp6771::euclidean_vector{4, 5, 6});
+
+		auto const scaled = comp6771::euclidean_vector(2.0 * (a + b) / 4.0);
+		CHECK(scaled == comp6771::euclidean_vector{2.5, 3.5, 4.5});
+	}
+
+	SECTION("Expressions are not evaluated until materialised") {
+		auto const a = comp6771::euclidean_vector{1, 2};
+		auto const b = comp6771::euclidean_vector{3, 4};
+		auto const expression = a + b;
+		STATIC_REQUIRE(not std::is_same_v<std::remove_cvref_t<decltype(expression)>,
+		                                  comp6771::euclidean_vector>);
+		CHECK(expression.dimensions() == 2);
+		CHECK(expression[1] == 6);
+		CHECK(comp6771::dot(expression, a) == 16);
+	}
+
+	SECTION("Mismatched dimensions throw when the expression is built") {
+		auto const a = comp6771::euclidean_vector(2);
+		auto const b = comp6771::euclidean_vector(3);
+		auto const c = comp6771::euclidean_vector(3);
+		REQUIRE_THROWS_WITH(a + (b - c), "Dimensions of LHS(2) and RHS(3) do not match");
+		REQUIRE_THROWS_AS((b * 2.0) - a, std::logic_error);
+		REQUIRE_THROWS_WITH((a + a) / 0, "Invalid vector division by 0");
+	}
+
+	SECTION("Assignment may refer to the destination") {
+		auto acc = comp6771::euclidean_vector{1, 1, 1};
+		auto const x = comp6771::euclidean_vector{1, 2, 3};
+		acc = acc + x * 2.0;
+		CHECK(acc == comp6771::euclidean_vector{3, 5, 7});
+		acc = x - acc;
+		CHECK(acc == comp6771::euclidean_vector{-2, -3, -4});
+	}
+
+	SECTION("Assignment of a different dimension replaces the storage") {
+		auto v = comp6771::euclidean_vector(1, 9.0);
+		auto const a = comp6771::euclidean_vector{1, 2, 3, 4};
+		v = a + a;
+		CHECK(v.dimensions() == 4);
+		CHECK(v == comp6771::euclidean_vector{2, 4, 6, 8});
+	}
+
+	SECTION("Temporaries are owned by the expression") {
+		auto const a = comp6771::euclidean_vector{1, 2};
+		auto const expression = a + comp6771::euclidean_vector{10, 20};
+		CHECK(fmt::format("{}", expression) == "[11 22]");
+	}
+
+	SECTION("Assignment invalidates the cached norm") {
+		auto v = comp6771::euclidean_vector{3, 4};
+		CHECK(comp6771::euclidean_norm(v) == 5);
+		v = v * 2.0;
+		CHECK(comp6771::euclidean_norm(v) == 10);
+	}
+}
@@ -0,0 +1,279 @@
+#include "comp6771/euclidean_vector_file.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto sample() -> std::vector<comp6771::euclidean_vector> {
+		return {{0.1, -0.0, 1e-310},
+		        {std::numeric_limits<double>::infinity(), 1.0 / 3.0, -2.5},
+		        {std::numeric_limits<double>::max(), 0.0, 7.0}};
+	}
+
+	auto write_sample(std::ostream& out, std::size_t row_alignment = 8) -> void {
+		auto writer = comp6771::vector_file_writer(out, 3, row_alignment);
+		for (auto const& v : sample()) {
+			writer.write(v);
+		}
+		writer.finish();
+	}
+
+	// an output stream that cannot seek, like a pipe
+	class unseekable_buffer : public std::streambuf {
+	public:
+		[[nodiscard]] auto str() const -> std::string const& {
+			return bytes_;
+		}
+
+	private:
+		std::string bytes_;
+
+		auto overflow(int_type c) -> int_type override {
+			bytes_.push_back(traits_type::to_char_type(c));
+			return c;
+		}
+
+		auto xsputn(char const* s, std::streamsize n) -> std::streamsize override {
+			bytes_.append(s, static_cast<std::size_t>(n));
+			return n;
+		}
+	};
+
+	// an output stream that reports its position but cannot seek back to the header
+	class unrewindable_buffer : public unseekable_buffer {
+		auto seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode)
+		   -> pos_type override {
+			if (off != 0 or dir != std::ios_base::cur) {
+				return pos_type(off_type(-1));
+			}
+			return pos_type(static_cast<off_type>(str().size()));
+		}
+	};
+
+	// the same file written by a machine with the other byte order
+	auto swap_byte_order(std::string bytes) -> std::string {
+		auto reverse = [&bytes](std::size_t offset, std::size_t size) {
+			auto const first = bytes.begin() + static_cast<std::ptrdiff_t>(offset);
+			std::reverse(first, first + static_cast<std::ptrdiff_t>(size));
+		};
+		for (auto offset : {std::size_t{8}, std::size_t{12}, std::size_t{16}, std::size_t{20}}) {
+			reverse(offset, 4);
+		}
+		reverse(24, 8);
+		for (auto offset = comp6771::vector_file_header_size; offset < bytes.size(); offset += 8) {
+			reverse(offset, 8);
+		}
+		return bytes;
+	}
+
+	// the same file with `size` vectors recorded in its header
+	auto with_size(std::string bytes, std::uint64_t const size) -> std::string {
+		std::memcpy(bytes.data() + 24, &size, sizeof(size));
+		return bytes;
+	}
+
+	auto check_sample(comp6771::vector_file_reader& reader) -> void {
+		auto v = comp6771::euclidean_vector();
+		for (auto const& expected : sample()) {
+			REQUIRE(reader.read(v));
+			CHECK(v == expected);
+		}
+		CHECK(not reader.read(v));
+	}
+} // namespace
+
+TEST_CASE("Vector files round-trip through streams") {
+	auto file = std::stringstream();
+	write_sample(file);
+
+	SECTION("Magnitudes are stored exactly") {
+		CHECK(file.str().size() == comp6771::vector_file_header_size + 3 * 3 * sizeof(double));
+		auto reader = comp6771::vector_file_reader(file);
+		CHECK(reader.dimensions() == 3);
+		CHECK(reader.size() == std::size_t{3});
+		check_sample(reader);
+		auto copy = std::stringstream(file.str());
+		auto v = comp6771::euclidean_vector();
+		REQUIRE(comp6771::vector_file_reader(copy).read(v));
+		CHECK(std::signbit(v[1]));
+		CHECK(v[2] == 1e-310);
+	}
+
+	SECTION("Reading reuses the destination's storage") {
+		auto reader = comp6771::vector_file_reader(file);
+		auto v = comp6771::euclidean_vector(3);
+		auto const* const storage = v.data();
+		while (reader.read(v)) {
+			CHECK(v.data() == storage);
+		}
+	}
+
+	SECTION("Rows can be padded") {
+		auto padded = std::stringstream();
+		write_sample(padded, 64);
+		CHECK(padded.str().size() == comp6771::vector_file_header_size + 3 * 64);
+		auto reader = comp6771::vector_file_reader(padded);
+		check_sample(reader);
+	}
+
+	SECTION("Strided views are written and read") {
+		auto magnitudes = std::vector<double>{1.0, 9.0, 2.0, 9.0};
+		auto out = std::stringstream();
+		auto writer = comp6771::vector_file_writer(out, 2);
+		writer.write(comp6771::euclidean_vector_view(magnitudes.data(), 2, 2));
+		writer.finish();
+		auto reader = comp6771::vector_file_reader(out);
+		REQUIRE(reader.read(comp6771::euclidean_vector_ref(magnitudes.data() + 1, 2, 2)));
+		CHECK(magnitudes == std::vector<double>{1.0, 1.0, 2.0, 2.0});
+	}
+
+	SECTION("Writers left unfinished do not throw from their destructor") {
+		auto buffer = unrewindable_buffer();
+		auto out = std::ostream(&buffer);
+		out.exceptions(std::ios::badbit | std::ios::failbit);
+		{
+			auto writer = comp6771::vector_file_writer(out, 3);
+			writer.write(sample()[0]);
+		}
+		// recording the size failed, and the rows written are kept
+		CHECK(out.fail());
+		CHECK(buffer.str().size() == comp6771::vector_file_header_size + 3 * sizeof(double));
+	}
+
+	SECTION("Files from the other byte order are read") {
+		auto swapped = std::stringstream(swap_byte_order(file.str()));
+		auto reader = comp6771::vector_file_reader(swapped);
+		CHECK(reader.size() == std::size_t{3});
+		check_sample(reader);
+	}
+
+	SECTION("Invalid files are rejected") {
+		auto const bytes = file.str();
+		auto truncated = std::stringstream(bytes.substr(0, bytes.size() - 4));
+		CHECK_THROWS_AS(comp6771::vector_file_reader(truncated), std::runtime_error);
+		auto too_many = std::stringstream(with_size(bytes, std::uint64_t{1} << 31U));
+		CHECK_THROWS_AS(comp6771::vector_file_reader(too_many), std::runtime_error);
+
+		// a stream that cannot seek is read until it runs out
+		auto buffer = unseekable_buffer();
+		auto out = std::ostream(&buffer);
+		write_sample(out);
+		auto cut = std::stringstream(buffer.str().substr(0, buffer.str().size() - 4));
+		auto reader = comp6771::vector_file_reader(cut);
+		auto v = comp6771::euclidean_vector();
+		CHECK(reader.read(v));
+		CHECK(reader.read(v));
+		CHECK_THROWS_AS(reader.read(v), std::runtime_error);
+
+		auto not_a_file = std::stringstream(std::string(100, 'x'));
+		CHECK_THROWS_AS(comp6771::vector_file_reader(not_a_file), std::runtime_error);
+		auto empty = std::stringstream();
+		CHECK_THROWS_AS(comp6771::vector_file_reader(empty), std::runtime_error);
+		CHECK_THROWS_AS(comp6771::vector_file_writer(empty, 3, 12), std::logic_error);
+		CHECK_THROWS_AS(comp6771::vector_file_writer(empty, 3, 0), std::logic_error);
+
+		auto writer = comp6771::vector_file_writer(empty, 3);
+		CHECK_THROWS_AS(writer.write(comp6771::euclidean_vector(2)), std::logic_error);
+		auto wrong = std::vector<double>(2);
+		auto three = comp6771::vector_file_reader(file);
+		CHECK_THROWS_AS(three.read(comp6771::euclidean_vector_ref(wrong)), std::logic_error);
+	}
+}
+
+TEST_CASE("Vector files hold batches") {
+	auto const vectors = sample();
+
+	for (auto const layout :
+	     {comp6771::batch_layout::row_major, comp6771::batch_layout::column_major}) {
+		auto const batch = comp6771::euclidean_vector_batch(vectors, layout);
+		auto file = std::stringstream();
+		auto writer = comp6771::vector_file_writer(file, 3, 64);
+		writer.write(batch);
+		writer.finish();
+		CHECK(writer.size() == 3);
+
+		auto reader = comp6771::vector_file_reader(file);
+		auto const read = reader.read_all(comp6771::batch_layout::column_major);
+		REQUIRE(read.size() == 3);
+		for (auto i = 0; i < read.size(); ++i) {
+			CHECK(read[i] == batch[i]);
+		}
+	}
+
+	SECTION("Streams that cannot seek are read to the end") {
+		auto buffer = unseekable_buffer();
+		auto out = std::ostream(&buffer);
+		write_sample(out);
+		auto in = std::stringstream(buffer.str());
+		auto reader = comp6771::vector_file_reader(in);
+		CHECK(not reader.size().has_value());
+		auto const read = reader.read_all();
+		REQUIRE(read.size() == 3);
+		CHECK(read[2] == vectors[2]);
+	}
+}
+
+TEST_CASE("Vector files are mapped without copying") {
+	auto const path = std::filesystem::temp_directory_path() / "euclidean_vector_test_file.bin";
+	auto const vectors = sample();
+	{
+		auto out = std::ofstream(path, std::ios::binary);
+		write_sample(out, 64);
+	}
+
+	SECTION("Mapped vectors are views of the file") {
+		auto file = comp6771::mapped_vector_file(path);
+		REQUIRE(file.size() == 3);
+		CHECK(file.dimensions() == 3);
+		CHECK(file.leading_dimension() == 8);
+		for (auto i = std::size_t{0}; i < file.size(); ++i) {
+			CHECK(file[i] == vectors[i]);
+			CHECK(reinterpret_cast<std::uintptr_t>(file[i].data()) % 64 == 0);
+		}
+		CHECK(comp6771::dot(file[0], file[2]) == comp6771::dot(vectors[0], vectors[2]));
+		CHECK_THROWS_AS(file.at(3), std::out_of_range);
+
+		auto moved = std::move(file);
+		CHECK(moved.at(1) == vectors[1]);
+	}
+
+	SECTION("Vectors with no dimensions are counted by the header") {
+		{
+			auto out = std::ofstream(path, std::ios::binary);
+			auto writer = comp6771::vector_file_writer(out, 0);
+			writer.write(comp6771::euclidean_vector(0));
+			writer.write(comp6771::euclidean_vector(0));
+		}
+		auto const file = comp6771::mapped_vector_file(path);
+		CHECK(file.size() == 2);
+		CHECK(file.dimensions() == 0);
+	}
+
+	SECTION("Files that cannot be mapped are rejected") {
+		auto file = std::stringstream();
+		write_sample(file);
+		{
+			auto out = std::ofstream(path, std::ios::binary);
+			out << swap_byte_order(file.str());
+		}
+		CHECK_THROWS_AS(comp6771::mapped_vector_file(path), std::runtime_error);
+		std::filesystem::remove(path);
+		CHECK_THROWS_AS(comp6771::mapped_vector_file(path), std::system_error);
+	}
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,129 @@
+#include "comp6771/fixed_euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	using vec3 = comp6771::fixed_euclidean_vector<3>;
+	using vec4 = comp6771::fixed_euclidean_vector<4>;
+
+	template<typename Lhs, typename Rhs>
+	concept addable = requires(Lhs lhs, Rhs rhs) {
+		lhs + rhs;
+	};
+
+	template<typename Lhs, typename Rhs>
+	concept dottable = requires(Lhs lhs, Rhs rhs) {
+		dot(lhs, rhs);
+	};
+
+	template<typename Lhs, typename Rhs>
+	concept comparable = requires(Lhs lhs, Rhs rhs) {
+		lhs == rhs;
+	};
+
+	template<typename T>
+	concept has_norm = requires(T v) {
+		euclidean_norm(v);
+	};
+
+	// arithmetic is usable in constant expressions
+	constexpr auto a = vec3{1.0, 2.0, 3.0};
+	constexpr auto b = vec3{4, 5, 6};
+	static_assert(a + b == vec3{5.0, 7.0, 9.0});
+	static_assert(b - a == vec3(3.0));
+	static_assert(-a * 2.0 == vec3{-2.0, -4.0, -6.0});
+	static_assert(b / 2.0 == vec3{2.0, 2.5, 3.0});
+	static_assert(dot(a, b) == 32.0);
+	static_assert(squared_distance(a, b) == 27.0);
+	static_assert(vec3().at(2) == 0.0);
+	static_assert(vec3::dimensions() == 3);
+
+	// no heap, no padding, no bookkeeping
+	static_assert(sizeof(vec3) == 3 * sizeof(double));
+	static_assert(std::is_trivially_copyable_v<vec4>);
+
+	// mismatched dimensions are compile errors
+	static_assert(addable<vec3, vec3>);
+	static_assert(not addable<vec3, vec4>);
+	static_assert(dottable<vec3, vec3>);
+	static_assert(not dottable<vec3, vec4>);
+	static_assert(not comparable<vec3, vec4>);
+	static_assert(not std::is_constructible_v<vec3, vec4>);
+	static_assert(not std::is_constructible_v<vec3, double, double>);
+	static_assert(has_norm<vec3>);
+	static_assert(not has_norm<comp6771::fixed_euclidean_vector<0>>);
+} // namespace
+
+TEST_CASE("Fixed-dimension vectors") {
+	auto v = vec3{3.0, 4.0, 12.0};
+
+	SECTION("Compound assignment updates in place") {
+		v += vec3(1.0);
+		CHECK(v == vec3{4.0, 5.0, 13.0});
+		v -= vec3{4.0, 5.0, 0.0};
+		v *= 2.0;
+		CHECK(v == vec3{0.0, 0.0, 26.0});
+		CHECK_THROWS_AS(v /= 0.0, std::logic_error);
+	}
+
+	SECTION("Element access is checked by at") {
+		v.at(1) = 7.0;
+		CHECK(v[1] == 7.0);
+		CHECK_THROWS_AS(v.at(3), std::out_of_range);
+		CHECK_THROWS_AS(v.at(-1), std::out_of_range);
+	}
+
+	SECTION("Utility functions") {
+		CHECK(euclidean_norm(v) == 13.0);
+		CHECK(unit(v) == v * (1.0 / 13.0));
+		CHECK(distance(v, vec3()) == 13.0);
+		CHECK(cosine_similarity(v, v * 3.0) == Approx(1.0));
+		CHECK_THROWS_AS(unit(vec3()), std::logic_error);
+	}
+
+	SECTION("Results match euclidean_vector bit for bit") {
+		auto x = comp6771::fixed_euclidean_vector<37>();
+		auto y = comp6771::fixed_euclidean_vector<37>();
+		for (auto i = 0; i < 37; ++i) {
+			x[i] = 1.0 / (i + 1);
+			y[i] = 0.1 * i - 1.7;
+		}
+		auto const dynamic_x = static_cast<comp6771::euclidean_vector>(x);
+		auto const dynamic_y = static_cast<comp6771::euclidean_vector>(y);
+		CHECK(dot(x, y) == comp6771::dot(dynamic_x, dynamic_y));
+		CHECK(euclidean_norm(x) == comp6771::euclidean_norm(dynamic_x));
+		CHECK(squared_distance(x, y) == comp6771::squared_distance(dynamic_x, dynamic_y));
+		CHECK(static_cast<comp6771::euclidean_vector>(unit(x)) == comp6771::unit(dynamic_x));
+		CHECK(static_cast<comp6771::euclidean_vector>(unit(y)) == comp6771::unit(dynamic_y));
+		CHECK(dot(v, v) == comp6771::dot(static_cast<comp6771::euclidean_vector>(v),
+		                                 static_cast<comp6771::euclidean_vector>(v)));
+	}
+
+	SECTION("Conversions to and from euclidean_vector") {
+		auto const dynamic = static_cast<comp6771::euclidean_vector>(v);
+		CHECK(dynamic == comp6771::euclidean_vector{3.0, 4.0, 12.0});
+		CHECK(vec3(dynamic) == v);
+		CHECK_THROWS_AS(vec4(dynamic), std::logic_error);
+		CHECK(static_cast<std::vector<double>>(v) == std::vector<double>{3.0, 4.0, 12.0});
+	}
+
+	SECTION("Fixed vectors are viewed without copying") {
+		auto const view = comp6771::euclidean_vector_view(v);
+		CHECK(view.data() == v.data());
+		auto ref = comp6771::euclidean_vector_ref(v);
+		ref *= 2.0;
+		CHECK(v == vec3{6.0, 8.0, 24.0});
+	}
+
+	SECTION("Fixed vectors print like euclidean_vector") {
+		auto out = std::ostringstream();
+		out << v;
+		auto expected = std::ostringstream();
+		expected << static_cast<comp6771::euclidean_vector>(v);
+		CHECK(out.str() == expected.str());
+	}
+}
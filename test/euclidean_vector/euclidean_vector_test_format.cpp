@@ -0,0 +1,124 @@
+#include "comp6771/euclidean_vector_format.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <fmt/format.h>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Vectors are formatted with fmt") {
+	auto const v = comp6771::euclidean_vector{1.0, 0.5, -3.0};
+
+	SECTION("The default format matches operator<<") {
+		CHECK(fmt::format("{}", comp6771::formatted(v)) == "[1 0.5 -3]");
+		CHECK(fmt::format("{}", comp6771::formatted(comp6771::euclidean_vector(0))) == "[]");
+	}
+
+	SECTION("Magnitudes are written in their shortest round-trip form") {
+		auto const awkward = comp6771::euclidean_vector{0.1,
+		                                                1.0 / 3.0,
+		                                                1e-310,
+		                                                -0.0,
+		                                                std::numeric_limits<double>::max()};
+		auto const text = fmt::format("{}", comp6771::formatted(awkward));
+		CHECK(text == "[0.1 0.3333333333333333 1e-310 -0 1.7976931348623157e+308]");
+		auto const parsed = comp6771::parse_euclidean_vector(text);
+		CHECK(parsed == awkward);
+		CHECK(std::signbit(parsed[3]));
+	}
+
+	SECTION("Magnitudes and separators can be specified") {
+		CHECK(fmt::format("{:.2f;, }", comp6771::formatted(v)) == "[1.00, 0.50, -3.00]");
+		CHECK(fmt::format("{:n;,}", comp6771::formatted(v)) == "1,0.5,-3");
+		CHECK(fmt::format("{:n}", comp6771::formatted(v)) == "1 0.5 -3");
+		CHECK(fmt::format("<{:>5}>", comp6771::formatted(v)) == "<[    1   0.5    -3]>");
+	}
+
+	SECTION("Views and references are formatted") {
+		auto magnitudes = std::vector<double>{1.0, 9.0, 2.0, 9.0};
+		auto const view = comp6771::euclidean_vector_view(magnitudes.data(), 2, 2);
+		CHECK(fmt::format("{}", comp6771::formatted(view)) == "[1 2]");
+		auto const ref = comp6771::euclidean_vector_ref(magnitudes.data() + 1, 2, 2);
+		CHECK(fmt::format("{:n;,}", comp6771::formatted(ref)) == "9,9");
+	}
+}
+
+TEST_CASE("Vectors are parsed from text") {
+	SECTION("Separators may be whitespace, commas, or both") {
+		auto const expected = comp6771::euclidean_vector{1.0, -2.5, 3.0};
+		CHECK(comp6771::parse_euclidean_vector("[1 -2.5 3]") == expected);
+		CHECK(comp6771::parse_euclidean_vector("[1,-2.5,+3]") == expected);
+		CHECK(comp6771::parse_euclidean_vector(" [ 1 ,\t-2.5 , 3 ] \n") == expected);
+		CHECK(comp6771::parse_euclidean_vector("[]").dimensions() == 0);
+		auto const infinity = std::numeric_limits<double>::infinity();
+		CHECK(comp6771::parse_euclidean_vector("[inf]")[0] == infinity);
+	}
+
+	SECTION("Parsing into a vector reuses its storage") {
+		auto const text = std::string("[1 2] [3 4]");
+		auto v = comp6771::euclidean_vector(2);
+		auto const* const storage = v.data();
+		auto const consumed = comp6771::parse_euclidean_vector(text, v);
+		CHECK(consumed == std::size_t{5});
+		CHECK(v == comp6771::euclidean_vector{1.0, 2.0});
+		comp6771::parse_euclidean_vector(std::string_view(text).substr(consumed), v);
+		CHECK(v == comp6771::euclidean_vector{3.0, 4.0});
+		CHECK(v.data() == storage);
+		CHECK(comp6771::euclidean_norm(v) == 5.0);
+	}
+
+	SECTION("Invalid text is rejected") {
+		for (auto const* const text : {"", "1 2", "[1 2", "[1 x]", "[1,,2]", "[1 2] 3", "[1e999]"}) {
+			CHECK_THROWS_AS(comp6771::parse_euclidean_vector(text), std::invalid_argument);
+		}
+		CHECK_THROWS_WITH(comp6771::parse_euclidean_vector("[1 x]"),
+		                  "Cannot parse a euclidean_vector: expected a magnitude at offset 3");
+	}
+}
+
+TEST_CASE("CSV rows are parsed") {
+	SECTION("Rows are parsed one at a time") {
+		auto const text = std::string(" 1, 2 ,3\r\n4,5,6");
+		auto v = comp6771::euclidean_vector();
+		auto const consumed = comp6771::parse_csv_row(text, v);
+		CHECK(consumed == std::size_t{10});
+		CHECK(v == comp6771::euclidean_vector{1.0, 2.0, 3.0});
+		CHECK(comp6771::parse_csv_row(std::string_view(text).substr(consumed), v) == std::size_t{5});
+		CHECK(v == comp6771::euclidean_vector{4.0, 5.0, 6.0});
+	}
+
+	SECTION("Rows are parsed into strided references") {
+		auto magnitudes = std::vector<double>(4);
+		comp6771::parse_csv_row("7,8\n", comp6771::euclidean_vector_ref(magnitudes.data() + 1, 2, 2));
+		CHECK(magnitudes == std::vector<double>{0.0, 7.0, 0.0, 8.0});
+		CHECK_THROWS_AS(comp6771::parse_csv_row("7,8,9", comp6771::euclidean_vector_ref(magnitudes)),
+		                std::logic_error);
+	}
+
+	SECTION("Files are parsed into batches") {
+		auto const text = std::string("1,2\n\n3,4\r\n5,6\n");
+		for (auto const layout :
+		     {comp6771::batch_layout::row_major, comp6771::batch_layout::column_major}) {
+			auto const batch = comp6771::parse_csv(text, layout);
+			REQUIRE(batch.size() == 3);
+			CHECK(batch.dimensions() == 2);
+			CHECK(batch.layout() == layout);
+			CHECK(batch[0] == comp6771::euclidean_vector{1.0, 2.0});
+			CHECK(batch[2] == comp6771::euclidean_vector{5.0, 6.0});
+		}
+		CHECK(comp6771::parse_csv("").size() == 0);
+	}
+
+	SECTION("Invalid rows are rejected") {
+		auto v = comp6771::euclidean_vector();
+		CHECK_THROWS_AS(comp6771::parse_csv_row("1 2", v), std::invalid_argument);
+		CHECK_THROWS_AS(comp6771::parse_csv_row("1,", v), std::invalid_argument);
+		CHECK_THROWS_AS(comp6771::parse_csv("1,2\n3\n"), std::logic_error);
+		CHECK_THROWS_WITH(comp6771::parse_csv("1,2\n3,y\n"),
+		                  "Cannot parse a euclidean_vector: expected a magnitude at offset 6");
+	}
+}
@@ -0,0 +1,164 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Fused distances and cosine similarity") {
+	auto const a = comp6771::euclidean_vector{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+	auto const b = comp6771::euclidean_vector{6.0, 5.0, 4.0, 3.0, 2.0, 1.0};
+
+	SECTION("Distances match the norm of the difference") {
+		CHECK(comp6771::squared_distance(a, b) == 70.0);
+		CHECK(comp6771::distance(a, b) == comp6771::euclidean_norm(a - b));
+		CHECK(comp6771::distance(a, a) == 0.0);
+	}
+
+	SECTION("Cosine similarity matches dot product over both norms") {
+		auto const expected =
+		   comp6771::dot(a, b) / (comp6771::euclidean_norm(a) * comp6771::euclidean_norm(b));
+		CHECK(comp6771::cosine_similarity(a, b) == expected);
+		CHECK(comp6771::cosine_similarity(a, a * -2.0) == Approx(-1.0));
+	}
+
+	SECTION("Cosine similarity does not depend on which norms are cached") {
+		auto x = comp6771::euclidean_vector(37, 0.1);
+		auto y = comp6771::euclidean_vector(37, 0.7);
+		x[3] = 4.0;
+		y[30] = -2.0;
+		auto const uncached = comp6771::cosine_similarity(x, y);
+		auto const cached = comp6771::cosine_similarity(x, y);
+		CHECK(uncached == cached);
+		// the fused pass filled the caches with the same norms euclidean_norm computes
+		auto const x_copy = comp6771::euclidean_vector(x * 1.0);
+		CHECK(comp6771::euclidean_norm(x) == comp6771::euclidean_norm(x_copy));
+	}
+
+	SECTION("Views and owning vectors give the same results") {
+		auto const av = comp6771::euclidean_vector_view(a);
+		auto const bv = comp6771::euclidean_vector_view(b);
+		CHECK(comp6771::squared_distance(av, bv) == comp6771::squared_distance(a, b));
+		CHECK(comp6771::distance(av, b) == comp6771::distance(a, b));
+		CHECK(comp6771::cosine_similarity(av, bv) == comp6771::cosine_similarity(a, b));
+
+		auto const buffer = std::vector<double>{1.0, 0.0, 2.0, 0.0, 3.0, 0.0};
+		auto const strided = comp6771::euclidean_vector_view(buffer.data(), 3, 2);
+		auto const packed = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+		CHECK(comp6771::distance(strided, packed) == 0.0);
+		CHECK(comp6771::cosine_similarity(strided, packed) == Approx(1.0));
+	}
+
+	SECTION("Invalid operands are rejected") {
+		auto const shorter = comp6771::euclidean_vector(5, 1.0);
+		CHECK_THROWS_AS(comp6771::squared_distance(a, shorter), std::logic_error);
+		CHECK_THROWS_AS(comp6771::cosine_similarity(a, shorter), std::logic_error);
+		CHECK_THROWS_AS(comp6771::cosine_similarity(a, comp6771::euclidean_vector(6)),
+		                std::logic_error);
+		CHECK_THROWS_AS(comp6771::cosine_similarity(comp6771::euclidean_vector(0),
+		                                            comp6771::euclidean_vector(0)),
+		                std::logic_error);
+	}
+}
+
+TEST_CASE("Fused element-wise updates") {
+	auto const x = comp6771::euclidean_vector{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+
+	SECTION("axpy updates in place") {
+		auto y = comp6771::euclidean_vector(6, 1.0);
+		CHECK(comp6771::euclidean_norm(y) == std::sqrt(6.0));
+		comp6771::axpy(2.0, x, y);
+		CHECK(y == comp6771::euclidean_vector{3.0, 5.0, 7.0, 9.0, 11.0, 13.0});
+		// the cached norm is invalidated
+		CHECK(comp6771::euclidean_norm(y) == comp6771::euclidean_norm(y * 1.0));
+		auto shorter = comp6771::euclidean_vector(5);
+		CHECK_THROWS_AS(comp6771::axpy(1.0, x, shorter), std::logic_error);
+	}
+
+	SECTION("axpy writes through references, strided or not") {
+		auto buffer = std::vector<double>(12, 1.0);
+		comp6771::axpy(-1.0, x, comp6771::euclidean_vector_ref(buffer.data(), 6));
+		CHECK(buffer[5] == -5.0);
+		comp6771::axpy(1.0, x, comp6771::euclidean_vector_ref(buffer.data() + 6, 6));
+		CHECK(buffer[11] == 7.0);
+		auto strided = std::vector<double>(6, 0.0);
+		comp6771::axpy(0.5,
+		               comp6771::euclidean_vector_view(x.data(), 3, 2),
+		               comp6771::euclidean_vector_ref(strided.data(), 3, 2));
+		CHECK(strided == std::vector<double>{0.5, 0.0, 1.5, 0.0, 2.5, 0.0});
+	}
+
+	SECTION("lerp interpolates and reaches its end points exactly") {
+		auto const y = comp6771::euclidean_vector{0.1, 0.2, 0.3, 0.4, 0.5, 0.6};
+		CHECK(comp6771::euclidean_vector(comp6771::lerp(x, y, 0.0)) == x);
+		CHECK(comp6771::euclidean_vector(comp6771::lerp(x, y, 1.0)) == y);
+		auto const halfway = comp6771::euclidean_vector(comp6771::lerp(x, y, 0.5));
+		for (auto i = 0; i < x.dimensions(); ++i) {
+			CHECK(halfway[i] == x[i] + 0.5 * (y[i] - x[i]));
+		}
+		// lerp is an expression node like any other
+		auto const shifted = comp6771::euclidean_vector(comp6771::lerp(x, y, 0.5) + y);
+		CHECK(shifted == comp6771::euclidean_vector(halfway + y));
+		CHECK_THROWS_AS(comp6771::lerp(x, comp6771::euclidean_vector(5), 0.5), std::logic_error);
+	}
+
+	SECTION("scale_add rounds once") {
+		auto const third = 1.0 / 3.0;
+		auto const y = comp6771::euclidean_vector(6, -1.0);
+		auto const result = comp6771::euclidean_vector(comp6771::scale_add(third, x, y));
+		for (auto i = 0; i < x.dimensions(); ++i) {
+			CHECK(result[i] == std::fma(third, x[i], y[i]));
+		}
+		auto const buffer = std::vector<double>{1.0, 9.0, 2.0, 9.0, 3.0, 9.0};
+		auto const strided = comp6771::euclidean_vector_view(buffer.data(), 3, 2);
+		auto const ones = comp6771::euclidean_vector(3, 1.0);
+		CHECK(comp6771::euclidean_vector(comp6771::scale_add(2.0, strided, ones))
+		      == comp6771::euclidean_vector{3.0, 5.0, 7.0});
+	}
+}
+
+TEST_CASE("Fused batch operations") {
+	auto const vectors = std::vector<comp6771::euclidean_vector>{{1.0, 0.0, 2.0},
+	                                                             {0.0, 3.0, 4.0},
+	                                                             {-1.0, 2.0, 0.5},
+	                                                             {2.0, 2.0, 2.0}};
+	auto const query = comp6771::euclidean_vector{0.5, -1.0, 3.0};
+
+	for (auto const layout :
+	     {comp6771::batch_layout::row_major, comp6771::batch_layout::column_major}) {
+		auto const batch = comp6771::euclidean_vector_batch(vectors, layout);
+
+		auto const squared = comp6771::squared_distance(batch, query);
+		auto const similarities = comp6771::cosine_similarity(batch, query);
+		REQUIRE(squared.size() == vectors.size());
+		REQUIRE(similarities.size() == vectors.size());
+		for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+			CHECK(squared[i] == Approx(comp6771::squared_distance(vectors[i], query)));
+			CHECK(similarities[i] == Approx(comp6771::cosine_similarity(vectors[i], query)));
+		}
+	}
+
+	SECTION("Row-major results are bitwise identical to the single-vector functions") {
+		auto const batch = comp6771::euclidean_vector_batch(vectors);
+		auto const similarities = comp6771::cosine_similarity(batch, query);
+		for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+			CHECK(similarities[i] == comp6771::cosine_similarity(vectors[i], query));
+		}
+	}
+
+	SECTION("Zero vectors have no cosine similarity") {
+		auto const batch = comp6771::euclidean_vector_batch(2, 3);
+		CHECK_THROWS_AS(comp6771::cosine_similarity(batch, query), std::logic_error);
+		CHECK_THROWS_AS(comp6771::squared_distance(batch, comp6771::euclidean_vector(2)),
+		                std::logic_error);
+	}
+
+	SECTION("Batch rows can be assigned fused expressions") {
+		auto batch = comp6771::euclidean_vector_batch(vectors, comp6771::batch_layout::column_major);
+		batch[0] = comp6771::lerp(batch[0], batch[1], 1.0);
+		CHECK(batch[0] == vectors[1]);
+	}
+}
@@ -0,0 +1,160 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_index.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	using comp6771::batch_layout;
+	using comp6771::euclidean_vector_batch;
+	using comp6771::neighbour;
+
+	// `size` vectors around `clusters` random centres; coordinates are rounded to quarters so
+	// that some distances tie
+	auto clustered(int size, int dimensions, int clusters, std::uint32_t seed)
+	   -> euclidean_vector_batch {
+		auto engine = std::mt19937(seed);
+		auto centre = std::uniform_real_distribution<double>(-10.0, 10.0);
+		auto noise = std::normal_distribution<double>(0.0, 1.0);
+		auto centres = std::vector<double>(static_cast<std::size_t>(clusters * dimensions));
+		std::generate(centres.begin(), centres.end(), [&] { return centre(engine); });
+		auto batch = euclidean_vector_batch(size, dimensions);
+		for (auto i = 0; i < size; ++i) {
+			auto const c = static_cast<std::size_t>(i % clusters * dimensions);
+			for (auto d = 0; d < dimensions; ++d) {
+				auto const x = centres[c + static_cast<std::size_t>(d)] + noise(engine);
+				batch(i, d) = std::round(x * 4) / 4;
+			}
+		}
+		return batch;
+	}
+
+	// every distance, sorted, cut to k
+	auto expected_neighbours(euclidean_vector_batch const& vectors,
+	                         comp6771::euclidean_vector_view query,
+	                         int k) -> std::vector<neighbour> {
+		auto all = std::vector<neighbour>();
+		for (auto i = 0; i < vectors.size(); ++i) {
+			all.push_back({i, comp6771::distance(vectors[i], query)});
+		}
+		std::stable_sort(all.begin(), all.end(), [](neighbour const& x, neighbour const& y) {
+			return x.distance < y.distance;
+		});
+		all.resize(std::min(all.size(), static_cast<std::size_t>(k)));
+		return all;
+	}
+
+	auto recall(std::vector<neighbour> const& found, std::vector<neighbour> const& expected)
+	   -> double {
+		auto hits = 0;
+		for (auto const& n : expected) {
+			hits += static_cast<int>(std::any_of(found.begin(), found.end(), [&](neighbour const& f) {
+				return f.row == n.row;
+			}));
+		}
+		return static_cast<double>(hits) / static_cast<double>(expected.size());
+	}
+} // namespace
+
+TEST_CASE("Exact indexes find the same neighbours as sorting every distance") {
+	for (auto const dimensions : {1, 3, 8}) {
+		auto const vectors = clustered(2000, dimensions, 10, 1);
+		auto const queries = clustered(50, dimensions, 10, 2);
+		auto const brute = comp6771::brute_force_index(vectors);
+		auto const tree = comp6771::kd_tree_index(vectors);
+		auto const threaded_brute = comp6771::brute_force_index(vectors, 4);
+		auto const threaded_tree = comp6771::kd_tree_index(vectors, 4);
+		auto const column_major = vectors.to_layout(batch_layout::column_major);
+		auto const column_tree = comp6771::kd_tree_index(column_major);
+
+		for (auto const k : {0, 1, 10}) {
+			auto const brute_batch = brute.search(queries, k);
+			auto const tree_batch = threaded_tree.search(queries, k);
+			auto const threaded_batch = threaded_brute.search(queries, k);
+			REQUIRE(brute_batch.size() == 50);
+			for (auto q = 0; q < queries.size(); ++q) {
+				auto const expected = expected_neighbours(vectors, queries[q], k);
+				auto const i = static_cast<std::size_t>(q);
+				CHECK(brute.search(queries[q], k) == expected);
+				CHECK(tree.search(queries[q], k) == expected);
+				CHECK(column_tree.search(queries[q], k) == expected);
+				CHECK(brute_batch[i] == expected);
+				CHECK(threaded_batch[i] == expected);
+				CHECK(tree_batch[i] == expected);
+			}
+		}
+	}
+}
+
+TEST_CASE("Indexes over few vectors") {
+	auto const vectors = clustered(5, 2, 1, 3);
+	auto const query = comp6771::euclidean_vector{0.0, 0.0};
+	auto const expected = expected_neighbours(vectors, query, 5);
+	CHECK(comp6771::brute_force_index(vectors).search(query, 100) == expected);
+	CHECK(comp6771::kd_tree_index(vectors).search(query, 100) == expected);
+	CHECK(comp6771::ivf_index(vectors).search(query, 100, 5) == expected);
+	CHECK(comp6771::ivf_index(vectors).lists() == 5);
+
+	auto const empty = euclidean_vector_batch(0, 2);
+	CHECK(comp6771::brute_force_index(empty).search(query, 3).empty());
+	CHECK(comp6771::kd_tree_index(empty).search(query, 3).empty());
+	CHECK(comp6771::ivf_index(empty).search(query, 3, 4).empty());
+}
+
+TEST_CASE("Inverted file indexes") {
+	auto const vectors = clustered(4000, 16, 32, 4);
+	auto const queries = clustered(100, 16, 32, 5);
+	auto const options = comp6771::ivf_options{.lists = 32, .iterations = 10, .seed = 7};
+	auto const index = comp6771::ivf_index(vectors, options);
+	REQUIRE(index.lists() == 32);
+
+	SECTION("Probing every list is exact") {
+		auto const results = index.search(queries, 10, index.lists());
+		for (auto q = 0; q < queries.size(); ++q) {
+			CHECK(results[static_cast<std::size_t>(q)]
+			      == expected_neighbours(vectors, queries[q], 10));
+		}
+	}
+
+	SECTION("A few probes find most neighbours") {
+		auto total = 0.0;
+		for (auto q = 0; q < queries.size(); ++q) {
+			auto const expected = expected_neighbours(vectors, queries[q], 10);
+			total += recall(index.search(queries[q], 10, 4), expected);
+		}
+		CHECK(total / queries.size() >= 0.9);
+	}
+
+	SECTION("Building does not depend on the number of threads") {
+		auto const threaded = comp6771::ivf_index(vectors, options, 4);
+		CHECK(threaded.centroids().size() == index.centroids().size());
+		for (auto c = 0; c < index.lists(); ++c) {
+			CHECK(threaded.centroids()[c] == index.centroids()[c]);
+		}
+		CHECK(threaded.search(queries, 10, 3) == index.search(queries, 10, 3));
+	}
+}
+
+TEST_CASE("Index errors") {
+	auto const vectors = clustered(100, 3, 2, 6);
+	auto const wrong = comp6771::euclidean_vector(4);
+	CHECK_THROWS_WITH(comp6771::brute_force_index(vectors).search(wrong, 1),
+	                  "Dimensions of LHS(3) and RHS(4) do not match");
+	CHECK_THROWS_AS(comp6771::kd_tree_index(vectors).search(wrong, 1), std::logic_error);
+	CHECK_THROWS_AS(comp6771::ivf_index(vectors).search(wrong, 1, 1), std::logic_error);
+	CHECK_THROWS_AS(comp6771::kd_tree_index(vectors).search(euclidean_vector_batch(2, 4), 1),
+	                std::logic_error);
+
+	auto const query = comp6771::euclidean_vector(3);
+	CHECK_THROWS_AS(comp6771::brute_force_index(vectors).search(query, -1), std::invalid_argument);
+	CHECK_THROWS_AS(comp6771::ivf_index(vectors).search(query, 1, 0), std::invalid_argument);
+	CHECK_THROWS_AS(comp6771::brute_force_index(vectors, 0), std::invalid_argument);
+	CHECK_THROWS_AS(comp6771::ivf_index(vectors, {.lists = 0}), std::invalid_argument);
+}
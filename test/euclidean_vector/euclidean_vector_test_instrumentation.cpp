@@ -0,0 +1,139 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/instrumentation.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+	namespace instrumentation = comp6771::instrumentation;
+	using instrumentation::event;
+	using instrumentation::operation;
+
+	auto calls(operation const op) -> std::uint64_t {
+		return instrumentation::collect()[op].calls;
+	}
+
+	// with instrumentation disabled, nothing is ever counted
+	auto expected(std::uint64_t const count) -> std::uint64_t {
+		return instrumentation::enabled ? count : 0;
+	}
+} // namespace
+
+TEST_CASE("Instrumentation counts operations") {
+	instrumentation::reset();
+	auto v = comp6771::euclidean_vector(100, 1.0);
+	auto const w = comp6771::euclidean_vector(100, 2.0);
+
+	SECTION("Constructors and copies") {
+		auto const copy = v;
+		auto moved = comp6771::euclidean_vector(std::move(v));
+		moved = copy;
+		CHECK(calls(operation::construct) == expected(2));
+		CHECK(calls(operation::copy) == expected(1));
+		CHECK(calls(operation::move) == expected(1));
+		CHECK(calls(operation::copy_assign) == expected(1));
+		// the vectors that were constructed and copied; move and copy assignment reuse storage
+		auto const statistics = instrumentation::collect();
+		CHECK(statistics[event::allocation] == expected(3));
+		CHECK(statistics[event::allocated_bytes] == expected(3 * 100 * sizeof(double)));
+		CHECK(statistics[operation::copy].bytes == expected(2 * 100 * sizeof(double)));
+	}
+
+	SECTION("Small vectors do not allocate") {
+		auto const small = comp6771::euclidean_vector{1.0, 2.0};
+		CHECK(small.dimensions() == 2);
+		CHECK(instrumentation::collect()[event::allocation] == expected(2));
+	}
+
+	SECTION("Arithmetic, dot, euclidean_norm and unit") {
+		v += w;
+		v -= w;
+		v *= 2.0;
+		v /= 2.0;
+		auto const sum = comp6771::euclidean_vector(v + w);
+		CHECK(comp6771::dot(v, w) == 200.0);
+		CHECK(comp6771::euclidean_norm(sum) == 30.0);
+		CHECK(comp6771::euclidean_norm(sum) == 30.0);
+		auto const u = comp6771::unit(sum);
+		CHECK(u[0] == Approx(0.1));
+
+		auto const statistics = instrumentation::collect();
+		CHECK(statistics[operation::add].calls == expected(1));
+		CHECK(statistics[operation::subtract].calls == expected(1));
+		CHECK(statistics[operation::multiply].calls == expected(1));
+		CHECK(statistics[operation::divide].calls == expected(1));
+		// v + w, and the product inside unit
+		CHECK(statistics[operation::evaluate].calls == expected(2));
+		CHECK(statistics[operation::dot].calls == expected(1));
+		CHECK(statistics[operation::dot].bytes == expected(2 * 100 * sizeof(double)));
+		// twice directly and once by unit, but only the first reads the magnitudes
+		CHECK(statistics[operation::euclidean_norm].calls == expected(3));
+		CHECK(statistics[operation::euclidean_norm].bytes == expected(100 * sizeof(double)));
+		CHECK(statistics[operation::unit].calls == expected(1));
+
+		auto const& add = statistics[operation::add];
+		CHECK(std::accumulate(add.latency.begin(), add.latency.end(), std::uint64_t{0})
+		      == add.calls);
+	}
+
+	SECTION("Dimension mismatches") {
+		auto const small = comp6771::euclidean_vector(3);
+		CHECK_THROWS_AS(v += small, std::logic_error);
+		CHECK_THROWS_AS(comp6771::dot(v, small), std::logic_error);
+		CHECK(instrumentation::collect()[event::dimension_mismatch] == expected(2));
+		// the calls that threw are still counted
+		CHECK(calls(operation::dot) == expected(1));
+	}
+
+	SECTION("Other threads' counts are kept after they exit") {
+		auto thread = std::thread([&w] { static_cast<void>(comp6771::dot(w, w)); });
+		thread.join();
+		static_cast<void>(comp6771::dot(w, w));
+		CHECK(calls(operation::dot) == expected(2));
+	}
+
+	SECTION("Reset") {
+		static_cast<void>(comp6771::dot(v, w));
+		instrumentation::reset();
+		CHECK(calls(operation::dot) == 0);
+		CHECK(instrumentation::collect()[event::allocation] == 0);
+	}
+}
+
+TEST_CASE("Instrumentation exports JSON and tables") {
+	auto statistics = instrumentation::snapshot();
+	auto& dot = statistics.operations[static_cast<std::size_t>(operation::dot)];
+	dot.calls = 4;
+	dot.bytes = 6400;
+	dot.nanoseconds = 100;
+	// latencies of 1, 2 and 3, and 100 nanoseconds
+	dot.latency[1] = 1;
+	dot.latency[2] = 2;
+	dot.latency[7] = 1;
+	statistics.events[static_cast<std::size_t>(event::allocation)] = 3;
+
+	CHECK(dot.latency_quantile(0.5) == 4);
+	CHECK(dot.latency_quantile(0.99) == 128);
+	CHECK(instrumentation::operation_statistics().latency_quantile(0.5) == 0);
+
+	auto const json = instrumentation::to_json(statistics);
+	CHECK(json.starts_with(R"({"operations":{"dot":{"calls":4,"bytes":6400,"nanoseconds":100,)"
+	                       R"("latency":[0,1,2,0,0,0,0,1,0,)"));
+	CHECK(json.ends_with(
+	   R"(},"events":{"allocation":3,"allocated_bytes":0,"dimension_mismatch":0}})"));
+	CHECK(json.find("construct") == std::string::npos);
+
+	auto const table = instrumentation::to_table(statistics);
+	CHECK(table.starts_with("operation"));
+	CHECK(table.find("\ndot ") != std::string::npos);
+	CHECK(table.find("25.0") != std::string::npos);
+	CHECK(table.find("\nallocation ") != std::string::npos);
+	CHECK(table.find("\nconstruct ") == std::string::npos);
+
+	CHECK(instrumentation::name(operation::euclidean_norm) == "euclidean_norm");
+	CHECK(instrumentation::name(event::dimension_mismatch) == "dimension_mismatch");
+}
@@ -0,0 +1,180 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "kernel_guard.hpp"
+
+#include <bit>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	using comp6771::kernels::simd_level;
+
+	auto random_magnitudes(std::size_t size, std::uint32_t seed) -> std::vector<double> {
+		auto engine = std::mt19937_64(seed);
+		auto distribution = std::uniform_real_distribution<double>(0.0, 2.0);
+		auto magnitudes = std::vector<double>(size);
+		for (auto& magnitude : magnitudes) {
+			magnitude = distribution(engine);
+		}
+		return magnitudes;
+	}
+
+	// distance between two positive doubles in units in the last place
+	auto ulp_distance(double a, double b) -> std::int64_t {
+		return std::abs(std::bit_cast<std::int64_t>(a) - std::bit_cast<std::int64_t>(b));
+	}
+
+	auto exact_dot(std::vector<double> const& x, std::vector<double> const& y) -> double {
+		auto sum = 0.0L;
+		for (auto i = std::size_t{0}; i < x.size(); ++i) {
+			sum += static_cast<long double>(x[i]) * static_cast<long double>(y[i]);
+		}
+		return static_cast<double>(sum);
+	}
+} // namespace
+
+TEST_CASE("SIMD kernels") {
+	auto const guard = testing::kernel_guard();
+
+	SECTION("Dot products are identical at every SIMD level") {
+		for (auto const size : {0, 1, 15, 16, 17, 100, 4096, 4099}) {
+			auto const n = static_cast<std::size_t>(size);
+			auto const x = random_magnitudes(n, 1);
+			auto const y = random_magnitudes(n, 2);
+
+			comp6771::kernels::set_simd_level(simd_level::scalar);
+			auto const reference = comp6771::kernels::dot(x.data(), y.data(), n);
+			auto const bound = static_cast<std::int64_t>(n / 16 + 20);
+			CHECK(ulp_distance(reference, exact_dot(x, y)) <= bound);
+
+			for (auto const level : testing::simd_levels()) {
+				comp6771::kernels::set_simd_level(level);
+				CHECK(comp6771::kernels::active_simd_level() == level);
+				CHECK(std::bit_cast<std::uint64_t>(comp6771::kernels::dot(x.data(), y.data(), n))
+				      == std::bit_cast<std::uint64_t>(reference));
+				CHECK(comp6771::kernels::sum_of_squares(x.data(), n)
+				      == comp6771::kernels::dot(x.data(), x.data(), n));
+			}
+		}
+	}
+
+	SECTION("Squared distances are identical at every SIMD level") {
+		for (auto const size : {0, 1, 17, 4099}) {
+			auto const n = static_cast<std::size_t>(size);
+			auto const x = random_magnitudes(n, 6);
+			auto const y = random_magnitudes(n, 7);
+			auto difference = std::vector<double>(n);
+			comp6771::kernels::set_simd_level(simd_level::scalar);
+			comp6771::kernels::subtract(difference.data(), x.data(), y.data(), n);
+			auto const reference = comp6771::kernels::sum_of_squares(difference.data(), n);
+			for (auto const level : testing::simd_levels()) {
+				comp6771::kernels::set_simd_level(level);
+				CHECK(std::bit_cast<std::uint64_t>(
+				         comp6771::kernels::squared_distance(x.data(), y.data(), n))
+				      == std::bit_cast<std::uint64_t>(reference));
+			}
+		}
+	}
+
+	SECTION("Dot terms match the separate reductions at every SIMD level") {
+		for (auto const size : {0, 1, 15, 16, 17, 100, 4099}) {
+			auto const n = static_cast<std::size_t>(size);
+			auto const x = random_magnitudes(n, 8);
+			auto const y = random_magnitudes(n, 9);
+			for (auto const level : testing::simd_levels()) {
+				comp6771::kernels::set_simd_level(level);
+				auto const terms = comp6771::kernels::dot_terms_of(x.data(), y.data(), n);
+				CHECK(std::bit_cast<std::uint64_t>(terms.xy)
+				      == std::bit_cast<std::uint64_t>(comp6771::kernels::dot(x.data(), y.data(), n)));
+				CHECK(std::bit_cast<std::uint64_t>(terms.xx)
+				      == std::bit_cast<std::uint64_t>(comp6771::kernels::sum_of_squares(x.data(), n)));
+				CHECK(std::bit_cast<std::uint64_t>(terms.yy)
+				      == std::bit_cast<std::uint64_t>(comp6771::kernels::sum_of_squares(y.data(), n)));
+			}
+		}
+	}
+
+	SECTION("Short reductions keep the serial order") {
+		auto const x = std::vector<double>{1e16, 1.0, -1e16, 1.0};
+		auto const y = std::vector<double>{1.0, 1.0, 1.0, 1.0};
+		CHECK(comp6771::kernels::dot(x.data(), y.data(), x.size()) == ((1e16 + 1.0) - 1e16) + 1.0);
+	}
+
+	SECTION("Element-wise kernels match scalar arithmetic at every SIMD level") {
+		auto const n = std::size_t{37};
+		auto const x = random_magnitudes(n, 3);
+		auto const y = random_magnitudes(n, 4);
+		for (auto const level : testing::simd_levels()) {
+			comp6771::kernels::set_simd_level(level);
+			auto out = std::vector<double>(n);
+			comp6771::kernels::add(out.data(), x.data(), y.data(), n);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				CHECK(out[i] == x[i] + y[i]);
+			}
+			comp6771::kernels::subtract(out.data(), x.data(), y.data(), n);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				CHECK(out[i] == x[i] - y[i]);
+			}
+			comp6771::kernels::multiply(out.data(), x.data(), 3.5, n);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				CHECK(out[i] == x[i] * 3.5);
+			}
+			comp6771::kernels::divide(out.data(), x.data(), 3.0, n);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				CHECK(out[i] == x[i] / 3.0);
+			}
+			out = y;
+			comp6771::kernels::axpy(out.data(), -1.5, x.data(), n);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				auto const product = -1.5 * x[i];
+				CHECK(out[i] == y[i] + product);
+			}
+			out = y;
+			comp6771::kernels::add_squared_difference(out.data(), x.data(), 0.75, n);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				auto const difference = x[i] - 0.75;
+				auto const square = difference * difference;
+				CHECK(out[i] == y[i] + square);
+			}
+			comp6771::kernels::lerp(out.data(), x.data(), y.data(), 0.25, n);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				auto const step = 0.25 * (y[i] - x[i]);
+				CHECK(out[i] == x[i] + step);
+			}
+			comp6771::kernels::lerp(out.data(), x.data(), y.data(), 1.0, n);
+			CHECK(out == y);
+			comp6771::kernels::fused_scale_add(out.data(), 1.0 / 3.0, x.data(), y.data(), n);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				CHECK(out[i] == std::fma(1.0 / 3.0, x[i], y[i]));
+			}
+		}
+	}
+
+	SECTION("euclidean_vector operations go through the kernels") {
+		auto const magnitudes = random_magnitudes(4096, 5);
+		auto const a = comp6771::euclidean_vector(magnitudes.cbegin(), magnitudes.cend());
+		comp6771::kernels::set_simd_level(simd_level::scalar);
+		auto const scalar_dot = comp6771::dot(a, a);
+		for (auto const level : testing::simd_levels()) {
+			comp6771::kernels::set_simd_level(level);
+			CHECK(comp6771::dot(a, a) == scalar_dot);
+			auto b = comp6771::euclidean_vector(a + a);
+			b -= a;
+			CHECK(b == a);
+		}
+	}
+
+	SECTION("Unsupported levels are rejected") {
+		if (comp6771::kernels::detected_simd_level() != simd_level::avx512) {
+			REQUIRE_THROWS_AS(comp6771::kernels::set_simd_level(simd_level::avx512),
+			                  std::invalid_argument);
+		}
+		REQUIRE_NOTHROW(comp6771::kernels::set_simd_level(simd_level::scalar));
+	}
+}
@@ -0,0 +1,207 @@
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/thread_pool.hpp"
+#include "kernel_guard.hpp"
+#include "random_batch.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	namespace kernels = comp6771::kernels;
+	using comp6771::batch_layout;
+
+	auto random_matrix(int rows, int columns, unsigned seed) -> comp6771::euclidean_matrix {
+		return comp6771::euclidean_matrix(testing::random_batch(rows, columns, seed));
+	}
+
+	// the fused multiply-add chain every product is documented to compute
+	auto reference(comp6771::euclidean_matrix const& m, comp6771::euclidean_vector_view x)
+	   -> comp6771::euclidean_vector {
+		auto result = comp6771::euclidean_vector(m.rows());
+		for (auto r = 0; r < m.rows(); ++r) {
+			auto sum = 0.0;
+			for (auto c = 0; c < m.columns(); ++c) {
+				sum = std::fma(m(r, c), x[c], sum);
+			}
+			result[r] = sum;
+		}
+		return result;
+	}
+
+	auto same_rows(comp6771::euclidean_vector_batch const& x,
+	               comp6771::euclidean_vector_batch const& y) -> bool {
+		if (x.size() != y.size() or x.dimensions() != y.dimensions()) {
+			return false;
+		}
+		for (auto i = 0; i < x.size(); ++i) {
+			if (x[i] != y[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+} // namespace
+
+TEST_CASE("Constructing matrices") {
+	auto const m = comp6771::euclidean_matrix{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+	CHECK(m.rows() == 2);
+	CHECK(m.columns() == 3);
+	CHECK(m(1, 2) == 6.0);
+	CHECK(comp6771::euclidean_vector(m[1]) == comp6771::euclidean_vector{4.0, 5.0, 6.0});
+	CHECK(comp6771::euclidean_vector(m.column(1)) == comp6771::euclidean_vector{2.0, 5.0});
+	CHECK(m.leading_dimension() % 8 == 0);
+
+	auto const t = m.transpose();
+	CHECK(t.rows() == 3);
+	CHECK(t.columns() == 2);
+	CHECK(t(2, 1) == 6.0);
+	CHECK(comp6771::euclidean_vector(t.column(0)) == comp6771::euclidean_vector(m[0]));
+
+	auto const batch = m.to_batch();
+	CHECK(batch.layout() == batch_layout::row_major);
+	CHECK(batch(1, 0) == 4.0);
+	auto const from_batch = comp6771::euclidean_matrix(batch);
+	CHECK(from_batch(0, 2) == 3.0);
+
+	auto const rows = std::vector<comp6771::euclidean_vector>{{1.0, 0.0}, {0.0, 2.0}};
+	auto const from_rows = comp6771::euclidean_matrix(rows);
+	CHECK(from_rows(1, 1) == 2.0);
+
+	auto const identity = comp6771::euclidean_matrix::identity(3);
+	CHECK(identity(0, 0) == 1.0);
+	CHECK(identity(0, 1) == 0.0);
+
+	CHECK_THROWS_AS((comp6771::euclidean_matrix{{1.0, 2.0}, {3.0}}), std::logic_error);
+	auto const ragged = std::vector<comp6771::euclidean_vector>{{1.0}, {1.0, 2.0}};
+	CHECK_THROWS_AS(comp6771::euclidean_matrix(ragged), std::logic_error);
+}
+
+TEST_CASE("Transforming a vector is the same fused multiply-add chain at every SIMD level") {
+	auto const guard = testing::kernel_guard();
+	for (auto const level : testing::simd_levels()) {
+		kernels::set_simd_level(level);
+		for (auto const rows : {0, 1, 7, 17, 530}) {
+			for (auto const columns : {0, 1, 3, 5, 130}) {
+				auto const m = random_matrix(rows, columns, 1);
+				auto const x = comp6771::euclidean_vector(columns, [](int i) { return 1.0 / (i + 1); });
+				CHECK(comp6771::transform(m, x) == reference(m, x));
+			}
+		}
+	}
+
+	auto const m = comp6771::euclidean_matrix{{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+	CHECK(comp6771::transform(m, comp6771::euclidean_vector{1.0, -1.0})
+	      == comp6771::euclidean_vector{-1.0, -1.0, -1.0});
+	// a strided view is gathered first
+	auto const magnitudes = std::vector<double>{1.0, 9.0, -1.0};
+	CHECK(comp6771::transform(m, comp6771::euclidean_vector_view(magnitudes.data(), 2, 2))
+	      == comp6771::euclidean_vector{-1.0, -1.0, -1.0});
+	CHECK_THROWS_AS(comp6771::transform(m, comp6771::euclidean_vector(3)), std::logic_error);
+}
+
+TEST_CASE("Transforming a batch matches transforming each vector") {
+	auto const guard = testing::kernel_guard();
+	auto pool = comp6771::thread_pool(4);
+	for (auto const level : testing::simd_levels()) {
+		kernels::set_simd_level(level);
+		for (auto const rows : {1, 19, 300}) {
+			for (auto const columns : {1, 7, 260}) {
+				auto const m = random_matrix(rows, columns, 2);
+				auto const vectors = testing::random_batch(13, columns, 3);
+				auto const result = comp6771::transform(m, vectors);
+				REQUIRE(result.size() == vectors.size());
+				REQUIRE(result.dimensions() == rows);
+				for (auto j = 0; j < vectors.size(); ++j) {
+					CHECK(result[j] == comp6771::euclidean_vector_view(reference(m, vectors[j])));
+				}
+				CHECK(same_rows(comp6771::transform(m, vectors, pool), result));
+			}
+		}
+	}
+
+	SECTION("Many vectors across threads") {
+		auto const m = random_matrix(70, 40, 4);
+		auto const vectors = testing::random_batch(1000, 40, 5);
+		auto const serial = comp6771::transform(m, vectors);
+		CHECK(same_rows(comp6771::transform(m, vectors, pool), serial));
+		CHECK(serial[999] == comp6771::euclidean_vector_view(comp6771::transform(m, vectors[999])));
+	}
+
+	SECTION("Column-major batches stay column-major") {
+		auto const m = random_matrix(9, 6, 6);
+		auto const vectors = testing::random_batch(20, 6, 7);
+		auto const result = comp6771::transform(m, vectors.to_layout(batch_layout::column_major));
+		CHECK(result.layout() == batch_layout::column_major);
+		CHECK(same_rows(result, comp6771::transform(m, vectors)));
+	}
+
+	SECTION("Close to dot products") {
+		auto const m = random_matrix(5, 50, 8);
+		auto const vectors = testing::random_batch(3, 50, 9);
+		auto const result = comp6771::transform(m, vectors);
+		auto const products = comp6771::dot(m.to_batch(), vectors[2]);
+		for (auto i = 0; i < m.rows(); ++i) {
+			CHECK(result(2, i) == Approx(products[static_cast<std::size_t>(i)]));
+		}
+	}
+
+	SECTION("Into an existing batch") {
+		auto const m = random_matrix(11, 6, 12);
+		auto const vectors = testing::random_batch(9, 6, 13);
+		auto result = comp6771::euclidean_vector_batch(9, 11);
+		auto const* const storage = result.data();
+		comp6771::transform(m, vectors, result);
+		CHECK(result.data() == storage);
+		CHECK(same_rows(result, comp6771::transform(m, vectors)));
+		comp6771::transform(m, vectors.to_layout(batch_layout::column_major), result, pool);
+		CHECK(same_rows(result, comp6771::transform(m, vectors)));
+
+		auto too_short = comp6771::euclidean_vector_batch(8, 11);
+		CHECK_THROWS_AS(comp6771::transform(m, vectors, too_short), std::logic_error);
+		auto column_major = comp6771::euclidean_vector_batch(9, 11, batch_layout::column_major);
+		CHECK_THROWS_AS(comp6771::transform(m, vectors, column_major), std::logic_error);
+		auto too_narrow = comp6771::euclidean_vector_batch(9, 10);
+		CHECK_THROWS_AS(comp6771::transform(m, vectors, too_narrow), std::logic_error);
+
+		// a square transform still cannot write over the vectors it reads
+		auto const square = random_matrix(6, 6, 14);
+		auto in_place = vectors;
+		CHECK_THROWS_AS(comp6771::transform(square, in_place, in_place), std::logic_error);
+		CHECK(same_rows(in_place, vectors));
+	}
+
+	CHECK_THROWS_AS(comp6771::transform(random_matrix(3, 4, 1), testing::random_batch(2, 5, 1)),
+	                std::logic_error);
+	CHECK(comp6771::transform(random_matrix(3, 4, 1), testing::random_batch(0, 4, 1)).size() == 0);
+}
+
+TEST_CASE("Multiplying matrices") {
+	auto const a = comp6771::euclidean_matrix{{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+	auto const b = comp6771::euclidean_matrix{{1.0, 0.0, 2.0, 1.0}, {0.0, 1.0, 1.0, -1.0}};
+	auto const product = comp6771::multiply(a, b);
+	REQUIRE(product.rows() == 3);
+	REQUIRE(product.columns() == 4);
+	auto const last_row = comp6771::euclidean_vector{5.0, 6.0, 16.0, -1.0};
+	CHECK(comp6771::euclidean_vector(product[2]) == last_row);
+	CHECK_THROWS_AS(comp6771::multiply(a, a), std::logic_error);
+
+	auto const m = random_matrix(150, 90, 10);
+	auto const identity = comp6771::euclidean_matrix::identity(90);
+	auto const same = comp6771::multiply(m, identity);
+	for (auto r = 0; r < m.rows(); ++r) {
+		CHECK(same[r] == m[r]);
+	}
+
+	// column j of a b is a times column j of b
+	auto const n = random_matrix(90, 33, 11);
+	auto pool = comp6771::thread_pool(3);
+	auto const mn = comp6771::multiply(m, n, pool);
+	for (auto j = 0; j < n.columns(); ++j) {
+		CHECK(mn.column(j) == comp6771::euclidean_vector_view(comp6771::transform(m, n.column(j))));
+	}
+}
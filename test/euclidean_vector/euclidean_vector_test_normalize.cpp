@@ -0,0 +1,115 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "counting_default_resource.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto numbered(int dimensions) -> comp6771::euclidean_vector {
+		auto v = comp6771::euclidean_vector(dimensions);
+		for (auto i = 0; i < dimensions; ++i) {
+			v[i] = 0.5 * i - 3.0;
+		}
+		return v;
+	}
+} // namespace
+
+TEST_CASE("Unit vectors") {
+	auto const v = numbered(37);
+	auto const reciprocal = 1.0 / comp6771::euclidean_norm(v);
+
+	SECTION("unit multiplies by the reciprocal of the norm") {
+		auto const u = comp6771::unit(v);
+		for (auto i = 0; i < v.dimensions(); ++i) {
+			CHECK(u[i] == v[i] * reciprocal);
+		}
+		CHECK(comp6771::euclidean_norm(u) == Approx(1.0));
+	}
+
+	SECTION("unit allocates once") {
+		auto const resource = testing::counting_default_resource();
+		auto const u = comp6771::unit(v);
+		CHECK(resource.allocations() == 1);
+	}
+
+	SECTION("normalize scales in place") {
+		auto w = v;
+		auto const* const storage = w.data();
+		auto const resource = testing::counting_default_resource();
+		CHECK(&w.normalize() == &w);
+		CHECK(w.data() == storage);
+		CHECK(resource.allocations() == 0);
+		CHECK(w == comp6771::unit(v));
+		// a unit vector has a norm of one
+		CHECK(comp6771::euclidean_norm(w) == Approx(1.0));
+	}
+
+	SECTION("normalized copies lvalues and reuses rvalues") {
+		CHECK(v.normalized() == comp6771::unit(v));
+		auto w = v;
+		auto const* const storage = w.data();
+		auto const resource = testing::counting_default_resource();
+		auto const u = std::move(w).normalized();
+		CHECK(u.data() == storage);
+		CHECK(resource.allocations() == 0);
+		CHECK(u == comp6771::unit(v));
+	}
+
+	SECTION("Vectors without a unit vector are rejected") {
+		auto zero = comp6771::euclidean_vector(3);
+		CHECK_THROWS_WITH(zero.normalize(),
+		                  "euclidean_vector with zero euclidean normal does not have a unit vector");
+		CHECK(zero == comp6771::euclidean_vector(3));
+		CHECK_THROWS_WITH(comp6771::euclidean_vector(0).normalized(),
+		                  "euclidean_vector with no dimensions does not have a unit vector");
+	}
+}
+
+TEST_CASE("Batch normalisation") {
+	auto const vectors = std::vector<comp6771::euclidean_vector>{
+	   numbered(19),
+	   numbered(19) * -2.0,
+	   comp6771::euclidean_vector(19, 0.1),
+	};
+
+	for (auto const layout :
+	     {comp6771::batch_layout::row_major, comp6771::batch_layout::column_major}) {
+		auto batch = comp6771::euclidean_vector_batch(vectors, layout);
+		auto const units = comp6771::unit(batch);
+		auto const* const storage = batch.data();
+		comp6771::normalize(batch);
+		CHECK(batch.data() == storage);
+		for (auto i = 0; i < batch.size(); ++i) {
+			auto const normalized = static_cast<comp6771::euclidean_vector>(batch[i]);
+			CHECK(normalized == static_cast<comp6771::euclidean_vector>(units[i]));
+			auto const expected = comp6771::unit(vectors[static_cast<std::size_t>(i)]);
+			if (layout == comp6771::batch_layout::row_major) {
+				CHECK(normalized == expected);
+			}
+			for (auto j = 0; j < batch.dimensions(); ++j) {
+				CHECK(normalized[j] == Approx(expected[j]));
+			}
+		}
+
+		auto zero = comp6771::euclidean_vector_batch(2, 19, layout);
+		CHECK_THROWS_AS(comp6771::normalize(zero), std::logic_error);
+
+		// only the leading rows are normalised, and rows after them may have no unit vector
+		auto leading = comp6771::euclidean_vector_batch(vectors, layout);
+		leading[2] = comp6771::euclidean_vector(19);
+		comp6771::normalize(leading, 2);
+		CHECK(static_cast<comp6771::euclidean_vector>(leading[0])
+		      == static_cast<comp6771::euclidean_vector>(units[0]));
+		CHECK(static_cast<comp6771::euclidean_vector>(leading[1])
+		      == static_cast<comp6771::euclidean_vector>(units[1]));
+		CHECK(static_cast<comp6771::euclidean_vector>(leading[2]) == comp6771::euclidean_vector(19));
+		comp6771::normalize(leading, 0);
+		CHECK_THROWS_AS(comp6771::normalize(leading, 3), std::logic_error);
+		CHECK_THROWS_AS(comp6771::normalize(leading, 4), std::out_of_range);
+		CHECK_THROWS_AS(comp6771::normalize(leading, -1), std::out_of_range);
+	}
+}
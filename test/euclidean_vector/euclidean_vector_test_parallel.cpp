@@ -0,0 +1,123 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <atomic>
+#include <bit>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	namespace kernels = comp6771::kernels;
+
+	// ten full chunks and a partial one
+	constexpr auto size = 10 * kernels::parallel_chunk_size + 123;
+
+	auto random_magnitudes(std::size_t n, std::uint32_t seed) -> std::vector<double> {
+		auto engine = std::mt19937_64(seed);
+		auto distribution = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto magnitudes = std::vector<double>(n);
+		for (auto& magnitude : magnitudes) {
+			magnitude = distribution(engine);
+		}
+		return magnitudes;
+	}
+
+	auto bits(double x) -> std::uint64_t {
+		return std::bit_cast<std::uint64_t>(x);
+	}
+
+	// leaves the kernels serial again when a test finishes
+	struct serial_guard {
+		serial_guard() = default;
+		serial_guard(serial_guard const&) = delete;
+		serial_guard(serial_guard&&) = delete;
+		auto operator=(serial_guard const&) -> serial_guard& = delete;
+		auto operator=(serial_guard&&) -> serial_guard& = delete;
+		~serial_guard() {
+			kernels::disable_parallel_execution();
+		}
+	};
+} // namespace
+
+TEST_CASE("Thread pool") {
+	for (auto const threads : {std::size_t{1}, std::size_t{4}}) {
+		auto pool = comp6771::thread_pool(threads);
+		CHECK(pool.size() == threads);
+		auto visits = std::vector<std::atomic<int>>(1000);
+		for (auto round = 0; round < 3; ++round) {
+			pool.run(visits.size(), [&visits](std::size_t i) { ++visits[i]; });
+		}
+		for (auto const& visit : visits) {
+			CHECK(visit == 3);
+		}
+	}
+}
+
+TEST_CASE("Parallel execution") {
+	auto const guard = serial_guard();
+	auto const x = random_magnitudes(size, 1);
+	auto const y = random_magnitudes(size, 2);
+
+	SECTION("Parallel execution is opt-in") {
+		CHECK(kernels::parallel_threads() == 0);
+		kernels::enable_parallel_execution(3);
+		CHECK(kernels::parallel_threads() == 3);
+		kernels::disable_parallel_execution();
+		CHECK(kernels::parallel_threads() == 0);
+		CHECK_THROWS_AS(kernels::enable_parallel_execution(0), std::invalid_argument);
+	}
+
+	SECTION("Reductions do not depend on the number of threads") {
+		kernels::enable_parallel_execution(1, 1);
+		auto const dot = kernels::dot(x.data(), y.data(), size);
+		auto const squares = kernels::sum_of_squares(x.data(), size);
+		auto const distance = kernels::squared_distance(x.data(), y.data(), size);
+		for (auto const threads : {2, 3, 8}) {
+			kernels::enable_parallel_execution(static_cast<std::size_t>(threads), 1);
+			for (auto run = 0; run < 3; ++run) {
+				CHECK(bits(kernels::dot(x.data(), y.data(), size)) == bits(dot));
+				CHECK(bits(kernels::sum_of_squares(x.data(), size)) == bits(squares));
+				CHECK(bits(kernels::squared_distance(x.data(), y.data(), size)) == bits(distance));
+			}
+		}
+		kernels::disable_parallel_execution();
+		CHECK(kernels::dot(x.data(), y.data(), size) == Approx(dot));
+	}
+
+	SECTION("Inputs below the threshold run serially") {
+		auto const serial = kernels::dot(x.data(), y.data(), size);
+		kernels::enable_parallel_execution(4, size + 1);
+		CHECK(bits(kernels::dot(x.data(), y.data(), size)) == bits(serial));
+	}
+
+	SECTION("Element-wise kernels give the same results in parallel") {
+		auto serial = std::vector<double>(size);
+		kernels::add(serial.data(), x.data(), y.data(), size);
+		kernels::axpy(serial.data(), 0.5, x.data(), size);
+		kernels::enable_parallel_execution(4, 1);
+		auto parallel = std::vector<double>(size);
+		kernels::add(parallel.data(), x.data(), y.data(), size);
+		kernels::axpy(parallel.data(), 0.5, x.data(), size);
+		CHECK(parallel == serial);
+		kernels::copy(parallel.data(), y.data(), size);
+		CHECK(parallel == y);
+	}
+
+	SECTION("euclidean_vector operations use the parallel kernels") {
+		auto const a = comp6771::euclidean_vector(x.cbegin(), x.cend());
+		auto const b = comp6771::euclidean_vector(y.cbegin(), y.cend());
+		auto const serial_sum = comp6771::euclidean_vector(a + b + b);
+		kernels::enable_parallel_execution(4, kernels::parallel_chunk_size);
+		auto c = a;
+		CHECK(c == a);
+		c += b;
+		c += b;
+		CHECK(c == serial_sum);
+		CHECK(comp6771::dot(a, b) == Approx(kernels::dot(x.data(), y.data(), size)));
+	}
+}
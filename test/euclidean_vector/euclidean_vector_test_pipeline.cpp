@@ -0,0 +1,234 @@
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_file.hpp"
+#include "comp6771/euclidean_vector_pipeline.hpp"
+#include "random_batch.hpp"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+	auto to_file(comp6771::euclidean_vector_batch const& vectors) -> std::stringstream {
+		auto file = std::stringstream();
+		auto writer = comp6771::vector_file_writer(file, vectors.dimensions());
+		writer.write(vectors);
+		writer.finish();
+		return file;
+	}
+
+	auto same_rows(comp6771::euclidean_vector_batch const& x,
+	               comp6771::euclidean_vector_batch const& y) -> bool {
+		if (x.size() != y.size() or x.dimensions() != y.dimensions()) {
+			return false;
+		}
+		for (auto i = 0; i < x.size(); ++i) {
+			if (x[i] != y[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// a source that numbers the rows it fills, until it has filled `total` of them
+	auto counting_source(int const total) {
+		return [total, next = 0](comp6771::euclidean_vector_batch& batch) mutable {
+			auto rows = 0;
+			for (; rows < batch.size() and next < total; ++rows, ++next) {
+				batch(rows, 0) = next;
+			}
+			return rows;
+		};
+	}
+} // namespace
+
+TEST_CASE("Bounded queues") {
+	CHECK_THROWS_AS(comp6771::bounded_queue<int>(0), std::invalid_argument);
+
+	auto queue = comp6771::bounded_queue<int>(2);
+	CHECK(queue.capacity() == 2);
+	CHECK(queue.push(1));
+	CHECK(queue.push(2));
+	CHECK(queue.pop() == 1);
+	CHECK(queue.push(3));
+	CHECK(queue.pop() == 2);
+	queue.close();
+	CHECK(not queue.push(4));
+	CHECK(queue.pop() == 3);
+	CHECK(queue.pop() == std::nullopt);
+
+	SECTION("A full queue holds its producer back") {
+		auto handoff = comp6771::bounded_queue<int>(1);
+		auto pushed = std::atomic<int>(0);
+		auto producer = std::jthread([&] {
+			for (auto i = 0; i < 100; ++i) {
+				handoff.push(i);
+				++pushed;
+			}
+			handoff.close();
+		});
+		auto received = std::vector<int>();
+		while (auto const value = handoff.pop()) {
+			// the producer can be at most one value ahead of what has been popped
+			CHECK(pushed.load() <= *value + 2);
+			received.push_back(*value);
+		}
+		REQUIRE(received.size() == 100);
+		for (auto i = 0; i < 100; ++i) {
+			CHECK(received[static_cast<std::size_t>(i)] == i);
+		}
+	}
+}
+
+TEST_CASE("Scoring a stream") {
+	auto const vectors = testing::random_batch(1000, 24, 1);
+	auto const references = comp6771::euclidean_matrix(testing::random_batch(7, 24, 2));
+	auto const expected = comp6771::transform(references, comp6771::unit(vectors));
+
+	for (auto const workers : {comp6771::scoring_workers{1, 1}, comp6771::scoring_workers{3, 2}}) {
+		for (auto const batch_size : {1, 64, 999, 1000, 4096}) {
+			auto in = to_file(vectors);
+			auto reader = comp6771::vector_file_reader(in);
+			auto out = std::stringstream();
+			auto writer = comp6771::vector_file_writer(out, references.rows());
+			auto const options = comp6771::pipeline_options{.batch_size = batch_size, .batches = 3};
+			auto const report = comp6771::score_stream(reader, references, writer, workers, options);
+			writer.finish();
+			CHECK(report.vectors == 1000);
+			CHECK(report.batches.calls == (1000 + static_cast<std::uint64_t>(batch_size) - 1)
+			                                 / static_cast<std::uint64_t>(batch_size));
+			CHECK(report.batches.bytes == 1000 * 24 * sizeof(double));
+
+			auto scores = comp6771::vector_file_reader(out);
+			CHECK(same_rows(scores.read_all(), expected));
+		}
+	}
+
+	SECTION("An empty stream") {
+		auto in = to_file(comp6771::euclidean_vector_batch(0, 24));
+		auto reader = comp6771::vector_file_reader(in);
+		auto out = std::stringstream();
+		auto writer = comp6771::vector_file_writer(out, references.rows());
+		CHECK(comp6771::score_stream(reader, references, writer).vectors == 0);
+		CHECK(writer.size() == 0);
+	}
+
+	SECTION("Errors") {
+		auto in = to_file(vectors);
+		auto reader = comp6771::vector_file_reader(in);
+		auto out = std::stringstream();
+		auto narrow = comp6771::vector_file_writer(out, references.rows() - 1);
+		CHECK_THROWS_AS(comp6771::score_stream(reader, references, narrow), std::logic_error);
+		auto writer = comp6771::vector_file_writer(out, references.rows());
+		auto const mismatched = comp6771::euclidean_matrix(testing::random_batch(7, 23, 2));
+		CHECK_THROWS_AS(comp6771::score_stream(reader, mismatched, writer), std::logic_error);
+		CHECK_THROWS_AS(comp6771::score_stream(reader, references, writer, {}, {.batch_size = 0}),
+		                std::invalid_argument);
+		CHECK_THROWS_AS(comp6771::score_stream(reader, references, writer, {.unit = 0}),
+		                std::invalid_argument);
+
+		// a zero vector has no unit vector
+		auto with_zero = testing::random_batch(300, 24, 3);
+		with_zero[250] = comp6771::euclidean_vector(24);
+		auto zero_in = to_file(with_zero);
+		auto zero_reader = comp6771::vector_file_reader(zero_in);
+		auto const options = comp6771::pipeline_options{.batch_size = 16, .batches = 4};
+		CHECK_THROWS_AS(comp6771::score_stream(zero_reader, references, writer, {2, 2}, options),
+		                std::logic_error);
+	}
+}
+
+TEST_CASE("Running a pipeline") {
+	auto const options = comp6771::pipeline_options{.batch_size = 10, .batches = 4};
+
+	SECTION("Batches reach the sink in order, however the stages finish") {
+		auto const jitter = [](comp6771::pipeline_batch& batch) {
+			// later batches of every four finish first
+			std::this_thread::sleep_for(std::chrono::microseconds(200 * (3 - batch.sequence % 4)));
+			for (auto i = 0; i < batch.size; ++i) {
+				batch.results(i, 0) = 2 * batch.vectors(i, 0);
+			}
+		};
+		auto const stages = std::vector<comp6771::pipeline_stage>{{jitter, 4}};
+		auto sunk = std::vector<double>();
+		auto sequences = std::vector<std::uint64_t>();
+		auto const sink = [&](comp6771::pipeline_batch const& batch) {
+			sequences.push_back(batch.sequence);
+			for (auto i = 0; i < batch.size; ++i) {
+				sunk.push_back(batch.results(i, 0));
+			}
+		};
+		auto const report = comp6771::run_pipeline(1, 1, counting_source(95), stages, sink, options);
+		CHECK(report.vectors == 95);
+		CHECK(report.batches.calls == 10);
+		CHECK(sequences == std::vector<std::uint64_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+		REQUIRE(sunk.size() == 95);
+		for (auto i = 0; i < 95; ++i) {
+			CHECK(sunk[static_cast<std::size_t>(i)] == 2 * i);
+		}
+	}
+
+	SECTION("No more batches are in flight than were allocated") {
+		auto in_flight = std::atomic<int>(0);
+		auto most = std::atomic<int>(0);
+		auto const source = [&, count = counting_source(200)](
+		                       comp6771::euclidean_vector_batch& batch) mutable {
+			auto const now = ++in_flight;
+			most = std::max(most.load(), now);
+			return count(batch);
+		};
+		auto const pass = [](comp6771::pipeline_batch&) {};
+		auto const stages = std::vector<comp6771::pipeline_stage>{{pass, 2}, {pass, 3}};
+		auto const slow_sink = [&](comp6771::pipeline_batch const&) {
+			std::this_thread::sleep_for(std::chrono::microseconds(300));
+			--in_flight;
+		};
+		auto const report = comp6771::run_pipeline(1, 1, source, stages, slow_sink, options);
+		CHECK(report.vectors == 200);
+		CHECK(most.load() <= 4);
+	}
+
+	SECTION("Without stages") {
+		auto total = 0.0;
+		auto const sink = [&](comp6771::pipeline_batch const& batch) {
+			for (auto i = 0; i < batch.size; ++i) {
+				total += batch.vectors(i, 0);
+			}
+		};
+		auto const report = comp6771::run_pipeline(1, 0, counting_source(30), {}, sink, options);
+		CHECK(report.vectors == 30);
+		CHECK(total == 435.0);
+	}
+
+	SECTION("The first exception is rethrown") {
+		auto const fails = [](comp6771::pipeline_batch& batch) {
+			if (batch.sequence == 5) {
+				throw std::runtime_error("stage");
+			}
+		};
+		auto const stages = std::vector<comp6771::pipeline_stage>{{fails, 2}};
+		auto const sink = [](comp6771::pipeline_batch const&) {};
+		CHECK_THROWS_WITH(comp6771::run_pipeline(1, 1, counting_source(1000), stages, sink, options),
+		                  "stage");
+
+		auto const failing_sink = [](comp6771::pipeline_batch const& batch) {
+			if (batch.sequence == 2) {
+				throw std::runtime_error("sink");
+			}
+		};
+		CHECK_THROWS_WITH(
+		   comp6771::run_pipeline(1, 1, counting_source(1000), {}, failing_sink, options),
+		   "sink");
+
+		auto const overfull = [](comp6771::euclidean_vector_batch& batch) {
+			return batch.size() + 1;
+		};
+		CHECK_THROWS_AS(comp6771::run_pipeline(1, 1, overfull, {}, sink, options), std::logic_error);
+	}
+}
@@ -0,0 +1,215 @@
+#include "comp6771/basic_euclidean_vector.hpp"
+#include "comp6771/bfloat16.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "kernel_guard.hpp"
+
+#include <bit>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	namespace kernels = comp6771::kernels;
+	using comp6771::bfloat16;
+
+	auto random_magnitudes(std::size_t size, std::uint32_t seed) -> std::vector<double> {
+		auto engine = std::mt19937_64(seed);
+		auto distribution = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto magnitudes = std::vector<double>(size);
+		for (auto& magnitude : magnitudes) {
+			magnitude = distribution(engine);
+		}
+		return magnitudes;
+	}
+
+	template<typename T>
+	auto narrowed(std::vector<double> const& magnitudes) -> std::vector<T> {
+		auto result = std::vector<T>();
+		for (auto const magnitude : magnitudes) {
+			result.push_back(T(magnitude));
+		}
+		return result;
+	}
+
+	template<typename T>
+	auto widened(std::vector<T> const& elements) -> std::vector<double> {
+		auto result = std::vector<double>();
+		for (auto const element : elements) {
+			result.push_back(static_cast<double>(static_cast<float>(element)));
+		}
+		return result;
+	}
+
+	auto bits(double x) -> std::uint64_t {
+		return std::bit_cast<std::uint64_t>(x);
+	}
+} // namespace
+
+TEST_CASE("bfloat16 rounds to nearest, ties to even") {
+	CHECK(bfloat16(1.0F).bits() == 0x3f80);
+	CHECK(static_cast<float>(bfloat16(-2.5F)) == -2.5F);
+	// halfway between 1 and 1 + 2^-7, and between 1 + 2^-7 and 1 + 2^-6
+	CHECK(bfloat16(1.0F + 0x1p-8F).bits() == 0x3f80);
+	CHECK(bfloat16(1.0F + 3 * 0x1p-8F).bits() == 0x3f82);
+	// rounding to float first would make this a tie
+	CHECK(bfloat16(1.0 + 0x1p-8 + 0x1p-30).bits() == 0x3f81);
+	CHECK(bfloat16(1.0 + 0x1p-8 - 0x1p-30).bits() == 0x3f80);
+	CHECK(std::isinf(static_cast<float>(bfloat16(std::numeric_limits<float>::max()))));
+	CHECK(std::isnan(static_cast<float>(bfloat16(std::numeric_limits<double>::quiet_NaN()))));
+	CHECK(bfloat16(-0.0F) == bfloat16(0.0F));
+	CHECK(bfloat16::from_bits(0x4049).bits() == 0x4049);
+}
+
+TEST_CASE("Widening dot products equal the double dot product of the widened arrays") {
+	auto const guard = testing::kernel_guard();
+	for (auto const size : {0, 1, 15, 16, 17, 100, 1000, 4099}) {
+		auto const n = static_cast<std::size_t>(size);
+		auto const x = random_magnitudes(n, 1);
+		auto const y = random_magnitudes(n, 2);
+		auto const xf = narrowed<float>(x);
+		auto const yf = narrowed<float>(y);
+		auto const xb = narrowed<bfloat16>(x);
+		auto const yb = narrowed<bfloat16>(y);
+		auto const float_dot = kernels::dot(widened(xf).data(), widened(yf).data(), n);
+		auto const bfloat16_dot = kernels::dot(widened(xb).data(), widened(yb).data(), n);
+		for (auto const level : testing::simd_levels()) {
+			kernels::set_simd_level(level);
+			CHECK(bits(kernels::dot(xf.data(), yf.data(), n)) == bits(float_dot));
+			CHECK(bits(kernels::dot(xb.data(), yb.data(), n)) == bits(bfloat16_dot));
+		}
+	}
+}
+
+TEST_CASE("int8 dot products are exact") {
+	auto const guard = testing::kernel_guard();
+
+	SECTION("At every SIMD level") {
+		auto engine = std::mt19937(3);
+		auto distribution = std::uniform_int_distribution<int>(-128, 127);
+		for (auto const size : {0, 1, 15, 16, 17, 100, 1000, 4099}) {
+			auto const n = static_cast<std::size_t>(size);
+			auto x = std::vector<std::int8_t>(n);
+			auto y = std::vector<std::int8_t>(n);
+			auto expected = std::int64_t{0};
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				x[i] = static_cast<std::int8_t>(distribution(engine));
+				y[i] = static_cast<std::int8_t>(distribution(engine));
+				expected += x[i] * y[i];
+			}
+			for (auto const level : testing::simd_levels()) {
+				kernels::set_simd_level(level);
+				CHECK(kernels::dot(x.data(), y.data(), n) == expected);
+			}
+		}
+	}
+
+	SECTION("Without overflowing the 32-bit lanes") {
+		constexpr auto size = (std::size_t{1} << 20) + 5;
+		auto const x = std::vector<std::int8_t>(size, -128);
+		auto const expected = static_cast<std::int64_t>(size) * 128 * 128;
+		for (auto const level : testing::simd_levels()) {
+			kernels::set_simd_level(level);
+			CHECK(kernels::dot(x.data(), x.data(), size) == expected);
+		}
+	}
+}
+
+TEST_CASE("Reduced-precision vectors") {
+	auto const magnitudes = random_magnitudes(100, 4);
+	auto const others = random_magnitudes(100, 5);
+	auto const v = comp6771::euclidean_vector(comp6771::euclidean_vector_view(magnitudes));
+	auto const w = comp6771::euclidean_vector(comp6771::euclidean_vector_view(others));
+
+	SECTION("float and bfloat16 vectors round each magnitude") {
+		auto const f = comp6771::float_euclidean_vector(v);
+		auto const b = comp6771::bfloat16_euclidean_vector(v);
+		REQUIRE(f.dimensions() == 100);
+		REQUIRE(b.dimensions() == 100);
+		for (auto i = 0; i < 100; ++i) {
+			CHECK(f[i] == static_cast<double>(static_cast<float>(v[i])));
+			CHECK(f[i] == Approx(v[i]).epsilon(0x1p-24));
+			CHECK(b[i] == Approx(v[i]).epsilon(0x1p-8));
+		}
+		CHECK(f.scale() == 1.0);
+		CHECK(f.zero_point() == 0);
+	}
+
+	SECTION("dot and euclidean_norm match the converted vectors") {
+		auto const f = comp6771::float_euclidean_vector(v);
+		auto const g = comp6771::float_euclidean_vector(w);
+		auto const widened_f = static_cast<comp6771::euclidean_vector>(f);
+		CHECK(bits(comp6771::dot(f, g))
+		      == bits(comp6771::dot(widened_f, static_cast<comp6771::euclidean_vector>(g))));
+		CHECK(bits(comp6771::euclidean_norm(f)) == bits(comp6771::euclidean_norm(widened_f)));
+		CHECK(comp6771::dot(f, g) == Approx(comp6771::dot(v, w)).epsilon(1e-6));
+
+		auto const b = comp6771::bfloat16_euclidean_vector(v);
+		CHECK(comp6771::euclidean_norm(b) == Approx(comp6771::euclidean_norm(v)).epsilon(1e-2));
+	}
+
+	SECTION("int8 vectors are quantised to within half a step") {
+		auto const q = comp6771::int8_euclidean_vector(v);
+		auto const quantization = comp6771::quantization::fit(v);
+		CHECK(q.quantization() == quantization);
+		CHECK(q.scale() > 0);
+		for (auto i = 0; i < 100; ++i) {
+			CHECK(std::abs(q[i] - v[i]) <= q.scale() / 2 * (1 + 1e-9));
+		}
+
+		auto const with_zero = comp6771::euclidean_vector{0.0, 2.5, -1.0};
+		auto const z = comp6771::int8_euclidean_vector(with_zero);
+		CHECK(z[0] == 0.0);
+		CHECK(z.at(1) == Approx(2.5).margin(z.scale() / 2));
+		CHECK(z.at(2) == Approx(-1.0).margin(z.scale() / 2));
+		CHECK_THROWS_AS(z.at(3), std::out_of_range);
+	}
+
+	SECTION("int8 dot products remove the zero points") {
+		auto const q = comp6771::int8_euclidean_vector(v);
+		auto const r = comp6771::int8_euclidean_vector(w);
+		auto const expected = comp6771::dot(static_cast<comp6771::euclidean_vector>(q),
+		                                    static_cast<comp6771::euclidean_vector>(r));
+		CHECK(comp6771::dot(q, r) == Approx(expected).epsilon(1e-12));
+		CHECK(comp6771::dot(q, r) == Approx(comp6771::dot(v, w)).margin(0.1));
+		CHECK(comp6771::euclidean_norm(q) == Approx(comp6771::euclidean_norm(v)).epsilon(1e-2));
+	}
+
+	SECTION("Explicit quantisation parameters clamp what they do not cover") {
+		auto const parameters = comp6771::quantization{0.5, 0};
+		auto const nan = std::numeric_limits<double>::quiet_NaN();
+		auto const q = comp6771::int8_euclidean_vector(comp6771::euclidean_vector{1.0, 1000.0, nan},
+		                                               parameters);
+		CHECK(q[0] == 1.0);
+		CHECK(q[1] == 127 * 0.5);
+		CHECK(q[2] == 0.0);
+		CHECK(q.element_sum() == 2 + 127);
+	}
+
+	SECTION("Conversions between precisions") {
+		auto const b = comp6771::bfloat16_euclidean_vector(v);
+		auto const f = comp6771::float_euclidean_vector(b);
+		for (auto i = 0; i < 100; ++i) {
+			CHECK(f[i] == b[i]);
+		}
+		CHECK(comp6771::bfloat16_euclidean_vector(f) == b);
+		auto const q = comp6771::int8_euclidean_vector(f);
+		CHECK(q == comp6771::int8_euclidean_vector(comp6771::euclidean_vector_view(widened(
+		              std::vector<bfloat16>(b.data(), b.data() + b.dimensions())))));
+		CHECK(comp6771::float_euclidean_vector(3).dimensions() == 3);
+		CHECK(comp6771::int8_euclidean_vector()[0] == 0.0);
+	}
+
+	SECTION("Errors") {
+		auto const f = comp6771::float_euclidean_vector(v);
+		CHECK_THROWS_AS(comp6771::dot(f, comp6771::float_euclidean_vector(3)), std::logic_error);
+		CHECK_THROWS_AS(comp6771::euclidean_norm(comp6771::int8_euclidean_vector(0)),
+		                std::logic_error);
+	}
+}
@@ -0,0 +1,106 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "counting_default_resource.hpp"
+
+#include <catch2/catch.hpp>
+#include <utility>
+
+namespace {
+	constexpr auto large = comp6771::euclidean_vector::inline_capacity * 8;
+
+	auto numbered(int dimensions) -> comp6771::euclidean_vector {
+		auto v = comp6771::euclidean_vector(dimensions);
+		for (auto i = 0; i < dimensions; ++i) {
+			v[i] = 1.0 + i;
+		}
+		return v;
+	}
+} // namespace
+
+TEST_CASE("Assignment reuses storage") {
+	// installed first, so that every vector below shares its resource
+	auto const resource = testing::counting_default_resource();
+	auto const x = numbered(large);
+	auto const half = numbered(large / 2);
+	auto acc = comp6771::euclidean_vector(large, 1.0);
+	auto const* const storage = acc.data();
+	auto const before = resource.allocations();
+
+	SECTION("Steady-state expression loops make no heap calls") {
+		for (auto i = 0; i < 100; ++i) {
+			acc = acc + x;
+			acc = acc * 0.5 - x / 4.0;
+			acc += x;
+		}
+		CHECK(resource.allocations() == before);
+		CHECK(acc.data() == storage);
+	}
+
+	SECTION("Copy assignment copies into existing storage") {
+		acc = x;
+		CHECK(acc == x);
+		acc = half;
+		CHECK(acc == half);
+		CHECK(acc.data() == storage);
+		CHECK(resource.allocations() == before);
+	}
+
+	SECTION("Move assignment takes over the source's storage") {
+		auto source = numbered(large);
+		auto const* const moved = source.data();
+		auto const allocated = resource.allocations();
+		acc = std::move(source);
+		CHECK(acc.data() == moved);
+		CHECK(resource.allocations() == allocated);
+	}
+}
+
+TEST_CASE("Operators reuse temporaries") {
+	auto const x = numbered(large);
+	auto const expected = comp6771::euclidean_vector((x + x) * 2.0 - x);
+
+	SECTION("A temporary left operand becomes the result") {
+		auto temporary = comp6771::euclidean_vector(x);
+		auto const* const storage = temporary.data();
+		auto const resource = testing::counting_default_resource();
+		auto const result = comp6771::euclidean_vector((std::move(temporary) + x) * 2.0 - x);
+		CHECK(result.data() == storage);
+		CHECK(resource.allocations() == 0);
+		CHECK(result == expected);
+	}
+
+	SECTION("A temporary right operand becomes the result") {
+		auto const resource = testing::counting_default_resource();
+		comp6771::euclidean_vector result = x - numbered(large) / 2.0;
+		CHECK(resource.allocations() == 1);
+		CHECK(result == comp6771::euclidean_vector(x / 2.0));
+	}
+
+	SECTION("Assigning an expression of a different size takes the temporary's storage") {
+		auto acc = comp6771::euclidean_vector(3);
+		auto temporary = comp6771::euclidean_vector(x);
+		auto const* const storage = temporary.data();
+		auto const resource = testing::counting_default_resource();
+		acc = std::move(temporary) * 3.0;
+		CHECK(acc.data() == storage);
+		CHECK(resource.allocations() == 0);
+		CHECK(acc == comp6771::euclidean_vector(x * 3.0));
+	}
+
+	SECTION("Negating a temporary does not copy it") {
+		auto temporary = comp6771::euclidean_vector(x);
+		auto const* const storage = temporary.data();
+		auto const resource = testing::counting_default_resource();
+		auto const negated = -std::move(temporary);
+		CHECK(negated.data() == storage);
+		CHECK(resource.allocations() == 0);
+		CHECK(negated == x * -1.0);
+		CHECK(-x == negated);
+		CHECK(-negated == x);
+	}
+
+	SECTION("Lvalue operands are never modified") {
+		auto const result = comp6771::euclidean_vector(x + x);
+		CHECK(result == x * 2.0);
+		CHECK(x == numbered(large));
+	}
+}
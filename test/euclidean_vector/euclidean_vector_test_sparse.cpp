@@ -0,0 +1,160 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/sparse_euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	// `non_zeros` distinct random indices of `dimensions`, with random magnitudes
+	auto random_sparse(int dimensions, int non_zeros, std::uint32_t seed)
+	   -> comp6771::sparse_euclidean_vector {
+		auto engine = std::mt19937(seed);
+		auto index = std::uniform_int_distribution<int>(0, dimensions - 1);
+		auto magnitude = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto dense = std::vector<double>(static_cast<std::size_t>(dimensions));
+		for (auto placed = 0; placed < non_zeros;) {
+			auto& slot = dense[static_cast<std::size_t>(index(engine))];
+			if (slot == 0) {
+				slot = magnitude(engine);
+				++placed;
+			}
+		}
+		return comp6771::sparse_euclidean_vector(comp6771::euclidean_vector_view(dense));
+	}
+
+	// the dot product of the dense vectors, summed in index order like the sparse one
+	auto ordered_dot(std::vector<double> const& x, std::vector<double> const& y) -> double {
+		auto sum = 0.0;
+		for (auto i = std::size_t{0}; i < x.size(); ++i) {
+			if (x[i] != 0 and y[i] != 0) {
+				sum += x[i] * y[i];
+			}
+		}
+		return sum;
+	}
+} // namespace
+
+TEST_CASE("Sparse vectors store their non-zero magnitudes") {
+	SECTION("Construction") {
+		auto const indices = std::vector<int>{7, 2, 7, 4, 9};
+		auto const values = std::vector<double>{1.0, 2.0, 3.0, -5.0, 0.0};
+		auto const v = comp6771::sparse_euclidean_vector(10, indices, values);
+		CHECK(v.dimensions() == 10);
+		CHECK(v.non_zeros() == 3);
+		CHECK(std::vector<int>(v.indices().begin(), v.indices().end()) == std::vector<int>{2, 4, 7});
+		CHECK(v[7] == 4.0);
+		CHECK(v[4] == -5.0);
+		CHECK(v[0] == 0.0);
+		CHECK(v.at(9) == 0.0);
+		CHECK_THROWS_AS(v.at(10), std::out_of_range);
+		CHECK_THROWS_AS(v.at(-1), std::out_of_range);
+
+		CHECK(comp6771::sparse_euclidean_vector().dimensions() == 1);
+		CHECK(comp6771::sparse_euclidean_vector(1'000'000).non_zeros() == 0);
+
+		auto const out_of_range = std::vector<int>{10};
+		auto const one = std::vector<double>{1.0};
+		CHECK_THROWS_AS(comp6771::sparse_euclidean_vector(10, out_of_range, one), std::out_of_range);
+		CHECK_THROWS_AS(comp6771::sparse_euclidean_vector(10, indices, one), std::logic_error);
+	}
+
+	SECTION("Conversions to and from euclidean_vector") {
+		auto const dense = comp6771::euclidean_vector{0.0, 1.5, 0.0, 0.0, -2.0};
+		auto const sparse = comp6771::sparse_euclidean_vector(dense);
+		CHECK(sparse.non_zeros() == 2);
+		CHECK(static_cast<comp6771::euclidean_vector>(sparse) == dense);
+		CHECK(static_cast<std::vector<double>>(sparse) == static_cast<std::vector<double>>(dense));
+
+		auto os = std::ostringstream();
+		os << sparse;
+		CHECK(os.str() == "[0 1.5 0 0 -2]");
+	}
+
+	SECTION("Arithmetic") {
+		auto const x = comp6771::sparse_euclidean_vector(comp6771::euclidean_vector{1, 0, 2, 0, 3});
+		auto const y = comp6771::sparse_euclidean_vector(comp6771::euclidean_vector{0, 4, -2, 0, 5});
+		CHECK(static_cast<comp6771::euclidean_vector>(x + y)
+		      == comp6771::euclidean_vector{1, 4, 0, 0, 8});
+		// cancelled magnitudes are dropped
+		CHECK((x + y).non_zeros() == 3);
+		CHECK(static_cast<comp6771::euclidean_vector>(x - y)
+		      == comp6771::euclidean_vector{1, -4, 4, 0, -2});
+		CHECK((x - x).non_zeros() == 0);
+		CHECK(static_cast<comp6771::euclidean_vector>(-x)
+		      == comp6771::euclidean_vector{-1, 0, -2, 0, -3});
+		CHECK(static_cast<comp6771::euclidean_vector>(2 * x / 4.0)
+		      == comp6771::euclidean_vector{0.5, 0, 1, 0, 1.5});
+		CHECK((x * 0.0).non_zeros() == 0);
+		CHECK((x * 0.0) == comp6771::sparse_euclidean_vector(5));
+
+		auto z = x;
+		z += y;
+		z -= y;
+		CHECK(z == x);
+		CHECK_THROWS_AS(z /= 0, std::logic_error);
+		CHECK_THROWS_AS(z += comp6771::sparse_euclidean_vector(4), std::logic_error);
+	}
+}
+
+TEST_CASE("Sparse dot products and norms") {
+	constexpr auto dimensions = 100'000;
+
+	SECTION("Merging and galloping find the same intersection") {
+		auto const x = random_sparse(dimensions, 300, 1);
+		auto const y = random_sparse(dimensions, 5'000, 2);
+		auto const z = random_sparse(dimensions, 400, 3);
+		auto const dense_x = static_cast<std::vector<double>>(x);
+		auto const dense_y = static_cast<std::vector<double>>(y);
+		auto const dense_z = static_cast<std::vector<double>>(z);
+		// 5000 >= 16 * 300, so these gallop
+		CHECK(comp6771::dot(x, y) == ordered_dot(dense_x, dense_y));
+		CHECK(comp6771::dot(y, x) == ordered_dot(dense_x, dense_y));
+		// and these merge
+		CHECK(comp6771::dot(x, z) == ordered_dot(dense_x, dense_z));
+		CHECK(comp6771::dot(x, x) == ordered_dot(dense_x, dense_x));
+		CHECK(comp6771::dot(x, y) == Approx(comp6771::dot(dense_x, dense_y)));
+	}
+
+	SECTION("Sparse-dense dot products") {
+		auto const x = random_sparse(dimensions, 300, 4);
+		auto const y = random_sparse(dimensions, 20'000, 5);
+		auto const dense_y = static_cast<std::vector<double>>(y);
+		auto const expected = ordered_dot(static_cast<std::vector<double>>(x), dense_y);
+		CHECK(comp6771::dot(x, comp6771::euclidean_vector_view(dense_y)) == expected);
+		CHECK(comp6771::dot(comp6771::euclidean_vector_view(dense_y), x) == expected);
+		CHECK(comp6771::dot(x, static_cast<comp6771::euclidean_vector>(y)) == expected);
+
+		auto target = dense_y;
+		comp6771::axpy(2.0, x, target);
+		for (auto const index : x.indices()) {
+			auto const i = static_cast<std::size_t>(index);
+			CHECK(target[i] == dense_y[i] + 2.0 * x[index]);
+		}
+	}
+
+	SECTION("Norms") {
+		auto const x = random_sparse(dimensions, 300, 6);
+		CHECK(comp6771::euclidean_norm(x)
+		      == Approx(comp6771::euclidean_norm(static_cast<comp6771::euclidean_vector>(x))));
+		CHECK(comp6771::euclidean_norm(comp6771::sparse_euclidean_vector(3)) == 0.0);
+		CHECK_THROWS_AS(comp6771::euclidean_norm(comp6771::sparse_euclidean_vector(0)),
+		                std::logic_error);
+	}
+
+	SECTION("Dimension mismatches throw what euclidean_vector throws") {
+		auto const x = comp6771::sparse_euclidean_vector(3);
+		auto const dense = comp6771::euclidean_vector(4);
+		CHECK_THROWS_WITH(comp6771::dot(x, comp6771::sparse_euclidean_vector(4)),
+		                  "Dimensions of LHS(3) and RHS(4) do not match");
+		CHECK_THROWS_WITH(comp6771::dot(x, dense), "Dimensions of LHS(3) and RHS(4) do not match");
+		CHECK_THROWS_AS(comp6771::dot(dense, x), std::logic_error);
+		auto target = std::vector<double>(4);
+		CHECK_THROWS_AS(comp6771::axpy(1.0, x, target), std::logic_error);
+	}
+}
@@ -0,0 +1,206 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_file.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/euclidean_vector_statistics.hpp"
+#include "comp6771/thread_pool.hpp"
+#include "kernel_guard.hpp"
+#include "random_batch.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	namespace kernels = comp6771::kernels;
+	using kernels::simd_level;
+
+	// magnitudes normally distributed about 5
+	auto random_batch(int size, int dimensions, unsigned seed) -> comp6771::euclidean_vector_batch {
+		auto const magnitude = std::normal_distribution<double>(5.0, 2.0);
+		return testing::random_batch(size, dimensions, seed, magnitude);
+	}
+
+	auto same(comp6771::vector_statistics const& x, comp6771::vector_statistics const& y) -> bool {
+		return x.count() == y.count() and x.sum() == y.sum() and x.mean() == y.mean()
+		       and x.variance() == y.variance() and x.min() == y.min() and x.max() == y.max()
+		       and x.histogram() == y.histogram();
+	}
+
+	auto close(comp6771::euclidean_vector const& x, comp6771::euclidean_vector const& y) -> bool {
+		return comp6771::approx_equal(x, y, 0.0, 1e-12);
+	}
+} // namespace
+
+TEST_CASE("Statistics of a few vectors") {
+	auto statistics = comp6771::vector_statistics(2);
+	statistics.add(comp6771::euclidean_vector{1.0, 2.0});
+	statistics.add(comp6771::euclidean_vector{3.0, 4.0});
+	statistics.add(comp6771::euclidean_vector{5.0, 0.0});
+	CHECK(statistics.count() == 3);
+	CHECK(statistics.dimensions() == 2);
+	CHECK(statistics.sum() == comp6771::euclidean_vector{9.0, 6.0});
+	CHECK(statistics.mean() == comp6771::euclidean_vector{3.0, 2.0});
+	CHECK(statistics.min() == comp6771::euclidean_vector{1.0, 0.0});
+	CHECK(statistics.max() == comp6771::euclidean_vector{5.0, 4.0});
+	CHECK(close(statistics.variance(), comp6771::euclidean_vector{8.0 / 3, 8.0 / 3}));
+	CHECK(close(statistics.sample_variance(), comp6771::euclidean_vector{4.0, 4.0}));
+
+	SECTION("Welford's method survives a large mean") {
+		auto shifted = comp6771::vector_statistics(1);
+		for (auto const x : {4.0, 7.0, 13.0, 16.0}) {
+			shifted.add(comp6771::euclidean_vector{1e9 + x});
+		}
+		CHECK(shifted.variance()[0] == Approx(22.5));
+		CHECK(shifted.sample_variance()[0] == Approx(30.0));
+	}
+
+	SECTION("Minimums and maximums ignore NaNs") {
+		auto const nan_vector = comp6771::euclidean_vector{std::numeric_limits<double>::quiet_NaN()};
+		auto with_nan = comp6771::vector_statistics(1);
+		with_nan.add(comp6771::euclidean_vector{2.0});
+		with_nan.add(nan_vector);
+		with_nan.add(comp6771::euclidean_vector{-1.0});
+		CHECK(with_nan.min()[0] == -1.0);
+		CHECK(with_nan.max()[0] == 2.0);
+	}
+
+	SECTION("Strided views and ranges") {
+		auto const magnitudes = std::vector<double>{1.0, 9.0, 2.0};
+		auto strided = comp6771::vector_statistics(2);
+		strided.add(comp6771::euclidean_vector_view(magnitudes.data(), 2, 2));
+		CHECK(strided.sum() == comp6771::euclidean_vector{1.0, 2.0});
+
+		auto const vectors =
+		   std::vector<comp6771::euclidean_vector>{{1.0, 2.0}, {3.0, 4.0}, {5.0, 0.0}};
+		auto from_range = comp6771::vector_statistics(2);
+		from_range.add(vectors);
+		CHECK(same(from_range, statistics));
+
+		// an input range computed on demand, as a stream source would be
+		auto generated = comp6771::vector_statistics(2);
+		generated.add(std::views::iota(0, 3) | std::views::transform([&](int i) {
+			              return vectors[static_cast<std::size_t>(i)];
+		              }));
+		CHECK(same(generated, statistics));
+	}
+
+	SECTION("Errors") {
+		CHECK_THROWS_AS(statistics.add(comp6771::euclidean_vector(3)), std::logic_error);
+		auto const empty = comp6771::vector_statistics(2);
+		CHECK(empty.sum() == comp6771::euclidean_vector(2));
+		CHECK_THROWS_AS(empty.mean(), std::logic_error);
+		CHECK_THROWS_AS(empty.min(), std::logic_error);
+		CHECK_THROWS_AS(empty.variance(), std::logic_error);
+		auto one = comp6771::vector_statistics(2);
+		one.add(comp6771::euclidean_vector(2));
+		CHECK(one.variance() == comp6771::euclidean_vector(2));
+		CHECK_THROWS_AS(one.sample_variance(), std::logic_error);
+		CHECK_THROWS_AS(comp6771::vector_statistics(2, {.bins = -1}), std::invalid_argument);
+		CHECK_THROWS_AS(comp6771::vector_statistics(2, {.bins = 4, .low = 1.0, .high = 1.0}),
+		                std::invalid_argument);
+	}
+}
+
+TEST_CASE("Welford steps agree at every SIMD level") {
+	auto const guard = testing::kernel_guard();
+	auto const vectors = random_batch(100, 37, 1);
+	kernels::set_simd_level(simd_level::scalar);
+	auto expected = comp6771::vector_statistics(37);
+	expected.add(vectors);
+	for (auto const level : testing::simd_levels()) {
+		kernels::set_simd_level(level);
+		auto statistics = comp6771::vector_statistics(37);
+		statistics.add(vectors);
+		CHECK(same(statistics, expected));
+	}
+}
+
+TEST_CASE("Norm histograms") {
+	auto const options = comp6771::norm_histogram_options{.bins = 3, .low = 1.0, .high = 4.0};
+	auto statistics = comp6771::vector_statistics(2, options);
+	for (auto const norm : {0.5, 1.0, 1.5, 2.9, 3.999, 4.0, 10.0}) {
+		statistics.add(comp6771::euclidean_vector{0.0, norm});
+	}
+	statistics.add(comp6771::euclidean_vector{std::numeric_limits<double>::quiet_NaN(), 0.0});
+	auto const& histogram = statistics.histogram();
+	CHECK(histogram.low == 1.0);
+	CHECK(histogram.high == 4.0);
+	CHECK(histogram.counts == std::vector<std::uint64_t>{2, 1, 1});
+	CHECK(histogram.below == 1);
+	CHECK(histogram.above == 3);
+	CHECK(comp6771::vector_statistics(2).histogram().counts.empty());
+}
+
+TEST_CASE("Merging partial statistics") {
+	auto const options = comp6771::norm_histogram_options{.bins = 8, .low = 0.0, .high = 80.0};
+	auto const vectors = random_batch(1000, 21, 2);
+	auto whole = comp6771::vector_statistics(21, options);
+	whole.add(vectors);
+
+	auto first = comp6771::vector_statistics(21, options);
+	auto second = comp6771::vector_statistics(21, options);
+	for (auto i = 0; i < vectors.size(); ++i) {
+		(i < 300 ? first : second).add(vectors[i]);
+	}
+	first.merge(second);
+	CHECK(first.count() == whole.count());
+	CHECK(close(first.sum(), whole.sum()));
+	CHECK(close(first.mean(), whole.mean()));
+	CHECK(comp6771::approx_equal(first.variance(), whole.variance(), 0.0, 1e-10));
+	CHECK(first.min() == whole.min());
+	CHECK(first.max() == whole.max());
+	CHECK(first.histogram() == whole.histogram());
+
+	// merging with nothing changes nothing, either way around
+	auto empty = comp6771::vector_statistics(21, options);
+	auto const before = whole;
+	whole.merge(empty);
+	CHECK(same(whole, before));
+	empty.merge(whole);
+	CHECK(same(empty, whole));
+
+	CHECK_THROWS_AS(whole.merge(comp6771::vector_statistics(20, options)), std::logic_error);
+	CHECK_THROWS_AS(whole.merge(comp6771::vector_statistics(21)), std::logic_error);
+	auto const other_range = comp6771::norm_histogram_options{.bins = 8, .low = 0.0, .high = 1.0};
+	CHECK_THROWS_AS(whole.merge(comp6771::vector_statistics(21, other_range)), std::logic_error);
+}
+
+TEST_CASE("Describing batches and files") {
+	auto const options = comp6771::norm_histogram_options{.bins = 16, .low = 0.0, .high = 60.0};
+	// three chunks, the last of them partial
+	auto const size = static_cast<int>(2 * comp6771::statistics_chunk_size + 17);
+	auto const vectors = random_batch(size, 9, 3);
+	auto pool = comp6771::thread_pool(3);
+
+	auto const serial = comp6771::describe(vectors, options);
+	CHECK(serial.count() == static_cast<std::uint64_t>(size));
+	CHECK(same(comp6771::describe(vectors, options, pool), serial));
+	CHECK(same(comp6771::describe(vectors.to_layout(comp6771::batch_layout::column_major), options),
+	           serial));
+
+	auto one_at_a_time = comp6771::vector_statistics(9, options);
+	one_at_a_time.add(vectors);
+	CHECK(close(serial.mean(), one_at_a_time.mean()));
+	CHECK(serial.min() == one_at_a_time.min());
+	CHECK(serial.histogram() == one_at_a_time.histogram());
+
+	auto file = std::stringstream();
+	{
+		auto writer = comp6771::vector_file_writer(file, 9);
+		writer.write(vectors);
+	}
+	auto reader = comp6771::vector_file_reader(file);
+	CHECK(same(comp6771::describe(reader, options), serial));
+	file.clear();
+	file.seekg(0);
+	auto threaded_reader = comp6771::vector_file_reader(file);
+	CHECK(same(comp6771::describe(threaded_reader, options, pool), serial));
+
+	CHECK(comp6771::describe(comp6771::euclidean_vector_batch(0, 4)).count() == 0);
+}
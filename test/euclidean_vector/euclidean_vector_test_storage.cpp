@@ -0,0 +1,81 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <functional>
+#include <utility>
+
+namespace {
+	// true when the magnitudes live inside the object itself rather than on the heap
+	auto stored_inline(comp6771::euclidean_vector const& v) -> bool {
+		auto const* first = static_cast<void const*>(&v);
+		auto const* last = static_cast<void const*>(&v + 1);
+		auto const* magnitudes = static_cast<void const*>(v.data());
+		return std::less_equal<>{}(first, magnitudes) and std::less<>{}(magnitudes, last);
+	}
+} // namespace
+
+TEST_CASE("Small-buffer storage") {
+	constexpr auto small = comp6771::euclidean_vector::inline_capacity;
+
+	SECTION("Small vectors are stored inline and large ones on the heap") {
+		CHECK(stored_inline(comp6771::euclidean_vector()));
+		CHECK(stored_inline(comp6771::euclidean_vector(small, 1.0)));
+		CHECK(not stored_inline(comp6771::euclidean_vector(small + 1, 1.0)));
+		CHECK(stored_inline(comp6771::euclidean_vector{1, 2, 3}));
+	}
+
+	SECTION("Moving an inline vector copies its magnitudes") {
+		auto a = comp6771::euclidean_vector{1, 2, 3};
+		auto b = std::move(a);
+		CHECK(fmt::format("{}", b) == "[1 2 3]");
+		CHECK(stored_inline(b));
+		CHECK(a.dimensions() == 0); // NOLINT(bugprone-use-after-move)
+	}
+
+	SECTION("Moving a heap vector steals its storage") {
+		auto a = comp6771::euclidean_vector(small + 2, 2.5);
+		auto const* const magnitudes = a.data();
+		auto b = std::move(a);
+		CHECK(b.data() == magnitudes);
+		CHECK(b == comp6771::euclidean_vector(small + 2, 2.5));
+	}
+
+	SECTION("Move assignment between size classes") {
+		auto small_vector = comp6771::euclidean_vector{1, 2};
+		auto large_vector = comp6771::euclidean_vector(small + 4, 7.0);
+
+		small_vector = std::move(large_vector);
+		CHECK(small_vector == comp6771::euclidean_vector(small + 4, 7.0));
+
+		auto other = comp6771::euclidean_vector{3, 4};
+		small_vector = std::move(other);
+		CHECK(fmt::format("{}", small_vector) == "[3 4]");
+		CHECK(stored_inline(small_vector));
+
+		auto& alias = small_vector;
+		small_vector = std::move(alias);
+		CHECK(fmt::format("{}", small_vector) == "[3 4]");
+	}
+
+	SECTION("Copies are independent in both size classes") {
+		for (auto const dimensions : {small, small + 1}) {
+			auto a = comp6771::euclidean_vector(dimensions, 1.0);
+			auto b = a;
+			b[0] = 5.0;
+			CHECK(a[0] == 1.0);
+			CHECK(b[0] == 5.0);
+			a = b;
+			CHECK(a == b);
+		}
+	}
+
+	SECTION("Arithmetic works across the boundary") {
+		auto const a = comp6771::euclidean_vector(small, 1.0);
+		auto const b = comp6771::euclidean_vector(small + 1, 1.0);
+		CHECK(comp6771::euclidean_vector(a + a) == comp6771::euclidean_vector(small, 2.0));
+		CHECK(comp6771::euclidean_vector(b * 3.0) == comp6771::euclidean_vector(small + 1, 3.0));
+		CHECK(comp6771::dot(b, b) == small + 1);
+	}
+}
@@ -0,0 +1,101 @@
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Views over existing buffers") {
+	auto const magnitudes = std::vector<double>{3.0, 4.0, 12.0, 0.5, -2.0, 7.25};
+	auto const owned = comp6771::euclidean_vector(magnitudes.cbegin(), magnitudes.cend());
+	auto const view = comp6771::euclidean_vector_view(magnitudes);
+
+	SECTION("A view refers to the buffer without copying it") {
+		CHECK(view.data() == magnitudes.data());
+		CHECK(view.dimensions() == 6);
+		CHECK(view[2] == 12.0);
+		CHECK(comp6771::euclidean_vector_view(std::span(magnitudes)).data() == magnitudes.data());
+		CHECK(comp6771::euclidean_vector_view(owned).data() == owned.data());
+	}
+
+	SECTION("Utility functions give the same results as for an owning vector") {
+		CHECK(comp6771::euclidean_norm(view) == comp6771::euclidean_norm(owned));
+		CHECK(comp6771::dot(view, owned) == comp6771::dot(owned, owned));
+		CHECK(comp6771::unit(view) == comp6771::unit(owned));
+	}
+
+	SECTION("Views take part in arithmetic expressions") {
+		auto const sum = comp6771::euclidean_vector(view + owned);
+		CHECK(sum == comp6771::euclidean_vector(owned * 2.0));
+		auto const scaled = comp6771::euclidean_vector(view * 3.0 - view / 2.0);
+		CHECK(scaled == comp6771::euclidean_vector(owned * 3.0 - owned / 2.0));
+		CHECK(static_cast<comp6771::euclidean_vector>(view) == owned);
+	}
+
+	SECTION("Views compare by magnitude") {
+		CHECK(view == owned);
+		CHECK(owned == view);
+		CHECK(view != comp6771::euclidean_vector(6));
+		CHECK(view != comp6771::euclidean_vector_view(magnitudes.data(), 5));
+	}
+
+	SECTION("Strided views skip magnitudes") {
+		auto const every_other = comp6771::euclidean_vector_view(magnitudes.data(), 3, 2);
+		auto const expected = comp6771::euclidean_vector{3.0, 12.0, -2.0};
+		CHECK(not every_other.is_contiguous());
+		CHECK(every_other == expected);
+		CHECK(comp6771::dot(every_other, expected) == comp6771::dot(expected, expected));
+		CHECK(comp6771::euclidean_norm(every_other) == comp6771::euclidean_norm(expected));
+		CHECK(comp6771::euclidean_vector(every_other + expected)
+		      == comp6771::euclidean_vector(expected * 2.0));
+		CHECK(static_cast<std::vector<double>>(every_other) == std::vector<double>{3.0, 12.0, -2.0});
+	}
+
+	SECTION("Mismatched dimensions are rejected") {
+		auto const shorter = comp6771::euclidean_vector_view(magnitudes.data(), 4);
+		CHECK_THROWS_AS(comp6771::dot(view, shorter), std::logic_error);
+		CHECK_THROWS_AS(view + shorter, std::logic_error);
+		CHECK_THROWS_AS(comp6771::euclidean_norm(comp6771::euclidean_vector_view(nullptr, 0)),
+		                std::logic_error);
+	}
+}
+
+TEST_CASE("Mutable references") {
+	auto buffer = std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+	auto ref = comp6771::euclidean_vector_ref(buffer);
+
+	SECTION("Assignment writes through to the buffer") {
+		auto const other = comp6771::euclidean_vector(6, 0.5);
+		ref = other;
+		CHECK(buffer == std::vector<double>(6, 0.5));
+		ref = ref * 4.0 + other;
+		CHECK(buffer == std::vector<double>(6, 2.5));
+		CHECK_THROWS_AS(ref = comp6771::euclidean_vector(5), std::logic_error);
+	}
+
+	SECTION("Compound assignment updates in place") {
+		ref += comp6771::euclidean_vector(6, 1.0);
+		CHECK(buffer == std::vector<double>{2.0, 3.0, 4.0, 5.0, 6.0, 7.0});
+		ref -= comp6771::euclidean_vector_view(buffer);
+		CHECK(buffer == std::vector<double>(6, 0.0));
+		ref = comp6771::euclidean_vector(6, 3.0);
+		ref *= 2.0;
+		ref /= 4.0;
+		CHECK(buffer == std::vector<double>(6, 1.5));
+		CHECK_THROWS_AS(ref /= 0.0, std::logic_error);
+	}
+
+	SECTION("Strided references write every stride-th magnitude") {
+		auto odd = comp6771::euclidean_vector_ref(buffer.data() + 1, 3, 2);
+		odd = comp6771::euclidean_vector{10.0, 20.0, 30.0};
+		odd *= 0.5;
+		CHECK(buffer == std::vector<double>{1.0, 5.0, 3.0, 10.0, 5.0, 15.0});
+	}
+
+	SECTION("References can be read like views") {
+		auto const copy = std::array<double, 6>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+		CHECK(comp6771::euclidean_vector_view(ref) == comp6771::euclidean_vector_view(copy));
+		CHECK(comp6771::dot(ref, copy) == 91.0);
+	}
+}
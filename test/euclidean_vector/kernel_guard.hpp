@@ -0,0 +1,36 @@
+#ifndef COMP6771_TEST_KERNEL_GUARD_HPP
+#define COMP6771_TEST_KERNEL_GUARD_HPP
+
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <vector>
+
+namespace testing {
+	// the SIMD levels this CPU can run, from scalar up
+	inline auto simd_levels() -> std::vector<comp6771::kernels::simd_level> {
+		using comp6771::kernels::simd_level;
+		auto levels = std::vector<simd_level>();
+		for (auto const level :
+		     {simd_level::scalar, simd_level::sse2, simd_level::avx2, simd_level::avx512}) {
+			if (level <= comp6771::kernels::detected_simd_level()) {
+				levels.push_back(level);
+			}
+		}
+		return levels;
+	}
+
+	// Restores the CPU's own SIMD level and serial execution when a test finishes.
+	class kernel_guard {
+	public:
+		kernel_guard() = default;
+		kernel_guard(kernel_guard const&) = delete;
+		auto operator=(kernel_guard const&) -> kernel_guard& = delete;
+
+		~kernel_guard() {
+			comp6771::kernels::set_simd_level(comp6771::kernels::detected_simd_level());
+			comp6771::kernels::disable_parallel_execution();
+		}
+	};
+} // namespace testing
+
+#endif // COMP6771_TEST_KERNEL_GUARD_HPP
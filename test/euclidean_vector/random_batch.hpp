@@ -0,0 +1,28 @@
+#ifndef COMP6771_TEST_RANDOM_BATCH_HPP
+#define COMP6771_TEST_RANDOM_BATCH_HPP
+
+#include "comp6771/euclidean_vector_batch.hpp"
+
+#include <random>
+
+namespace testing {
+	// `size` vectors whose magnitudes are drawn from `magnitude`, row by row, by an engine seeded
+	// with `seed`
+	template<typename Distribution = std::uniform_real_distribution<double>>
+	auto random_batch(int size,
+	                  int dimensions,
+	                  unsigned seed,
+	                  Distribution magnitude = Distribution(-1.0, 1.0))
+	   -> comp6771::euclidean_vector_batch {
+		auto engine = std::mt19937(seed);
+		auto batch = comp6771::euclidean_vector_batch(size, dimensions);
+		for (auto i = 0; i < size; ++i) {
+			for (auto d = 0; d < dimensions; ++d) {
+				batch(i, d) = magnitude(engine);
+			}
+		}
+		return batch;
+	}
+} // namespace testing
+
+#endif // COMP6771_TEST_RANDOM_BATCH_HPP